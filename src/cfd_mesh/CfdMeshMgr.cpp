@@ -8,11 +8,14 @@
 //////////////////////////////////////////////////////////////////////
 
 #include "CfdMeshMgr.h"
+#include "HalfEdgeMesh.h"
 #include "SubSurfaceMgr.h"
 #include "main.h"
 #include "MeshAnalysis.h"
 #include "ModeMgr.h"
 #include "FileUtil.h"
+#include "ExportBuffer.h"
+#include "ParallelUtil.h"
 
 #include <algorithm>
 
@@ -176,6 +179,8 @@ void CfdMeshMgrSingleton::TransferMeshSettings()
     m_CfdGridDensity = SimpleCfdGridDensity();
     m_CfdGridDensity.CopyFrom( m_Vehicle->GetCfdGridDensityPtr() );
 
+    m_IncrementalFlag = m_CfdSettings.m_IncrementalFlag;
+
     if ( m_CfdSettings.m_ConvertToQuadsFlag )
     {
         // Increase target edge length because tris are split into quads.
@@ -797,30 +802,77 @@ void CfdMeshMgrSingleton::Remesh( int output_type )
 {
     char str[256];
     int total_num_tris = 0;
+    int num_cached = 0;
     int nsurf = ( int )m_SurfVec.size();
+
+    m_NextRemeshCache.clear();
+
+    // Work on index based copies for all iterations, then copy back once.
+    vector< HalfEdgeMesh > hem_vec( nsurf );
+    vector< int > num_rev_removed( nsurf, 0 );
+    vector< uint64_t > key_vec( nsurf, 0 );
+    vector< bool > cached_flag( nsurf, false );
+    vector< int > todo;
+
     for ( int i = 0 ; i < nsurf ; ++i )
     {
-        int num_tris = 0;
+        m_SurfVec[i]->GetMesh()->BuildHalfEdgeMesh( hem_vec[i] );
 
-        int num_rev_removed = 0;
-
-        for ( int iter = 0 ; iter < 10 ; ++iter )
+        HalfEdgeMesh cached;
+        if ( FindRemeshCache( m_SurfVec[i], hem_vec[i], key_vec[i], cached, num_rev_removed[i] ) )
+        {
+            // Geometry, sizing and initial mesh are unchanged, reuse the final mesh.
+            num_cached++;
+            cached_flag[i] = true;
+            hem_vec[i] = std::move( cached );
+        }
+        else
         {
-            num_tris = 0;
-            m_SurfVec[i]->GetMesh()->Remesh();
+            if ( m_IncrementalFlag )
+            {
+                m_NextRemeshCache[ key_vec[i] ].m_InitMesh = hem_vec[i];
+            }
+            todo.push_back( i );
+        }
+    }
 
-            num_rev_removed = m_SurfVec[ i ]->GetMesh()->RemoveRevFaces();
+    // Surfaces only share their fixed border nodes, so each one is remeshed
+    // independently.  Progress for each iteration is only reported when a
+    // single surface is being remeshed.
+    bool report_iter = ( todo.size() == 1 ) && output_type != CfdMeshMgrSingleton::QUIET_OUTPUT;
 
+    ParallelUtil::ParallelFor( ( int )todo.size(), [&]( int k )
+    {
+        int i = todo[k];
+        HalfEdgeMesh & hem = hem_vec[i];
 
-            num_tris += m_SurfVec[ i ]->GetMesh()->GetNumFaces();
+        for ( int iter = 0 ; iter < 10 ; ++iter )
+        {
+            hem.Remesh();
 
-            snprintf( str, sizeof( str ), "Surf %3d/%3d Iter %2d/10 Num Tris = %8d %s                                       \r", i + 1, nsurf, iter + 1, num_tris, m_SurfVec[i]->GetDisplayName().c_str() );
+            num_rev_removed[i] = hem.RemoveRevFaces();
 
-            if ( output_type != CfdMeshMgrSingleton::QUIET_OUTPUT )
+            if ( report_iter )
             {
-                addOutputText( str, output_type );
+                char iterstr[256];
+                snprintf( iterstr, sizeof( iterstr ), "Surf %3d/%3d Iter %2d/10 Num Tris = %8d %s                                       \r", i + 1, nsurf, iter + 1, hem.GetNumFaces(), m_SurfVec[i]->GetDisplayName().c_str() );
+                addOutputText( iterstr, output_type );
             }
         }
+    } );
+
+    for ( int i = 0 ; i < nsurf ; ++i )
+    {
+        m_SurfVec[i]->GetMesh()->LoadHalfEdgeMesh( hem_vec[i] );
+
+        if ( m_IncrementalFlag && !cached_flag[i] )
+        {
+            RemeshCacheEntry & entry = m_NextRemeshCache[ key_vec[i] ];
+            entry.m_Mesh = hem_vec[i];
+            entry.m_NumRevRemoved = num_rev_removed[i];
+        }
+
+        int num_tris = hem_vec[i].GetNumFaces();
         total_num_tris += num_tris;
 
         if ( output_type != CfdMeshMgrSingleton::QUIET_OUTPUT )
@@ -829,15 +881,27 @@ void CfdMeshMgrSingleton::Remesh( int output_type )
             addOutputText( str, output_type );
         }
 
-        if ( num_rev_removed > 0 )
+        if ( num_rev_removed[i] > 0 )
         {
-            snprintf( str, sizeof( str ), "%d Reversed tris collapsed in final iteration.\n", num_rev_removed );
+            snprintf( str, sizeof( str ), "%d Reversed tris collapsed in final iteration.\n", num_rev_removed[i] );
             if ( output_type != CfdMeshMgrSingleton::QUIET_OUTPUT )
             {
                 addOutputText( str, output_type );
             }
         }
         m_SurfVec[i]->GetMesh()->DumpGarbage();
+
+        hem_vec[i].Clear();
+    }
+
+    if ( m_IncrementalFlag )
+    {
+        // Keep only the surfaces of this mesh.
+        m_RemeshCache.swap( m_NextRemeshCache );
+        m_NextRemeshCache.clear();
+
+        snprintf( str, sizeof( str ), "Reused %d of %d surface meshes\n", num_cached, nsurf );
+        addOutputText( str, output_type );
     }
 
     WakeMgr.StretchWakes();
@@ -846,6 +910,51 @@ void CfdMeshMgrSingleton::Remesh( int output_type )
     addOutputText( str, output_type );
 }
 
+//==== Look Up The Remeshed Result For A Surface's Initial Mesh ====//
+// The remesh of a surface depends on its geometry, its target map, the grid
+// density growth limits and the initial mesh, which carries the tessellated
+// intersection and border curves shared with its neighbors.  A surface whose
+// partner moved therefore misses the cache.
+bool CfdMeshMgrSingleton::FindRemeshCache( Surf* surf, const HalfEdgeMesh & hem, uint64_t & key, HalfEdgeMesh & result, int & num_rev_removed )
+{
+    if ( !m_IncrementalFlag )
+    {
+        return false;
+    }
+
+    GeomHash hash;
+    hash.Add( surf->GetGeomHash() );
+    hash.Add( surf->GetFlipFlag() );
+    surf->AddTargetMapHash( hash );
+    hash.Add( GetGridDensityPtr()->m_GrowRatio );
+    hash.Add( GetGridDensityPtr()->m_MinLen );
+    hem.AddHash( hash );
+    key = hash.Get();
+
+    RemeshCache::iterator it = m_RemeshCache.find( key );
+    if ( it == m_RemeshCache.end() || !it->second.m_InitMesh.SameAs( hem ) )
+    {
+        return false;
+    }
+
+    result = it->second.m_Mesh;
+    result.SetSurfPtr( surf );
+    result.SetGridDensityPtr( GetGridDensityPtr() );
+    num_rev_removed = it->second.m_NumRevRemoved;
+
+    m_NextRemeshCache[ key ] = std::move( it->second );
+    m_RemeshCache.erase( it );
+    return true;
+}
+
+void CfdMeshMgrSingleton::ClearMeshCache()
+{
+    SurfaceIntersectionSingleton::ClearMeshCache();
+
+    m_RemeshCache.clear();
+    m_NextRemeshCache.clear();
+}
+
 void CfdMeshMgrSingleton::PostMesh()
 {
     int nsurf = ( int )m_SurfVec.size();
@@ -908,7 +1017,17 @@ string CfdMeshMgrSingleton::GetQualString()
 
 void CfdMeshMgrSingleton::ExportFiles()
 {
-    if ( GetSettingsPtr()->GetExportFileFlag( vsp::CFD_STL_FILE_NAME ) )
+    bool stl_flag = GetSettingsPtr()->GetExportFileFlag( vsp::CFD_STL_FILE_NAME );
+    bool poly_flag = GetSettingsPtr()->GetExportFileFlag( vsp::CFD_POLY_FILE_NAME );
+
+    //==== Merged Tables Shared by Tagged STL and TetGen ====//
+    CfdExportTables merged_tables;
+    if ( ( stl_flag && m_Vehicle->m_STLMultiSolid() ) || poly_flag )
+    {
+        BuildExportTables( merged_tables, false );
+    }
+
+    if ( stl_flag )
     {
         if ( !m_Vehicle->m_STLMultiSolid() )
         {
@@ -916,14 +1035,16 @@ void CfdMeshMgrSingleton::ExportFiles()
         }
         else
         {
-            WriteTaggedSTL( GetSettingsPtr()->GetExportFileName( vsp::CFD_STL_FILE_NAME ) );
+            WriteTaggedSTL( GetSettingsPtr()->GetExportFileName( vsp::CFD_STL_FILE_NAME ), merged_tables );
         }
     }
-    if ( GetSettingsPtr()->GetExportFileFlag( vsp::CFD_POLY_FILE_NAME ) )
+    if ( poly_flag )
     {
-        WriteTetGen( GetSettingsPtr()->GetExportFileName( vsp::CFD_POLY_FILE_NAME ) );
+        WriteTetGen( GetSettingsPtr()->GetExportFileName( vsp::CFD_POLY_FILE_NAME ), merged_tables );
     }
 
+    merged_tables = CfdExportTables();
+
     string dat_fn;
     if (  GetSettingsPtr()->GetExportFileFlag( vsp::CFD_DAT_FILE_NAME ) )
     {
@@ -954,12 +1075,20 @@ void CfdMeshMgrSingleton::ExportFiles()
     {
         vspaero_fn = GetSettingsPtr()->GetExportFileName( vsp::CFD_VSPGEOM_FILE_NAME );
     }
+    bool facet_flag = GetSettingsPtr()->GetExportFileFlag( vsp::CFD_FACET_FILE_NAME );
+
+    //==== Wake Split Tables Shared by the Remaining Formats ====//
+    CfdExportTables split_tables;
+    if ( dat_fn.length() || obj_fn.length() || tri_fn.length() || gmsh_fn.length() || vspaero_fn.length() || facet_flag )
+    {
+        BuildExportTables( split_tables, true );
+    }
 
-    WriteNASCART_Obj_Tri_Gmsh( dat_fn, key_fn, obj_fn, tri_fn, gmsh_fn, vspaero_fn );
+    WriteNASCART_Obj_Tri_Gmsh( dat_fn, key_fn, obj_fn, tri_fn, gmsh_fn, vspaero_fn, split_tables );
 
-    if ( GetSettingsPtr()->GetExportFileFlag( vsp::CFD_FACET_FILE_NAME ) )
+    if ( facet_flag )
     {
-        WriteFacet( GetSettingsPtr()->GetExportFileName( vsp::CFD_FACET_FILE_NAME ) );
+        WriteFacet( GetSettingsPtr()->GetExportFileName( vsp::CFD_FACET_FILE_NAME ), split_tables );
     }
 
     if ( GetSettingsPtr()->GetExportFileFlag( vsp::CFD_TKEY_FILE_NAME ) )
@@ -968,22 +1097,39 @@ void CfdMeshMgrSingleton::ExportFiles()
     }
 }
 
-void CfdMeshMgrSingleton::WriteTaggedSTL( const string &filename )
+void CfdMeshMgrSingleton::BuildExportTables( CfdExportTables & tables, bool split_wake )
 {
-    //==== Find All Points and Tri Counts ====//
+    tables = CfdExportTables();
+
+    // Used when comparing W parameter to TMAGIC
+    double tol = 1e-12;
+
+    //==== Find All Points ====//
+    // With split_wake, wake points are merged separately from the solid points.
     vector< vec3d > allPntVec;
+    vector< vec3d > wakeAllPntVec;
     vector < vector < int > > allPntKey;
     allPntKey.resize( m_SurfVec.size() );
     int k = 0;
+    int wk = 0;
     for ( int i = 0 ; i < ( int )m_SurfVec.size() ; i++ )
     {
         vector< vec3d >& sPntVec = m_SurfVec[i]->GetMesh()->GetSimpPntVec();
         allPntKey[i].resize( sPntVec.size() );
         for ( int v = 0 ; v < ( int )sPntVec.size() ; v++ )
         {
-            allPntVec.push_back( sPntVec[v] );
-            allPntKey[i][v] = k;
-            k++;
+            if ( split_wake && m_SurfVec[i]->GetWakeFlag() )
+            {
+                wakeAllPntVec.push_back( sPntVec[v] );
+                allPntKey[i][v] = wk;
+                wk++;
+            }
+            else
+            {
+                allPntVec.push_back( sPntVec[v] );
+                allPntKey[i][v] = k;
+                k++;
+            }
         }
     }
 
@@ -991,230 +1137,425 @@ void CfdMeshMgrSingleton::WriteTaggedSTL( const string &filename )
     PntNodeCloud pnCloud;
     pnCloud.AddPntNodes( allPntVec );
 
-    double tol = PT_MERGE_TOL;
+    double tol2 = PT_MERGE_TOL;
     //==== Use NanoFlann to Find Close Points and Group ====//
-    IndexPntNodes( pnCloud, tol );
+    IndexPntNodes( pnCloud, tol2 );
 
-    //==== Assemble Normal Tris ====//
-    vector< SimpFace > allFaceVec;
-    for ( int i = 0 ; i < ( int )m_SurfVec.size() ; i++ )
+    //==== Build Wake Map If Available ====//
+    PntNodeCloud wakepnCloud;
+    if ( wakeAllPntVec.size() )
     {
-        vector < SimpFace >& sFaceVec = m_SurfVec[ i ]->GetMesh()->GetSimpFaceVec();
-        vector< vec3d >& sPntVec = m_SurfVec[i]->GetMesh()->GetSimpPntVec();
-        for ( int f = 0 ; f <  ( int )sFaceVec.size() ; f++ )
-        {
-            int i0 = pnCloud.GetNodeUsedIndex( allPntKey[i][sFaceVec[f].ind0] );
-            int i1 = pnCloud.GetNodeUsedIndex( allPntKey[i][sFaceVec[f].ind1] );
-            int i2 = pnCloud.GetNodeUsedIndex( allPntKey[i][sFaceVec[f].ind2] );
-            SimpFace sface;
-            sface.ind0 = i0;
-            sface.ind1 = i1;
-            sface.ind2 = i2;
-
-            if( sFaceVec[f].m_isQuad )
-            {
-                sface.m_isQuad = true;
-                int i3 = pnCloud.GetNodeUsedIndex( allPntKey[i][sFaceVec[f].ind3] );
-                sface.ind3 = i3;
-            }
-
-            sface.m_Tags = sFaceVec[f].m_Tags;
-            allFaceVec.push_back( sface );
-        }
+        wakepnCloud.AddPntNodes( wakeAllPntVec );
+        IndexPntNodes( wakepnCloud, tol2 );
     }
+
     //==== Assemble All Used Points ====//
-    vector< vec3d > allUsedPntVec;
     for ( int i = 0 ; i < ( int )allPntVec.size() ; i++ )
     {
         if ( pnCloud.UsedNode( i ) )
         {
-            allUsedPntVec.push_back( allPntVec[i] );
+            tables.m_PntVec.push_back( allPntVec[i] );
+            tables.m_PntID.push_back( i + 1 );
         }
     }
+    tables.m_NumSolidPnts = ( int )tables.m_PntVec.size();
 
-    FILE* file_id = fopen( filename.c_str(), "w" );
-    if ( file_id )
+    for ( int i = 0 ; i < ( int )wakeAllPntVec.size() ; i++ )
     {
-        std::vector< int > tags = SubSurfaceMgr.GetAllTags();
-        for ( int itag = 0; itag < ( int ) tags.size(); itag++ )
+        if ( wakepnCloud.UsedNode( i ) )
         {
-            std::string tagname = SubSurfaceMgr.GetTagNames( itag );
-            fprintf( file_id, "solid %s\n", tagname.c_str() );
+            tables.m_PntVec.push_back( wakeAllPntVec[i] );
+            tables.m_PntID.push_back( i + 1 );
+        }
+    }
+
+    //==== Assemble Solid Faces, Then Wake Faces ====//
+    vector < pair < int, int > > wedges;
+    for ( int pass = 0; pass < 2; pass++ )
+    {
+        for ( int i = 0 ; i < ( int )m_SurfVec.size() ; i++ )
+        {
+            bool wake = split_wake && m_SurfVec[i]->GetWakeFlag();
+            if ( wake != ( pass == 1 ) )
+            {
+                continue;
+            }
+
+            PntNodeCloud &cloud = wake ? wakepnCloud : pnCloud;
+            int offset = wake ? tables.m_NumSolidPnts + 1 : 1;
 
-            for ( int f = 0; f < ( int ) allFaceVec.size(); f++ )
+            vector < SimpFace >& sFaceVec = m_SurfVec[ i ]->GetMesh()->GetSimpFaceVec();
+            vector< vec2d >& sUWVec = m_SurfVec[i]->GetMesh()->GetSimpUWPntVec();
+            for ( int t = 0 ; t <  ( int )sFaceVec.size() ; t++ )
             {
-                SimpFace* sface = &allFaceVec[f];
-                int t = SubSurfaceMgr.GetTag( sface->m_Tags );
+                SimpFace sface;
+                sface.ind0 = cloud.GetNodeUsedIndex( allPntKey[i][sFaceVec[t].ind0] ) + offset;
+                sface.ind1 = cloud.GetNodeUsedIndex( allPntKey[i][sFaceVec[t].ind1] ) + offset;
+                sface.ind2 = cloud.GetNodeUsedIndex( allPntKey[i][sFaceVec[t].ind2] ) + offset;
 
-                if ( t == tags[itag] )
+                if( sFaceVec[t].m_isQuad )
                 {
-                    const vec3d& p0 = allUsedPntVec[sface->ind0];
-                    const vec3d& p1 = allUsedPntVec[sface->ind1];
-                    const vec3d& p2 = allUsedPntVec[sface->ind2];
-                    vec3d v01 = p1 - p0;
-                    vec3d v12 = p2 - p1;
-                    vec3d norm = cross( v01, v12 );
-                    norm.normalize();
+                    sface.m_isQuad = true;
+                    sface.ind3 = cloud.GetNodeUsedIndex( allPntKey[i][sFaceVec[t].ind3] ) + offset;
+                    tables.m_NumTris++; // Bonus tri for split quad.
+                }
 
-                    fprintf( file_id, " facet normal  %2.10le %2.10le %2.10le\n",  norm.x(), norm.y(), norm.z() );
-                    fprintf( file_id, "   outer loop\n" );
+                sface.m_Tags = sFaceVec[t].m_Tags;
+                tables.m_NumTris++;
+                tables.m_FaceVec.push_back( sface );
+                tables.m_FaceTag.push_back( SubSurfaceMgr.GetTag( sface.m_Tags ) );
+                tables.m_FacePart.push_back( SubSurfaceMgr.GetPart( sface.m_Tags ) );
 
-                    fprintf( file_id, "     vertex %2.10le %2.10le %2.10le\n", p0.x(), p0.y(), p0.z() );
-                    fprintf( file_id, "     vertex %2.10le %2.10le %2.10le\n", p1.x(), p1.y(), p1.z() );
-                    fprintf( file_id, "     vertex %2.10le %2.10le %2.10le\n", p2.x(), p2.y(), p2.z() );
+                if ( !split_wake )
+                {
+                    continue;
+                }
 
-                    fprintf( file_id, "   endloop\n" );
-                    fprintf( file_id, " endfacet\n" );
+                vec2d uwFace[4];
+                uwFace[0] = sUWVec[ sFaceVec[t].ind0 ];
+                uwFace[1] = sUWVec[ sFaceVec[t].ind1 ];
+                uwFace[2] = sUWVec[ sFaceVec[t].ind2 ];
+                if( sFaceVec[t].m_isQuad )
+                {
+                    uwFace[3] = sUWVec[ sFaceVec[t].ind3 ];
+                }
+                tables.m_FaceUW.insert( tables.m_FaceUW.end(), uwFace, uwFace + 4 );
 
-                    if ( sface->m_isQuad ) // Split quad and write additional tri.
+                if ( !wake && m_SurfVec[i]->GetSurfaceVSPType() == vsp::WING_SURF )
+                {
+                    bool n0 = uwFace[0].y() <= ( TMAGIC + tol );
+                    bool n1 = uwFace[1].y() <= ( TMAGIC + tol );
+                    bool n2 = uwFace[2].y() <= ( TMAGIC + tol );
+                    bool n3 = false;
+                    if( sFaceVec[t].m_isQuad )
                     {
-                        vec3d p3 = allUsedPntVec[sface->ind3];
-                        vec3d v23 = p3 - p2;
-                        vec3d v30 = p0 - p3;
-                        norm = cross( v23, v30 );
-                        norm.normalize();
-
-                        fprintf( file_id, " facet normal  %2.10le %2.10le %2.10le\n",  norm.x(), norm.y(), norm.z() );
-                        fprintf( file_id, "   outer loop\n" );
+                        n3 = uwFace[3].y() <= ( TMAGIC + tol );
+                    }
 
-                        fprintf( file_id, "     vertex %2.10le %2.10le %2.10le\n", p0.x(), p0.y(), p0.z() );
-                        fprintf( file_id, "     vertex %2.10le %2.10le %2.10le\n", p2.x(), p2.y(), p2.z() );
-                        fprintf( file_id, "     vertex %2.10le %2.10le %2.10le\n", p3.x(), p3.y(), p3.z() );
+                    if ( ( n0 + n1 + n2 + n3 ) == 2 ) // Two true, one or two false.
+                    {
+                        int i0 = sface.ind0;
+                        int i1 = sface.ind1;
+                        int i2 = sface.ind2;
+                        int i3 = sFaceVec[t].m_isQuad ? sface.ind3 : -1;
 
-                        fprintf( file_id, "   endloop\n" );
-                        fprintf( file_id, " endfacet\n" );
+                        // Add nodes to wake edges, lowest u first.
+                        if ( n0 && n1 )
+                        {
+                            if ( uwFace[0].x() < uwFace[1].x() )
+                            {
+                                wedges.push_back( pair< int, int>( i0, i1 ) );
+                            }
+                            else
+                            {
+                                wedges.push_back( pair< int, int>( i1, i0 ) );
+                            }
+                        }
+                        else if ( n1 && n2 )
+                        {
+                            if ( uwFace[1].x() < uwFace[2].x() )
+                            {
+                                wedges.push_back( pair< int, int>( i1, i2 ) );
+                            }
+                            else
+                            {
+                                wedges.push_back( pair< int, int>( i2, i1 ) );
+                            }
+                        }
+                        else if ( !sFaceVec[t].m_isQuad && n2 && n0 ) // Triangle only
+                        {
+                            if ( uwFace[2].x() < uwFace[0].x() )
+                            {
+                                wedges.push_back( pair< int, int>( i2, i0 ) );
+                            }
+                            else
+                            {
+                                wedges.push_back( pair< int, int>( i0, i2 ) );
+                            }
+                        }
+                        else if ( sFaceVec[t].m_isQuad && n2 && n3 ) // Quad only
+                        {
+                            if ( uwFace[2].x() < uwFace[3].x() )
+                            {
+                                wedges.push_back( pair< int, int>( i2, i3 ) );
+                            }
+                            else
+                            {
+                                wedges.push_back( pair< int, int>( i3, i2 ) );
+                            }
+                        }
+                        else if ( sFaceVec[t].m_isQuad && n3 && n0 ) // Quad only
+                        {
+                            if ( uwFace[3].x() < uwFace[0].x() )
+                            {
+                                wedges.push_back( pair< int, int>( i3, i0 ) );
+                            }
+                            else
+                            {
+                                wedges.push_back( pair< int, int>( i0, i3 ) );
+                            }
+                        }
                     }
                 }
             }
-            fprintf( file_id, "endsolid %s\n", tagname.c_str() );
         }
 
-        fclose( file_id );
+        if ( pass == 0 )
+        {
+            tables.m_NumSolidFaces = ( int )tables.m_FaceVec.size();
+        }
     }
-}
 
-void CfdMeshMgrSingleton::WriteSTL( const string &filename )
-{
-    FILE* file_id = fopen( filename.c_str(), "w" );
-    if ( file_id )
+    //==== Chain Wake Edges Into Wake Lines ====//
+    sort( wedges.begin(), wedges.end() );
+
+    vector < pair < int, int > >::iterator it;
+    it = unique( wedges.begin(), wedges.end() );
+    wedges.resize( distance( wedges.begin(), it ) );
+
+    list < pair < int, int > > wlist( wedges.begin(), wedges.end() );
+
+    vector < deque < pair < int, int > > > &wakes = tables.m_Wakes;
+
+    while ( !wlist.empty() )
     {
-        int numwake = 0;
-        fprintf( file_id, "solid\n" );
-        for ( int i = 0 ; i < ( int )m_SurfVec.size() ; i++ )
+        list < pair < int, int > >::iterator wit = wlist.begin();
+
+        int iwake = wakes.size();
+        wakes.resize( iwake + 1 );
+        wakes[iwake].push_back( *wit );
+        wit = wlist.erase( wit );
+
+        while ( wit != wlist.end() )
         {
-            if ( !m_SurfVec[i]->GetWakeFlag() )
-            {
-                m_SurfVec[ i ]->GetMesh()->WriteSimpleSTL( file_id );
-            }
-            else
+            if ( wakes[iwake].back().second == (*wit).first )
             {
-                numwake++;
+                wakes[iwake].push_back( *wit );
+                wlist.erase( wit );
+                wit = wlist.begin();
+                continue;
             }
-        }
-        fprintf( file_id, "endsolid\n" );
-
-        if( numwake > 0 )
-        {
-            fprintf( file_id, "solid wake\n" );
-            for ( int i = 0 ; i < ( int )m_SurfVec.size() ; i++ )
+            else if ( wakes[iwake].begin()->first == (*wit).second )
             {
-                if ( m_SurfVec[i]->GetWakeFlag() )
-                {
-                    m_SurfVec[ i ]->GetMesh()->WriteSimpleSTL( file_id );
-                }
+                wakes[iwake].push_front( *wit );
+                wlist.erase( wit );
+                wit = wlist.begin();
+                continue;
             }
-            fprintf( file_id, "endsolid wake\n" );
+            wit++;
         }
-        fclose( file_id );
     }
 }
 
-void CfdMeshMgrSingleton::WriteTetGen( const string &filename )
+void CfdMeshMgrSingleton::WriteTaggedSTL( const string &filename, const CfdExportTables & tables )
 {
-    FILE* fp = fopen( filename.c_str(), "w" );
-    if ( !fp )
-    {
-        return;
-    }
+    const vector< vec3d > &pnts = tables.m_PntVec;
+    const vector< SimpFace > &faces = tables.m_FaceVec;
 
-    int face_cnt = 0;
-    vector< vec3d > allPntVec;
-    vector < vector < int > > allPntKey;
-    allPntKey.resize( m_SurfVec.size() );
-    int k = 0;
-    for ( int i = 0 ; i < ( int )m_SurfVec.size() ; i++ )
+    FILE* file_id = fopen( filename.c_str(), "w" );
+    if ( file_id )
     {
-        vector< vec3d >& sPntVec = m_SurfVec[i]->GetMesh()->GetSimpPntVec();
-        allPntKey[i].resize( sPntVec.size() );
-        for ( int v = 0 ; v < ( int )sPntVec.size() ; v++ )
+        ExportBuffer buf( file_id );
+
+        std::vector< int > tags = SubSurfaceMgr.GetAllTags();
+
+        //==== Group Faces by Tag ====//
+        map< int, int > tag_index;
+        for ( int itag = 0; itag < ( int ) tags.size(); itag++ )
         {
-            allPntVec.push_back( sPntVec[v] );
-            allPntKey[i][v] = k;
-            k++;
+            tag_index[ tags[itag] ] = itag;
         }
-        face_cnt += m_SurfVec[ i ]->GetMesh()->GetSimpFaceVec().size();
-    }
 
-    //==== Build Map ====//
-    PntNodeCloud pnCloud;
-    pnCloud.AddPntNodes( allPntVec );
+        vector< vector< int > > tag_faces( tags.size() );
+        for ( int f = 0; f < ( int ) faces.size(); f++ )
+        {
+            map< int, int >::const_iterator mit = tag_index.find( tables.m_FaceTag[f] );
+            if ( mit != tag_index.end() )
+            {
+                tag_faces[ mit->second ].push_back( f );
+            }
+        }
 
-    double tol = PT_MERGE_TOL;
+        for ( int itag = 0; itag < ( int ) tags.size(); itag++ )
+        {
+            std::string tagname = SubSurfaceMgr.GetTagNames( itag );
+            buf.Append( "solid " + tagname + "\n" );
 
-    //==== Use NanoFlann to Find Close Points and Group ====//
-    IndexPntNodes( pnCloud, tol );
+            const vector< int > &flist = tag_faces[itag];
+            ExportUtil::ParallelAppend( buf, ( int ) flist.size(), [&]( ExportBuffer & b, int j )
+            {
+                const SimpFace &sface = faces[ flist[j] ];
+                const vec3d& p0 = pnts[sface.ind0 - 1];
+                const vec3d& p1 = pnts[sface.ind1 - 1];
+                const vec3d& p2 = pnts[sface.ind2 - 1];
+                vec3d v01 = p1 - p0;
+                vec3d v12 = p2 - p1;
+                vec3d norm = cross( v01, v12 );
+                norm.normalize();
 
-    //===== Write Num Pnts and Tris ====//
-    fprintf( fp, "# Part 1 - node list\n" );
-    fprintf( fp, "%lld 3 0 0\n", pnCloud.m_NumUsedPts );
+                ExportUtil::AppendSTLFacet( b, norm, p0, p1, p2 );
 
-    //==== Write Model Pnts ====//
-    for ( int i = 0 ; i < ( int )allPntVec.size() ; i++ )
+                if ( sface.m_isQuad ) // Split quad and write additional tri.
+                {
+                    const vec3d& p3 = pnts[sface.ind3 - 1];
+                    vec3d v23 = p3 - p2;
+                    vec3d v30 = p0 - p3;
+                    norm = cross( v23, v30 );
+                    norm.normalize();
+
+                    ExportUtil::AppendSTLFacet( b, norm, p0, p2, p3 );
+                }
+            } );
+
+            buf.Append( "endsolid " + tagname + "\n" );
+        }
+
+        buf.Flush();
+        fclose( file_id );
+    }
+}
+
+void CfdMeshMgrSingleton::WriteSTL( const string &filename )
+{
+    if ( GetCfdSettingsPtr()->m_BinarySTLFlag )
     {
-        if ( pnCloud.UsedNode( i ) )
+        FILE* file_id = fopen( filename.c_str(), "wb" );
+        if ( file_id )
         {
-            fprintf( fp, "%d %.16g %.16g %.16g\n", i + 1, allPntVec[i].x(), allPntVec[i].y(), allPntVec[i].z() );
+            ExportBuffer buf( file_id );
+
+            // Binary STL has a single solid, wake facets follow the body facets.
+            unsigned int nfacet = 0;
+            for ( int i = 0 ; i < ( int )m_SurfVec.size() ; i++ )
+            {
+                vector < SimpFace >& sFaceVec = m_SurfVec[ i ]->GetMesh()->GetSimpFaceVec();
+                for ( int f = 0 ; f < ( int )sFaceVec.size() ; f++ )
+                {
+                    nfacet += sFaceVec[f].m_isQuad ? 2 : 1;
+                }
+            }
+
+            ExportUtil::AppendBinarySTLHeader( buf, string( "OpenVSP " ) + VSPVERSION4 + " CFD Mesh", nfacet );
+
+            for ( int wake = 0; wake < 2; wake++ )
+            {
+                for ( int i = 0 ; i < ( int )m_SurfVec.size() ; i++ )
+                {
+                    if ( m_SurfVec[i]->GetWakeFlag() == ( wake == 1 ) )
+                    {
+                        m_SurfVec[ i ]->GetMesh()->WriteSimpleSTL( buf, true );
+                    }
+                }
+            }
+
+            buf.Flush();
+            fclose( file_id );
         }
+        return;
     }
 
-    //==== Write Tris ====//
-    fprintf( fp, "# Part 2 - facet list\n" );
-    // <# of facets> <boundary markers (0 or 1)> 
-    fprintf( fp, "%d 1\n", face_cnt );
-
-    for ( int i = 0 ; i < ( int )m_SurfVec.size() ; i++ )
+    FILE* file_id = fopen( filename.c_str(), "w" );
+    if ( file_id )
     {
-        vector < SimpFace >& sFaceVec = m_SurfVec[ i ]->GetMesh()->GetSimpFaceVec();
-        vector< vec3d >& sPntVec = m_SurfVec[i]->GetMesh()->GetSimpPntVec();
-        for ( int f = 0 ; f < ( int )sFaceVec.size() ; f++ )
+        ExportBuffer buf( file_id );
+
+        int numwake = 0;
+        buf.Append( "solid\n" );
+        for ( int i = 0 ; i < ( int )m_SurfVec.size() ; i++ )
         {
-            int i0 = pnCloud.GetNodeUsedIndex( allPntKey[i][sFaceVec[f].ind0] );
-            int i1 = pnCloud.GetNodeUsedIndex( allPntKey[i][sFaceVec[f].ind1] );
-            int i2 = pnCloud.GetNodeUsedIndex( allPntKey[i][sFaceVec[f].ind2] );
-            int ind1 = i0 + 1;
-            int ind2 = i1 + 1;
-            int ind3 = i2 + 1;
-            int tag = SubSurfaceMgr.GetTag( sFaceVec[f].m_Tags );
-
-            // <# of polygons> [# of holes] [boundary marker]
-            fprintf( fp, "1 0 %d\n", tag );
-            if( sFaceVec[f].m_isQuad )
+            if ( !m_SurfVec[i]->GetWakeFlag() )
             {
-                int i3 = pnCloud.GetNodeUsedIndex( allPntKey[i][sFaceVec[f].ind3] );
-                int ind4 = i3 + 1;
-
-                // <# of corners> <corner 1> <corner 2> <corner 3> <corner 4>
-                fprintf( fp, "4 %d %d %d %d\n", ind1, ind2, ind3, ind4 );
+                m_SurfVec[ i ]->GetMesh()->WriteSimpleSTL( buf );
             }
             else
             {
-                // <# of corners> <corner 1> <corner 2> <corner 3>
-                fprintf( fp, "3 %d %d %d\n", ind1, ind2, ind3 );
+                numwake++;
             }
         }
+        buf.Append( "endsolid\n" );
+
+        if( numwake > 0 )
+        {
+            buf.Append( "solid wake\n" );
+            for ( int i = 0 ; i < ( int )m_SurfVec.size() ; i++ )
+            {
+                if ( m_SurfVec[i]->GetWakeFlag() )
+                {
+                    m_SurfVec[ i ]->GetMesh()->WriteSimpleSTL( buf );
+                }
+            }
+            buf.Append( "endsolid wake\n" );
+        }
+
+        buf.Flush();
+        fclose( file_id );
+    }
+}
+
+void CfdMeshMgrSingleton::WriteTetGen( const string &filename, const CfdExportTables & tables )
+{
+    FILE* fp = fopen( filename.c_str(), "w" );
+    if ( !fp )
+    {
+        return;
     }
 
-    fprintf( fp, "# Part 3 - Hole List\n" );
+    ExportBuffer buf( fp );
+
+    const vector< vec3d > &pnts = tables.m_PntVec;
+    const vector< SimpFace > &faces = tables.m_FaceVec;
+
+    //===== Write Num Pnts and Tris ====//
+    buf.Append( "# Part 1 - node list\n" );
+    buf.AppendInt( ( long long int ) pnts.size() );
+    buf.Append( " 3 0 0\n" );
+
+    //==== Write Model Pnts ====//
+    ExportUtil::ParallelAppend( buf, ( int ) pnts.size(), [&]( ExportBuffer & b, int i )
+    {
+        b.AppendInt( tables.m_PntID[i] );
+        b.Append( ' ' );
+        ExportUtil::AppendXYZ( b, pnts[i], 'g', 16 );
+        b.Append( '\n' );
+    } );
+
+    //==== Write Tris ====//
+    buf.Append( "# Part 2 - facet list\n" );
+    // <# of facets> <boundary markers (0 or 1)>
+    buf.AppendInt( ( long long int ) faces.size() );
+    buf.Append( " 1\n" );
+
+    ExportUtil::ParallelAppend( buf, ( int ) faces.size(), [&]( ExportBuffer & b, int i )
+    {
+        const SimpFace &sface = faces[i];
+
+        // <# of polygons> [# of holes] [boundary marker]
+        b.Append( "1 0 " );
+        b.AppendInt( tables.m_FaceTag[i] );
+        if( sface.m_isQuad )
+        {
+            // <# of corners> <corner 1> <corner 2> <corner 3> <corner 4>
+            b.Append( "\n4 " );
+        }
+        else
+        {
+            // <# of corners> <corner 1> <corner 2> <corner 3>
+            b.Append( "\n3 " );
+        }
+        b.AppendInt( sface.ind0 );
+        b.Append( ' ' );
+        b.AppendInt( sface.ind1 );
+        b.Append( ' ' );
+        b.AppendInt( sface.ind2 );
+        if( sface.m_isQuad )
+        {
+            b.Append( ' ' );
+            b.AppendInt( sface.ind3 );
+        }
+        b.Append( '\n' );
+    } );
+
+    buf.Append( "# Part 3 - Hole List\n" );
 
     int set = GetCfdSettingsPtr()->m_SelectedSetIndex;
 
@@ -1271,340 +1612,65 @@ void CfdMeshMgrSingleton::WriteTetGen( const string &filename )
         interiorPntVec = tmpPntVec;
     }
 
-    fprintf( fp, "%d\n", ( int )interiorPntVec.size() );
-    for ( int i = 0 ; i < ( int )interiorPntVec.size() ; i++ )
-    {
-        const vec3d& p = interiorPntVec[i];
-        fprintf( fp, "%d  %.16g %.16g %.16g\n", i + 1, p.x(), p.y(), p.z()  );
-    }
-
-    fprintf( fp, "# Part 4 - region list\n" );
-    fprintf( fp, "0\n" );
-
-    fclose( fp );
-}
-
-void CfdMeshMgrSingleton::WriteNASCART_Obj_Tri_Gmsh( const string &dat_fn, const string &key_fn, const string &obj_fn, const string &tri_fn, const string &gmsh_fn, const string & vspgeom_fn )
-{
-#ifdef DEBUG_CFD_MESH
-    //==== Find Smallest Edge ====//
-    double small_edge = 1.0e12;
-    for ( int i = 0 ; i < ( int )m_SurfVec.size() ; i++ )
-    {
-        vector < SimpFace >& sFaceVec = m_SurfVec[i]->GetMesh()->GetSimpFaceVec();
-        vector< vec3d >& sPntVec = m_SurfVec[i]->GetMesh()->GetSimpPntVec();
-        for ( int f = 0 ; f < ( int )sFaceVec.size() ; f++ )
-        {
-            double el0 = dist_squared( sPntVec[sFaceVec[f].ind0], sPntVec[sFaceVec[f].ind1] );
-            double el1 = dist_squared( sPntVec[sFaceVec[f].ind1], sPntVec[sFaceVec[f].ind2] );
-            double el2 = dist_squared( sPntVec[sFaceVec[f].ind2], sPntVec[sFaceVec[f].ind0] );
-            if ( el0 < small_edge )
-            {
-                small_edge = el0;
-            }
-            if ( el1 < small_edge )
-            {
-                small_edge = el1;
-            }
-            if ( el2 < small_edge )
-            {
-                small_edge = el2;
-            }
-        }
-    }
-
-    fprintf( m_DebugFile, "CfdMeshMgr::WriteNASCART Small Edge Length = %f \n", sqrt( small_edge ) );
-#endif
-
-//  //==== Any Files To Write? ====//
-//  if ( !dat_fn && !key_fn && !obj_fn && !tri_fn )
-//      return;
-
-    // Used when comparing W parameter to TMAGIC
-    double tol = 1e-12;
-
-    //==== Find All Points and Tri Counts ====//
-    vector< vec3d > allPntVec;
-    vector< vec3d > wakeAllPntVec;
-    vector < vector < int > > allPntKey;
-    allPntKey.resize( m_SurfVec.size() );
-    vector < vector < int > > allWPntKey;
-    allWPntKey.resize( m_SurfVec.size() );
-    int k = 0;
-    int wk = 0;
-    for ( int i = 0 ; i < ( int )m_SurfVec.size() ; i++ )
-    {
-        vector< vec3d >& sPntVec = m_SurfVec[i]->GetMesh()->GetSimpPntVec();
-        allPntKey[i].resize( sPntVec.size() );
-        allWPntKey[i].resize( sPntVec.size() );
-        for ( int v = 0 ; v < ( int )sPntVec.size() ; v++ )
-        {
-            if ( m_SurfVec[i]->GetWakeFlag() )
-            {
-                wakeAllPntVec.push_back( sPntVec[v] );
-                allWPntKey[i][v] = wk;
-                wk++;
-            }
-            else
-            {
-                allPntVec.push_back( sPntVec[v] );
-                allPntKey[i][v] = k;
-                k++;
-            }
-        }
-    }
-
-    //==== Build Map ====//
-    PntNodeCloud pnCloud;
-    pnCloud.AddPntNodes( allPntVec );
-
-    double tol2 = PT_MERGE_TOL;
-    //==== Use NanoFlann to Find Close Points and Group ====//
-    IndexPntNodes( pnCloud, tol2 );
-
-    //==== Build Wake Map If Available ====//
-    PntNodeCloud wakepnCloud;
-    if ( wakeAllPntVec.size() )
-    {
-        wakepnCloud.AddPntNodes( wakeAllPntVec );
-        IndexPntNodes( wakepnCloud, tol2 );
-    }
-
-    //==== Assemble Normal Tris ====//
-    vector< SimpFace > allFaceVec;
-    int ntristrict = 0;
-    vector< int > allSurfIDVec;
-    vector< vector< vec2d > > allUWVec;
-    vector < pair < int, int > > wedges;
-    for ( int i = 0 ; i < ( int )m_SurfVec.size() ; i++ )
-    {
-        if ( !m_SurfVec[i]->GetWakeFlag() )
-        {
-            vector < SimpFace >& sFaceVec = m_SurfVec[ i ]->GetMesh()->GetSimpFaceVec();
-            vector< vec3d >& sPntVec = m_SurfVec[i]->GetMesh()->GetSimpPntVec();
-            vector< vec2d >& sUWVec = m_SurfVec[i]->GetMesh()->GetSimpUWPntVec();
-            for ( int t = 0 ; t <  ( int )sFaceVec.size() ; t++ )
-            {
-                SimpFace sface;
-                sface.ind0 = pnCloud.GetNodeUsedIndex( allPntKey[i][sFaceVec[t].ind0] ) + 1;
-                sface.ind1 = pnCloud.GetNodeUsedIndex( allPntKey[i][sFaceVec[t].ind1] ) + 1;
-                sface.ind2 = pnCloud.GetNodeUsedIndex( allPntKey[i][sFaceVec[t].ind2] ) + 1;
-
-                if( sFaceVec[t].m_isQuad )
-                {
-                    sface.m_isQuad = true;
-                    sface.ind3 = pnCloud.GetNodeUsedIndex( allPntKey[i][sFaceVec[t].ind3] ) + 1;
-                    ntristrict++; // Bonus tri for split quad.
-                }
-
-                sface.m_Tags = sFaceVec[t].m_Tags;
-                ntristrict++;
-                allFaceVec.push_back( sface );
-                allSurfIDVec.push_back( m_SurfVec[i]->GetSurfID() );
-
-                vector< vec2d > uwFace( 4 );
-                uwFace[0] = sUWVec[ sFaceVec[t].ind0 ];
-                uwFace[1] = sUWVec[ sFaceVec[t].ind1 ];
-                uwFace[2] = sUWVec[ sFaceVec[t].ind2 ];
-                if( sFaceVec[t].m_isQuad )
-                {
-                    uwFace[3] = sUWVec[ sFaceVec[t].ind3 ];
-                }
-                allUWVec.push_back( uwFace );
-
-                if ( m_SurfVec[i]->GetSurfaceVSPType() == vsp::WING_SURF )
-                {
-                    bool n0 = uwFace[0].y() <= ( TMAGIC + tol );
-                    bool n1 = uwFace[1].y() <= ( TMAGIC + tol );
-                    bool n2 = uwFace[2].y() <= ( TMAGIC + tol );
-                    bool n3 = false;
-                    if( sFaceVec[t].m_isQuad )
-                    {
-                        n3 = uwFace[3].y() <= ( TMAGIC + tol );
-                    }
-
-                    if ( ( n0 + n1 + n2 + n3 ) == 2 ) // Two true, one or two false.
-                    {
-                        // Perform index lookup as above.
-                        int i0 = pnCloud.GetNodeUsedIndex( allPntKey[i][sFaceVec[t].ind0] ) + 1;
-                        int i1 = pnCloud.GetNodeUsedIndex( allPntKey[i][sFaceVec[t].ind1] ) + 1;
-                        int i2 = pnCloud.GetNodeUsedIndex( allPntKey[i][sFaceVec[t].ind2] ) + 1;
-
-
-                        int i3 = -1;
-                        if( sFaceVec[t].m_isQuad )
-                        {
-                            i3 = pnCloud.GetNodeUsedIndex( allPntKey[i][sFaceVec[t].ind3] ) + 1;
-                        }
-
-                        // Add nodes to wake edges, lowest u first.
-                        if ( n0 && n1 )
-                        {
-                            if ( uwFace[0].x() < uwFace[1].x() )
-                            {
-                                wedges.push_back( pair< int, int>( i0, i1 ) );
-                            }
-                            else
-                            {
-                                wedges.push_back( pair< int, int>( i1, i0 ) );
-                            }
-                        }
-                        else if ( n1 && n2 )
-                        {
-                            if ( uwFace[1].x() < uwFace[2].x() )
-                            {
-                                wedges.push_back( pair< int, int>( i1, i2 ) );
-                            }
-                            else
-                            {
-                                wedges.push_back( pair< int, int>( i2, i1 ) );
-                            }
-                        }
-                        else if ( !sFaceVec[t].m_isQuad && n2 && n0 ) // Triangle only
-                        {
-                            if ( uwFace[2].x() < uwFace[0].x() )
-                            {
-                                wedges.push_back( pair< int, int>( i2, i0 ) );
-                            }
-                            else
-                            {
-                                wedges.push_back( pair< int, int>( i0, i2 ) );
-                            }
-                        }
-                        else if ( sFaceVec[t].m_isQuad && n2 && n3 ) // Quad only
-                        {
-                            if ( uwFace[2].x() < uwFace[3].x() )
-                            {
-                                wedges.push_back( pair< int, int>( i2, i3 ) );
-                            }
-                            else
-                            {
-                                wedges.push_back( pair< int, int>( i3, i2 ) );
-                            }
-                        }
-                        else if ( sFaceVec[t].m_isQuad && n3 && n0 ) // Quad only
-                        {
-                            if ( uwFace[3].x() < uwFace[0].x() )
-                            {
-                                wedges.push_back( pair< int, int>( i3, i0 ) );
-                            }
-                            else
-                            {
-                                wedges.push_back( pair< int, int>( i0, i3 ) );
-                            }
-                        }
-                    }
-                }
-            }
-
-        }
-    }
-
-    sort( wedges.begin(), wedges.end() );
-
-    vector < pair < int, int > >::iterator it;
-    it = unique( wedges.begin(), wedges.end() );
-    wedges.resize( distance( wedges.begin(), it ) );
-
-    list < pair < int, int > > wlist( wedges.begin(), wedges.end() );
-
-    vector < deque < pair < int, int > > > wakes;
-
-    while ( !wlist.empty() )
-    {
-        list < pair < int, int > >::iterator wit = wlist.begin();
-
-        int iwake = wakes.size();
-        wakes.resize( iwake + 1 );
-        wakes[iwake].push_back( *wit );
-        wit = wlist.erase( wit );
-
-        while ( wit != wlist.end() )
-        {
-            if ( wakes[iwake].back().second == (*wit).first )
-            {
-                wakes[iwake].push_back( *wit );
-                wlist.erase( wit );
-                wit = wlist.begin();
-                continue;
-            }
-            else if ( wakes[iwake].begin()->first == (*wit).second )
-            {
-                wakes[iwake].push_front( *wit );
-                wlist.erase( wit );
-                wit = wlist.begin();
-                continue;
-            }
-            wit++;
-        }
-    }
-
-
-    //==== Assemble All Used Points ====//
-    vector< vec3d > allUsedPntVec;
-    for ( int i = 0 ; i < ( int )allPntVec.size() ; i++ )
+    buf.AppendInt( ( long long int ) interiorPntVec.size() );
+    buf.Append( '\n' );
+    for ( int i = 0 ; i < ( int )interiorPntVec.size() ; i++ )
     {
-        if ( pnCloud.UsedNode( i ) )
-        {
-            allUsedPntVec.push_back( allPntVec[i] );
-        }
+        buf.AppendInt( i + 1 );
+        buf.Append( "  " );
+        ExportUtil::AppendXYZ( buf, interiorPntVec[i], 'g', 16 );
+        buf.Append( '\n' );
     }
 
-    //==== Assemble Wake Tris ====//
-    int wakeIndOffset = allUsedPntVec.size();
+    buf.Append( "# Part 4 - region list\n" );
+    buf.Append( "0\n" );
+
+    buf.Flush();
+    fclose( fp );
+}
+
+void CfdMeshMgrSingleton::WriteNASCART_Obj_Tri_Gmsh( const string &dat_fn, const string &key_fn, const string &obj_fn, const string &tri_fn, const string &gmsh_fn, const string & vspgeom_fn, const CfdExportTables & tables )
+{
+#ifdef DEBUG_CFD_MESH
+    //==== Find Smallest Edge ====//
+    double small_edge = 1.0e12;
     for ( int i = 0 ; i < ( int )m_SurfVec.size() ; i++ )
     {
-        if ( m_SurfVec[i]->GetWakeFlag() )
+        vector < SimpFace >& sFaceVec = m_SurfVec[i]->GetMesh()->GetSimpFaceVec();
+        vector< vec3d >& sPntVec = m_SurfVec[i]->GetMesh()->GetSimpPntVec();
+        for ( int f = 0 ; f < ( int )sFaceVec.size() ; f++ )
         {
-            vector < SimpFace >& sFaceVec = m_SurfVec[ i ]->GetMesh()->GetSimpFaceVec();
-            vector< vec3d >& sPntVec = m_SurfVec[i]->GetMesh()->GetSimpPntVec();
-            vector< vec2d >& sUWVec = m_SurfVec[i]->GetMesh()->GetSimpUWPntVec();
-            for ( int f = 0 ; f < ( int )sFaceVec.size() ; f++ )
+            double el0 = dist_squared( sPntVec[sFaceVec[f].ind0], sPntVec[sFaceVec[f].ind1] );
+            double el1 = dist_squared( sPntVec[sFaceVec[f].ind1], sPntVec[sFaceVec[f].ind2] );
+            double el2 = dist_squared( sPntVec[sFaceVec[f].ind2], sPntVec[sFaceVec[f].ind0] );
+            if ( el0 < small_edge )
             {
-                int i0 = wakepnCloud.GetNodeUsedIndex( allWPntKey[i][sFaceVec[f].ind0] );
-                int i1 = wakepnCloud.GetNodeUsedIndex( allWPntKey[i][sFaceVec[f].ind1] );
-                int i2 = wakepnCloud.GetNodeUsedIndex( allWPntKey[i][sFaceVec[f].ind2] );
-
-                SimpFace sface;
-                sface.ind0 = i0 + 1 + wakeIndOffset;
-                sface.ind1 = i1 + 1 + wakeIndOffset;
-                sface.ind2 = i2 + 1 + wakeIndOffset;
-
-                if( sFaceVec[f].m_isQuad )
-                {
-                    sface.m_isQuad = true;
-                    int i3 = wakepnCloud.GetNodeUsedIndex( allWPntKey[i][sFaceVec[f].ind3] );
-                    sface.ind3 = i3 + 1 + wakeIndOffset;
-                    ntristrict++; // Bonus tri for split quad
-                }
-
-                sface.m_Tags = sFaceVec[f].m_Tags;
-                ntristrict++;
-                allFaceVec.push_back( sface );
-                allSurfIDVec.push_back( m_SurfVec[i]->GetSurfID() );
-
-                vector< vec2d > uwFace( 4 );
-                uwFace[0] = sUWVec[ sFaceVec[f].ind0 ];
-                uwFace[1] = sUWVec[ sFaceVec[f].ind1 ];
-                uwFace[2] = sUWVec[ sFaceVec[f].ind2 ];
-                if( sFaceVec[f].m_isQuad )
-                {
-                    uwFace[3] = sUWVec[ sFaceVec[f].ind3 ];
-                }
-                allUWVec.push_back( uwFace );
-
+                small_edge = el0;
+            }
+            if ( el1 < small_edge )
+            {
+                small_edge = el1;
+            }
+            if ( el2 < small_edge )
+            {
+                small_edge = el2;
             }
         }
     }
 
-    //==== Assemble All Used Points ====//
-    for ( int i = 0 ; i < ( int )wakeAllPntVec.size() ; i++ )
-    {
-        if ( wakepnCloud.UsedNode( i ) )
-        {
-            allUsedPntVec.push_back( wakeAllPntVec[i] );
-        }
-    }
+    fprintf( m_DebugFile, "CfdMeshMgr::WriteNASCART Small Edge Length = %f \n", sqrt( small_edge ) );
+#endif
+
+    const vector< vec3d > &allUsedPntVec = tables.m_PntVec;
+    const vector< SimpFace > &allFaceVec = tables.m_FaceVec;
+    const vector< vec2d > &allUWVec = tables.m_FaceUW;
+    const vector< int > &allTagVec = tables.m_FaceTag;
+    const vector< int > &allPartVec = tables.m_FacePart;
+    const vector < deque < pair < int, int > > > &wakes = tables.m_Wakes;
+    int ntristrict = tables.m_NumTris;
+
+    int npnt = ( int )allUsedPntVec.size();
+    int nface = ( int )allFaceVec.size();
 
     //=====================================================================================//
     //==== Write NASCART File =================================================================//
@@ -1615,29 +1681,43 @@ void CfdMeshMgrSingleton::WriteNASCART_Obj_Tri_Gmsh( const string &dat_fn, const
 
         if ( fp )
         {
+            ExportBuffer buf( fp );
+
             //===== Write Num Pnts and Tris ====//
-            fprintf( fp, "%d %d\n", ( int )allUsedPntVec.size(), ntristrict );
+            buf.AppendInt( npnt );
+            buf.Append( ' ' );
+            buf.AppendInt( ntristrict );
+            buf.Append( '\n' );
 
             //==== Write Pnts ====//
-            for ( int i = 0 ; i < ( int )allUsedPntVec.size() ; i++ )
+            ExportUtil::ParallelAppend( buf, npnt, [&]( ExportBuffer & b, int i )
             {
-                fprintf( fp, "%.16g %.16g %.16g\n", allUsedPntVec[i].x(), allUsedPntVec[i].z(), -allUsedPntVec[i].y() );
-            }
+                const vec3d &p = allUsedPntVec[i];
+                ExportUtil::AppendXYZ( b, vec3d( p.x(), p.z(), -p.y() ), 'g', 16 );
+                b.Append( '\n' );
+            } );
 
             //==== Write Tris ====//
-            for ( int i = 0 ; i < ( int )allFaceVec.size() ; i++ )
+            ExportUtil::ParallelAppend( buf, nface, [&]( ExportBuffer & b, int i )
             {
-                fprintf( fp, "%d %d %d %d.0\n",
-                         allFaceVec[i].ind0, allFaceVec[i].ind2, allFaceVec[i].ind1,
-                         SubSurfaceMgr.GetTag( allFaceVec[i].m_Tags ) );
+                const SimpFace &f = allFaceVec[i];
+                int ind[2][3] = { { f.ind0, f.ind2, f.ind1 }, { f.ind0, f.ind3, f.ind2 } };
+                int ntri = f.m_isQuad ? 2 : 1;
 
-                if( allFaceVec[i].m_isQuad )
+                for ( int j = 0; j < ntri; j++ )
                 {
-                    fprintf( fp, "%d %d %d %d.0\n",
-                             allFaceVec[i].ind0, allFaceVec[i].ind3, allFaceVec[i].ind2,
-                             SubSurfaceMgr.GetTag( allFaceVec[i].m_Tags ) );
+                    b.AppendInt( ind[j][0] );
+                    b.Append( ' ' );
+                    b.AppendInt( ind[j][1] );
+                    b.Append( ' ' );
+                    b.AppendInt( ind[j][2] );
+                    b.Append( ' ' );
+                    b.AppendInt( allTagVec[i] );
+                    b.Append( ".0\n" );
                 }
-            }
+            } );
+
+            buf.Flush();
             fclose( fp );
         }
     }
@@ -1656,25 +1736,38 @@ void CfdMeshMgrSingleton::WriteNASCART_Obj_Tri_Gmsh( const string &dat_fn, const
 
         if ( fp )
         {
+            ExportBuffer buf( fp );
+
             //==== Write Pnts ====//
-            for ( int i = 0 ; i < ( int )allUsedPntVec.size() ; i++ )
+            ExportUtil::ParallelAppend( buf, npnt, [&]( ExportBuffer & b, int i )
             {
-                fprintf( fp, "v %16.10f %16.10f %16.10f\n", allUsedPntVec[i].x(), allUsedPntVec[i].z(), -allUsedPntVec[i].y() );
-            }
-            fprintf( fp, "\n" );
+                const vec3d &p = allUsedPntVec[i];
+                b.Append( "v " );
+                ExportUtil::AppendXYZ( b, vec3d( p.x(), p.z(), -p.y() ), 'f', 10, 16 );
+                b.Append( '\n' );
+            } );
+            buf.Append( '\n' );
 
             //==== Write Tris ====//
-            for ( int i = 0 ; i < ( int )allFaceVec.size() ; i++ )
+            ExportUtil::ParallelAppend( buf, nface, [&]( ExportBuffer & b, int i )
             {
-                if( allFaceVec[i].m_isQuad )
+                const SimpFace &f = allFaceVec[i];
+                b.Append( "f " );
+                b.AppendInt( f.ind0 );
+                b.Append( ' ' );
+                b.AppendInt( f.ind1 );
+                b.Append( ' ' );
+                b.AppendInt( f.ind2 );
+                b.Append( ' ' );
+                if( f.m_isQuad )
                 {
-                    fprintf( fp, "f %d %d %d %d \n", allFaceVec[i].ind0, allFaceVec[i].ind1, allFaceVec[i].ind2, allFaceVec[i].ind3 );
+                    b.AppendInt( f.ind3 );
+                    b.Append( ' ' );
                 }
-                else
-                {
-                    fprintf( fp, "f %d %d %d \n", allFaceVec[i].ind0, allFaceVec[i].ind1, allFaceVec[i].ind2 );
-                }
-            }
+                b.Append( '\n' );
+            } );
+
+            buf.Flush();
             fclose( fp );
         }
     }
@@ -1683,41 +1776,106 @@ void CfdMeshMgrSingleton::WriteNASCART_Obj_Tri_Gmsh( const string &dat_fn, const
     //=====================================================================================//
     //==== Write TRI File for Cart3D ======================================================//
     //=====================================================================================//
-    if ( tri_fn.length() != 0 )
+    if ( tri_fn.length() != 0 && GetCfdSettingsPtr()->m_BinaryTRIFlag )
+    {
+        FILE* fp = fopen( tri_fn.c_str(), "wb" );
+
+        if ( fp )
+        {
+            // Unformatted little endian, double precision vertices.
+            ExportBuffer buf( fp );
+
+            int counts[2] = { npnt, ntristrict };
+            ExportUtil::AppendFortranRecord( buf, counts, 2, sizeof( int ) );
+
+            vector< double > xyz( 3 * npnt );
+            for ( int i = 0 ; i < npnt ; i++ )
+            {
+                xyz[ 3 * i ] = allUsedPntVec[i].x();
+                xyz[ 3 * i + 1 ] = allUsedPntVec[i].y();
+                xyz[ 3 * i + 2 ] = allUsedPntVec[i].z();
+            }
+            ExportUtil::AppendFortranRecord( buf, xyz.data(), xyz.size(), sizeof( double ) );
+            xyz.clear();
+
+            vector< int > tris;
+            vector< int > comps;
+            tris.reserve( 3 * ntristrict );
+            comps.reserve( ntristrict );
+            for ( int i = 0 ; i < nface ; i++ )
+            {
+                const SimpFace &f = allFaceVec[i];
+                tris.push_back( f.ind0 );
+                tris.push_back( f.ind1 );
+                tris.push_back( f.ind2 );
+                comps.push_back( allTagVec[i] );
+                if( f.m_isQuad )
+                {
+                    tris.push_back( f.ind0 );
+                    tris.push_back( f.ind2 );
+                    tris.push_back( f.ind3 );
+                    comps.push_back( allTagVec[i] );
+                }
+            }
+            ExportUtil::AppendFortranRecord( buf, tris.data(), tris.size(), sizeof( int ) );
+            ExportUtil::AppendFortranRecord( buf, comps.data(), comps.size(), sizeof( int ) );
+
+            buf.Flush();
+            fclose( fp );
+        }
+    }
+    else if ( tri_fn.length() != 0 )
     {
         FILE* fp = fopen( tri_fn.c_str(), "w" );
 
         if ( fp )
         {
+            ExportBuffer buf( fp );
+
             //==== Write Pnt Count and Tri Count ====//
-            fprintf( fp, "%d %d\n", ( int )allUsedPntVec.size(), ntristrict );
+            buf.AppendInt( npnt );
+            buf.Append( ' ' );
+            buf.AppendInt( ntristrict );
+            buf.Append( '\n' );
 
             //==== Write Pnts ====//
-            for ( int i = 0 ; i < ( int )allUsedPntVec.size() ; i++ )
+            ExportUtil::ParallelAppend( buf, npnt, [&]( ExportBuffer & b, int i )
             {
-                fprintf( fp, "%16.10g %16.10g %16.10g\n", allUsedPntVec[i].x(), allUsedPntVec[i].y(), allUsedPntVec[i].z() );
-            }
+                ExportUtil::AppendXYZ( b, allUsedPntVec[i], 'g', 10, 16 );
+                b.Append( '\n' );
+            } );
 
             //==== Write Tris ====//
-            for ( int i = 0 ; i < ( int )allFaceVec.size() ; i++ )
+            ExportUtil::ParallelAppend( buf, nface, [&]( ExportBuffer & b, int i )
             {
-                fprintf( fp, "%d %d %d \n", allFaceVec[i].ind0, allFaceVec[i].ind1, allFaceVec[i].ind2 );
-                if( allFaceVec[i].m_isQuad )
+                const SimpFace &f = allFaceVec[i];
+                int ind[2][3] = { { f.ind0, f.ind1, f.ind2 }, { f.ind0, f.ind2, f.ind3 } };
+                int ntri = f.m_isQuad ? 2 : 1;
+
+                for ( int j = 0; j < ntri; j++ )
                 {
-                    fprintf( fp, "%d %d %d \n", allFaceVec[i].ind0, allFaceVec[i].ind2, allFaceVec[i].ind3 );
+                    b.AppendInt( ind[j][0] );
+                    b.Append( ' ' );
+                    b.AppendInt( ind[j][1] );
+                    b.Append( ' ' );
+                    b.AppendInt( ind[j][2] );
+                    b.Append( " \n" );
                 }
-            }
+            } );
 
             //==== Write Component ID ====//
-            for ( int i = 0 ; i < ( int )allFaceVec.size() ; i++ )
+            ExportUtil::ParallelAppend( buf, nface, [&]( ExportBuffer & b, int i )
             {
-                fprintf( fp, "%d \n", SubSurfaceMgr.GetTag( allFaceVec[i].m_Tags ) );
+                b.AppendInt( allTagVec[i] );
+                b.Append( " \n" );
                 if( allFaceVec[i].m_isQuad )
                 {
-                    fprintf( fp, "%d \n", SubSurfaceMgr.GetTag( allFaceVec[i].m_Tags ) );
+                    b.AppendInt( allTagVec[i] );
+                    b.Append( " \n" );
                 }
-            }
+            } );
 
+            buf.Flush();
             fclose( fp );
         }
     }
@@ -1727,42 +1885,109 @@ void CfdMeshMgrSingleton::WriteNASCART_Obj_Tri_Gmsh( const string &dat_fn, const
     //=====================================================================================//
     if ( gmsh_fn.length() != 0 )
     {
-        FILE* fp = fopen( gmsh_fn.c_str(), "w" );
+        bool binary = GetCfdSettingsPtr()->m_BinaryGmshFlag;
+
+        FILE* fp = fopen( gmsh_fn.c_str(), binary ? "wb" : "w" );
         if ( fp )
         {
-            fprintf( fp, "$MeshFormat\n" );
-            fprintf( fp, "2.2 0 %d\n", ( int )sizeof( double ) );
-            fprintf( fp, "$EndMeshFormat\n" );
+            ExportBuffer buf( fp );
+
+            buf.Append( "$MeshFormat\n" );
+            buf.Append( binary ? "2.2 1 " : "2.2 0 " );
+            buf.AppendInt( ( int )sizeof( double ) );
+            buf.Append( '\n' );
+            if ( binary )
+            {
+                // Integer 1 lets readers detect the byte order.
+                int one = 1;
+                buf.AppendBinary( one );
+                buf.Append( '\n' );
+            }
+            buf.Append( "$EndMeshFormat\n" );
 
             //==== Write Nodes ====//
-            fprintf( fp, "$Nodes\n" );
-            fprintf( fp, "%d\n", ( int )allUsedPntVec.size() );
-            for ( int i = 0 ; i < ( int )allUsedPntVec.size() ; i++ )
+            buf.Append( "$Nodes\n" );
+            buf.AppendInt( npnt );
+            buf.Append( '\n' );
+            if ( binary )
+            {
+                for ( int i = 0 ; i < npnt ; i++ )
+                {
+                    int id = i + 1;
+                    double xyz[3] = { allUsedPntVec[i].x(), allUsedPntVec[i].y(), allUsedPntVec[i].z() };
+                    buf.AppendBinary( id );
+                    buf.AppendBinary( xyz, sizeof( xyz ) );
+                }
+                buf.Append( '\n' );
+            }
+            else
             {
-                fprintf( fp, "%d %16.10f %16.10f %16.10f\n", i + 1,
-                         allUsedPntVec[i].x(), allUsedPntVec[i].y(), allUsedPntVec[i].z() );
+                ExportUtil::ParallelAppend( buf, npnt, [&]( ExportBuffer & b, int i )
+                {
+                    b.AppendInt( i + 1 );
+                    b.Append( ' ' );
+                    ExportUtil::AppendXYZ( b, allUsedPntVec[i], 'f', 10, 16 );
+                    b.Append( '\n' );
+                } );
             }
-            fprintf( fp, "$EndNodes\n" );
+            buf.Append( "$EndNodes\n" );
 
             //==== Write Tris ====//
-            fprintf( fp, "$Elements\n" );
-            fprintf( fp, "%d\n", ( int )allFaceVec.size() );
+            buf.Append( "$Elements\n" );
+            buf.AppendInt( nface );
+            buf.Append( '\n' );
 
-            int ele_cnt = 1;
-            for ( int i = 0 ; i < ( int )allFaceVec.size() ; i++ )
+            if ( binary )
             {
-                if( allFaceVec[i].m_isQuad )
+                // Runs of like elements are written as blocks of
+                // element type, element count, tag count (0).
+                int i = 0;
+                while ( i < nface )
                 {
-                    fprintf( fp, "%d 3 0 %d %d %d %d \n", ele_cnt, allFaceVec[i].ind0, allFaceVec[i].ind1, allFaceVec[i].ind2, allFaceVec[i].ind3 );
+                    bool quad = allFaceVec[i].m_isQuad;
+                    int iend = i;
+                    while ( iend < nface && allFaceVec[iend].m_isQuad == quad )
+                    {
+                        iend++;
+                    }
+
+                    int header[3] = { quad ? 3 : 2, iend - i, 0 };
+                    buf.AppendBinary( header, sizeof( header ) );
+
+                    for ( ; i < iend; i++ )
+                    {
+                        const SimpFace &f = allFaceVec[i];
+                        int ele[5] = { i + 1, f.ind0, f.ind1, f.ind2, f.ind3 };
+                        buf.AppendBinary( ele, ( quad ? 5 : 4 ) * sizeof( int ) );
+                    }
                 }
-                else
+                buf.Append( '\n' );
+            }
+            else
+            {
+                ExportUtil::ParallelAppend( buf, nface, [&]( ExportBuffer & b, int i )
                 {
-                    fprintf( fp, "%d 2 0 %d %d %d \n", ele_cnt, allFaceVec[i].ind0, allFaceVec[i].ind1, allFaceVec[i].ind2 );
-                }
-                ele_cnt++;
+                    const SimpFace &f = allFaceVec[i];
+                    b.AppendInt( i + 1 );
+                    b.Append( f.m_isQuad ? " 3 0 " : " 2 0 " );
+                    b.AppendInt( f.ind0 );
+                    b.Append( ' ' );
+                    b.AppendInt( f.ind1 );
+                    b.Append( ' ' );
+                    b.AppendInt( f.ind2 );
+                    b.Append( ' ' );
+                    if( f.m_isQuad )
+                    {
+                        b.AppendInt( f.ind3 );
+                        b.Append( ' ' );
+                    }
+                    b.Append( '\n' );
+                } );
             }
 
-            fprintf( fp, "$EndElements\n" );
+            buf.Append( "$EndElements\n" );
+
+            buf.Flush();
             fclose( fp );
         }
     }
@@ -1773,126 +1998,163 @@ void CfdMeshMgrSingleton::WriteNASCART_Obj_Tri_Gmsh( const string &dat_fn, const
     if ( vspgeom_fn.length() != 0 )
     {
         bool allowquads = true;
-        int nface = -1;
+        int nvspface = -1;
         if ( allowquads )
         {
-            nface = ( int )allFaceVec.size();
+            nvspface = nface;
         }
         else
         {
-            nface = ntristrict;
+            nvspface = ntristrict;
         }
 
+        // Component ID and u, w of a face, or of the second tri of a split quad.
+        // Same text as "%d %d %16.10g %16.10g ..." with optional leading face number.
+        auto append_tag_uw = [&]( ExportBuffer & b, int iface, int i, int ntri_pnt, const int * k )
+        {
+            int tag = allTagVec[i];
+            int part = allPartVec[i];
+
+            double uscale = SubSurfaceMgr.m_CompUscale[ part - 1 ];
+            double wscale = SubSurfaceMgr.m_CompWscale[ part - 1 ];
+
+            if ( iface > 0 )
+            {
+                b.AppendInt( iface );
+                b.Append( ' ' );
+            }
+            b.AppendInt( part );
+            b.Append( ' ' );
+            b.AppendInt( tag );
+            for ( int j = 0; j < ntri_pnt; j++ )
+            {
+                const vec2d &uw = allUWVec[ 4 * i + k[j] ];
+                b.Append( ' ' );
+                b.AppendDouble( uw.x() / uscale, 'g', 10, 16 );
+                b.Append( ' ' );
+                b.AppendDouble( uw.y() / wscale, 'g', 10, 16 );
+            }
+            b.Append( '\n' );
+        };
+        const int k012[3] = { 0, 1, 2 };
+        const int k0123[4] = { 0, 1, 2, 3 };
+        const int k023[3] = { 0, 2, 3 };
+        const int k012023[6] = { 0, 1, 2, 0, 2, 3 };
+
         FILE* fp = fopen( vspgeom_fn.c_str(), "w" );
 
         if ( fp )
         {
-            fprintf( fp, "# vspgeom v3\n" );
-            fprintf( fp, "1\n" );  // Number of meshes.
-            fprintf( fp, "%d %d %d\n", allUsedPntVec.size(), nface, wakes.size() );
+            ExportBuffer buf( fp );
+
+            buf.Append( "# vspgeom v3\n" );
+            buf.Append( "1\n" );  // Number of meshes.
+            buf.AppendInt( npnt );
+            buf.Append( ' ' );
+            buf.AppendInt( nvspface );
+            buf.Append( ' ' );
+            buf.AppendInt( ( int ) wakes.size() );
+            buf.Append( '\n' );
 
             //==== Write Pnts ====//
-            for ( int i = 0 ; i < ( int )allUsedPntVec.size() ; i++ )
+            ExportUtil::ParallelAppend( buf, npnt, [&]( ExportBuffer & b, int i )
             {
-                fprintf( fp, "%16.10g %16.10g %16.10g\n", allUsedPntVec[i].x(), allUsedPntVec[i].y(), allUsedPntVec[i].z() );
-            }
+                ExportUtil::AppendXYZ( b, allUsedPntVec[i], 'g', 10, 16 );
+                b.Append( '\n' );
+            } );
 
             if ( allowquads )
             {
                 //==== Write Face Count ====//
-                fprintf( fp, "%d\n", ( int )allFaceVec.size() );
+                buf.AppendInt( nface );
+                buf.Append( '\n' );
 
                 //==== Write Faces ====//
-                for ( int i = 0 ; i < ( int )allFaceVec.size() ; i++ )
+                ExportUtil::ParallelAppend( buf, nface, [&]( ExportBuffer & b, int i )
                 {
-                    if( allFaceVec[i].m_isQuad )
-                    {
-                        fprintf( fp, "4 %d %d %d %d \n", allFaceVec[i].ind0, allFaceVec[i].ind1, allFaceVec[i].ind2, allFaceVec[i].ind3 );
-                    }
-                    else
+                    const SimpFace &f = allFaceVec[i];
+                    b.Append( f.m_isQuad ? "4 " : "3 " );
+                    b.AppendInt( f.ind0 );
+                    b.Append( ' ' );
+                    b.AppendInt( f.ind1 );
+                    b.Append( ' ' );
+                    b.AppendInt( f.ind2 );
+                    b.Append( ' ' );
+                    if( f.m_isQuad )
                     {
-                        fprintf( fp, "3 %d %d %d \n", allFaceVec[i].ind0, allFaceVec[i].ind1, allFaceVec[i].ind2 );
+                        b.AppendInt( f.ind3 );
+                        b.Append( ' ' );
                     }
-                }
+                    b.Append( '\n' );
+                } );
             }
             else
             {
                 //==== Write Face Count ====//
-                fprintf( fp, "%d\n", ntristrict );
+                buf.AppendInt( ntristrict );
+                buf.Append( '\n' );
 
                 //==== Write Tris Only ====//
-                for ( int i = 0 ; i < ( int )allFaceVec.size() ; i++ )
+                ExportUtil::ParallelAppend( buf, nface, [&]( ExportBuffer & b, int i )
                 {
-                    fprintf( fp, "3 %d %d %d \n", allFaceVec[i].ind0, allFaceVec[i].ind1, allFaceVec[i].ind2 );
-                    if( allFaceVec[i].m_isQuad )
+                    const SimpFace &f = allFaceVec[i];
+                    int ind[2][3] = { { f.ind0, f.ind1, f.ind2 }, { f.ind0, f.ind2, f.ind3 } };
+                    int ntri = f.m_isQuad ? 2 : 1;
+
+                    for ( int j = 0; j < ntri; j++ )
                     {
-                        fprintf( fp, "3 %d %d %d \n", allFaceVec[i].ind0, allFaceVec[i].ind2, allFaceVec[i].ind3 );
+                        b.Append( "3 " );
+                        b.AppendInt( ind[j][0] );
+                        b.Append( ' ' );
+                        b.AppendInt( ind[j][1] );
+                        b.Append( ' ' );
+                        b.AppendInt( ind[j][2] );
+                        b.Append( " \n" );
                     }
-                }
+                } );
             }
 
             if ( allowquads )
             {
                 //==== Write Component ID ====//
-                for ( int i = 0 ; i < ( int )allFaceVec.size() ; i++ )
+                ExportUtil::ParallelAppend( buf, nface, [&]( ExportBuffer & b, int i )
                 {
-                    int tag = SubSurfaceMgr.GetTag( allFaceVec[i].m_Tags );
-                    int part = SubSurfaceMgr.GetPart( allFaceVec[i].m_Tags );
-
-                    double uscale = SubSurfaceMgr.m_CompUscale[ part - 1 ];
-                    double wscale = SubSurfaceMgr.m_CompWscale[ part - 1 ];
-
                     if( allFaceVec[i].m_isQuad )
                     {
-                        fprintf( fp, "%d %d %16.10g %16.10g %16.10g %16.10g %16.10g %16.10g %16.10g %16.10g\n", part, tag,
-                             allUWVec[i][0].x() / uscale, allUWVec[i][0].y() / wscale,
-                             allUWVec[i][1].x() / uscale, allUWVec[i][1].y() / wscale,
-                             allUWVec[i][2].x() / uscale, allUWVec[i][2].y() / wscale,
-                             allUWVec[i][3].x() / uscale, allUWVec[i][3].y() / wscale );
+                        append_tag_uw( b, 0, i, 4, k0123 );
                     }
                     else
                     {
-                        fprintf( fp, "%d %d %16.10g %16.10g %16.10g %16.10g %16.10g %16.10g\n", part, tag,
-                                 allUWVec[i][0].x() / uscale, allUWVec[i][0].y() / wscale,
-                                 allUWVec[i][1].x() / uscale, allUWVec[i][1].y() / wscale,
-                                 allUWVec[i][2].x() / uscale, allUWVec[i][2].y() / wscale );
+                        append_tag_uw( b, 0, i, 3, k012 );
                     }
-                }
+                } );
             }
             else
             {
                 //==== Write Component ID ====//
-                for ( int i = 0 ; i < ( int )allFaceVec.size() ; i++ )
+                ExportUtil::ParallelAppend( buf, nface, [&]( ExportBuffer & b, int i )
                 {
-                    int tag = SubSurfaceMgr.GetTag( allFaceVec[i].m_Tags );
-                    int part = SubSurfaceMgr.GetPart( allFaceVec[i].m_Tags );
-
-                    double uscale = SubSurfaceMgr.m_CompUscale[ part - 1 ];
-                    double wscale = SubSurfaceMgr.m_CompWscale[ part - 1 ];
-
-                    fprintf( fp, "%d %d %16.10g %16.10g %16.10g %16.10g %16.10g %16.10g\n", part, tag,
-                             allUWVec[i][0].x() / uscale, allUWVec[i][0].y() / wscale,
-                             allUWVec[i][1].x() / uscale, allUWVec[i][1].y() / wscale,
-                             allUWVec[i][2].x() / uscale, allUWVec[i][2].y() / wscale );
+                    append_tag_uw( b, 0, i, 3, k012 );
                     if( allFaceVec[i].m_isQuad )
                     {
-                        fprintf( fp, "%d %d %16.10g %16.10g %16.10g %16.10g %16.10g %16.10g\n", part, tag,
-                                 allUWVec[i][0].x() / uscale, allUWVec[i][0].y() / wscale,
-                                 allUWVec[i][2].x() / uscale, allUWVec[i][2].y() / wscale,
-                                 allUWVec[i][3].x() / uscale, allUWVec[i][3].y() / wscale );
+                        append_tag_uw( b, 0, i, 3, k023 );
                     }
-                }
+                } );
             }
 
             // Write parents
-            for ( int i = 0; i < nface; i++ )
+            ExportUtil::ParallelAppend( buf, nvspface, [&]( ExportBuffer & b, int i )
             {
-                fprintf( fp, "%d %d\n", i + 1, i + 1 );
-            }
+                b.AppendInt( i + 1 );
+                b.Append( ' ' );
+                b.AppendInt( i + 1 );
+                b.Append( '\n' );
+            } );
 
             int nwake = wakes.size();
             // Wake line data.
-            fprintf( fp, "%d\n", nwake );
+            buf.AppendInt( nwake );
+            buf.Append( '\n' );
 
             for ( int iwake = 0; iwake < nwake; iwake++ )
             {
@@ -1900,23 +2162,25 @@ void CfdMeshMgrSingleton::WriteNASCART_Obj_Tri_Gmsh( const string &dat_fn, const
                 int iprt = 0;
                 int iwe;
                 int nwe = wakes[iwake].size();
-                fprintf( fp, "%d 0 ", nwe + 1 ); // 0 is place holder for part number.
+                buf.AppendInt( nwe + 1 );
+                buf.Append( " 0 " ); // 0 is place holder for part number.
                 for ( iwe = 0; iwe < nwe; iwe++ )
                 {
-                    fprintf( fp, "%d", wakes[iwake][iwe].first );
+                    buf.AppendInt( wakes[iwake][iwe].first );
 
                     if ( iprt < 9 )
                     {
-                        fprintf( fp, " " );
+                        buf.Append( ' ' );
                         iprt++;
                     }
                     else
                     {
-                        fprintf( fp, "\n" );
+                        buf.Append( '\n' );
                         iprt = 0;
                     }
                 }
-                fprintf( fp, "%d\n", wakes[iwake][iwe-1].second );
+                buf.AppendInt( wakes[iwake][iwe-1].second );
+                buf.Append( '\n' );
 
             }
 
@@ -1924,30 +2188,54 @@ void CfdMeshMgrSingleton::WriteNASCART_Obj_Tri_Gmsh( const string &dat_fn, const
             if ( allowquads )
             {
                 //==== Write Faces ====//
-                for ( int i = 0 ; i < ( int )allFaceVec.size() ; i++ )
+                ExportUtil::ParallelAppend( buf, nface, [&]( ExportBuffer & b, int i )
                 {
-                    if( allFaceVec[i].m_isQuad )
+                    const SimpFace &f = allFaceVec[i];
+                    b.AppendInt( i + 1 );
+                    if( f.m_isQuad )
                     {
-                        fprintf( fp, "%d 2 %d %d %d %d %d %d\n", i + 1, allFaceVec[i].ind0, allFaceVec[i].ind1, allFaceVec[i].ind2, allFaceVec[i].ind0, allFaceVec[i].ind2, allFaceVec[i].ind3 );
+                        int ind[6] = { f.ind0, f.ind1, f.ind2, f.ind0, f.ind2, f.ind3 };
+                        b.Append( " 2" );
+                        for ( int j = 0; j < 6; j++ )
+                        {
+                            b.Append( ' ' );
+                            b.AppendInt( ind[j] );
+                        }
                     }
                     else
                     {
-                        fprintf( fp, "%d 1 %d %d %d\n", i + 1, allFaceVec[i].ind0, allFaceVec[i].ind1, allFaceVec[i].ind2 );
+                        int ind[3] = { f.ind0, f.ind1, f.ind2 };
+                        b.Append( " 1" );
+                        for ( int j = 0; j < 3; j++ )
+                        {
+                            b.Append( ' ' );
+                            b.AppendInt( ind[j] );
+                        }
                     }
-                }
+                    b.Append( '\n' );
+                } );
             }
             else
             {
                 int iface = 1;
 
                 //==== Write Tris Only ====//
-                for ( int i = 0 ; i < ( int )allFaceVec.size() ; i++ )
+                for ( int i = 0 ; i < nface ; i++ )
                 {
-                    fprintf( fp, "%d 1 %d %d %d \n", iface, allFaceVec[i].ind0, allFaceVec[i].ind1, allFaceVec[i].ind2 );
-                    iface++;
-                    if( allFaceVec[i].m_isQuad )
+                    const SimpFace &f = allFaceVec[i];
+                    int ind[2][3] = { { f.ind0, f.ind1, f.ind2 }, { f.ind0, f.ind2, f.ind3 } };
+                    int ntri = f.m_isQuad ? 2 : 1;
+
+                    for ( int j = 0; j < ntri; j++ )
                     {
-                        fprintf( fp, "%d 1 %d %d %d \n", iface, allFaceVec[i].ind0, allFaceVec[i].ind2, allFaceVec[i].ind3 );
+                        buf.AppendInt( iface );
+                        buf.Append( " 1 " );
+                        buf.AppendInt( ind[j][0] );
+                        buf.Append( ' ' );
+                        buf.AppendInt( ind[j][1] );
+                        buf.Append( ' ' );
+                        buf.AppendInt( ind[j][2] );
+                        buf.Append( " \n" );
                         iface++;
                     }
                 }
@@ -1956,65 +2244,39 @@ void CfdMeshMgrSingleton::WriteNASCART_Obj_Tri_Gmsh( const string &dat_fn, const
             if ( allowquads )
             {
                 //==== Write Component ID ====//
-                for ( int i = 0 ; i < ( int )allFaceVec.size() ; i++ )
+                ExportUtil::ParallelAppend( buf, nface, [&]( ExportBuffer & b, int i )
                 {
-                    int tag = SubSurfaceMgr.GetTag( allFaceVec[i].m_Tags );
-                    int part = SubSurfaceMgr.GetPart( allFaceVec[i].m_Tags );
-
-                    double uscale = SubSurfaceMgr.m_CompUscale[ part - 1 ];
-                    double wscale = SubSurfaceMgr.m_CompWscale[ part - 1 ];
-
                     if( allFaceVec[i].m_isQuad )
                     {
-                        fprintf( fp, "%d %d %d %16.10g %16.10g %16.10g %16.10g %16.10g %16.10g %16.10g %16.10g %16.10g %16.10g %16.10g %16.10g\n", i + 1, part, tag,
-                             allUWVec[i][0].x() / uscale, allUWVec[i][0].y() / wscale,
-                             allUWVec[i][1].x() / uscale, allUWVec[i][1].y() / wscale,
-                             allUWVec[i][2].x() / uscale, allUWVec[i][2].y() / wscale,
-                             allUWVec[i][0].x() / uscale, allUWVec[i][0].y() / wscale,
-                             allUWVec[i][2].x() / uscale, allUWVec[i][2].y() / wscale,
-                             allUWVec[i][3].x() / uscale, allUWVec[i][3].y() / wscale );
+                        append_tag_uw( b, i + 1, i, 6, k012023 );
                     }
                     else
                     {
-                        fprintf( fp, "%d %d %d %16.10g %16.10g %16.10g %16.10g %16.10g %16.10g\n", i + 1, part, tag,
-                                 allUWVec[i][0].x() / uscale, allUWVec[i][0].y() / wscale,
-                                 allUWVec[i][1].x() / uscale, allUWVec[i][1].y() / wscale,
-                                 allUWVec[i][2].x() / uscale, allUWVec[i][2].y() / wscale );
+                        append_tag_uw( b, i + 1, i, 3, k012 );
                     }
-                }
+                } );
             }
             else
             {
                 int iface = 1;
                 //==== Write Component ID ====//
-                for ( int i = 0 ; i < ( int )allFaceVec.size() ; i++ )
+                for ( int i = 0 ; i < nface ; i++ )
                 {
-                    int tag = SubSurfaceMgr.GetTag( allFaceVec[i].m_Tags );
-                    int part = SubSurfaceMgr.GetPart( allFaceVec[i].m_Tags );
-
-                    double uscale = SubSurfaceMgr.m_CompUscale[ part - 1 ];
-                    double wscale = SubSurfaceMgr.m_CompWscale[ part - 1 ];
-
-                    fprintf( fp, "%d %d %d %16.10g %16.10g %16.10g %16.10g %16.10g %16.10g\n", iface, part, tag,
-                             allUWVec[i][0].x() / uscale, allUWVec[i][0].y() / wscale,
-                             allUWVec[i][1].x() / uscale, allUWVec[i][1].y() / wscale,
-                             allUWVec[i][2].x() / uscale, allUWVec[i][2].y() / wscale );
+                    append_tag_uw( buf, iface, i, 3, k012 );
                     iface++;
                     if( allFaceVec[i].m_isQuad )
                     {
-                        fprintf( fp, "%d %d %d %16.10g %16.10g %16.10g %16.10g %16.10g %16.10g\n", iface, part, tag,
-                                 allUWVec[i][0].x() / uscale, allUWVec[i][0].y() / wscale,
-                                 allUWVec[i][2].x() / uscale, allUWVec[i][2].y() / wscale,
-                                 allUWVec[i][3].x() / uscale, allUWVec[i][3].y() / wscale );
+                        append_tag_uw( buf, iface, i, 3, k023 );
                         iface++;
                     }
                 }
             }
 
+            buf.Flush();
             fclose( fp );
         }
 
-        WriteTagFiles( vspgeom_fn, allFaceVec, allowquads );
+        WriteTagFiles( vspgeom_fn, tables, allowquads );
 
         SubSurfaceMgr.WriteVSPGEOMKeyFile( vspgeom_fn );
 
@@ -2028,7 +2290,7 @@ void CfdMeshMgrSingleton::WriteNASCART_Obj_Tri_Gmsh( const string &dat_fn, const
     }
 }
 
-void CfdMeshMgrSingleton::WriteTagFiles( string file_name, const vector< SimpFace > &allFaceVec, bool allowquads )
+void CfdMeshMgrSingleton::WriteTagFiles( string file_name, const CfdExportTables & tables, bool allowquads )
 {
     int ntagfile = 0;
     int ncsffile = 0;
@@ -2059,6 +2321,26 @@ void CfdMeshMgrSingleton::WriteTagFiles( string file_name, const vector< SimpFac
 
     if ( ntagfile > 0 )
     {
+        //==== Group Faces by Part and Tag Once ====//
+        // A face belongs to ( part, tag ) when its first tag is part and any of its tags is tag.
+        map< pair< int, int >, vector< int > > part_tag_faces;
+        for ( int i = 0 ; i < ( int )tables.m_FaceVec.size() ; i++ )
+        {
+            const vector< int > &ftags = tables.m_FaceVec[i].m_Tags;
+            if ( ftags.size() > 0 )
+            {
+                for ( int j = 0; j < ( int )ftags.size(); j++ )
+                {
+                    vector< int > &flist = part_tag_faces[ pair< int, int >( ftags[0], ftags[j] ) ];
+                    if ( flist.empty() || flist.back() != i )
+                    {
+                        flist.push_back( i );
+                    }
+                }
+            }
+        }
+        vector< int > empty_list;
+
         string base_name = GetBasename( file_name );
 
         string base_path, base_fname;
@@ -2131,7 +2413,15 @@ void CfdMeshMgrSingleton::WriteTagFiles( string file_name, const vector< SimpFac
                         FILE* fid = fopen( tagfile_name.c_str(), "w" );
                         if ( fid )
                         {
-                            WriteTagFile( fid, part, tag, allFaceVec, allowquads );
+                            map< pair< int, int >, vector< int > >::const_iterator mit = part_tag_faces.find( pair< int, int >( part, tag ) );
+                            if ( mit != part_tag_faces.end() )
+                            {
+                                WriteTagFile( fid, mit->second, tables, allowquads );
+                            }
+                            else
+                            {
+                                WriteTagFile( fid, empty_list, tables, allowquads );
+                            }
 
                             fclose( fid );
                         }
@@ -2149,143 +2439,66 @@ void CfdMeshMgrSingleton::WriteTagFiles( string file_name, const vector< SimpFac
     }
 }
 
-void CfdMeshMgrSingleton::WriteTagFile( FILE* file_id, int part, int tag, const vector< SimpFace > &allFaceVec, bool allowquads )
+void CfdMeshMgrSingleton::WriteTagFile( FILE* file_id, const vector< int > & face_list, const CfdExportTables & tables, bool allowquads )
 {
+    ExportBuffer buf( file_id );
+
     //==== Write Tri IDs for each tag =====//
     int count = 0;
     if ( allowquads )
     {
-        for ( int i = 0 ; i < ( int )allFaceVec.size() ; i++ )
-        {
-            if ( SubSurfaceMgr.MatchPartAndTag( allFaceVec[i].m_Tags, part, tag ) )
-            {
-                count++;
-            }
-        }
+        count = ( int )face_list.size();
     }
     else
     {
-        for ( int i = 0 ; i < ( int )allFaceVec.size() ; i++ )
+        for ( int i = 0 ; i < ( int )face_list.size() ; i++ )
         {
-            if ( SubSurfaceMgr.MatchPartAndTag( allFaceVec[i].m_Tags, part, tag ) )
-            {
-                count++;
-            }
-
-            if( allFaceVec[i].m_isQuad )
-            {
-                if ( SubSurfaceMgr.MatchPartAndTag( allFaceVec[i].m_Tags, part, tag ) )
-                {
-                    count++;
-                }
-            }
+            count += tables.m_FaceVec[ face_list[i] ].m_isQuad ? 2 : 1;
         }
     }
-    fprintf( file_id, "%d\n\n", count );
+    buf.AppendInt( count );
+    buf.Append( "\n\n" );
 
     if ( allowquads )
     {
-        for ( int i = 0 ; i < ( int )allFaceVec.size() ; i++ )
+        for ( int i = 0 ; i < ( int )face_list.size() ; i++ )
         {
-            if ( SubSurfaceMgr.MatchPartAndTag( allFaceVec[i].m_Tags, part, tag ) )
-            {
-                fprintf( file_id, "%d\n", i + 1 );
-            }
+            buf.AppendInt( face_list[i] + 1 );
+            buf.Append( '\n' );
         }
     }
     else
     {
+        // Tri number of each face once quads are split.
         int iface = 0;
+        int j = 0;
 
-        for ( int i = 0 ; i < ( int )allFaceVec.size() ; i++ )
+        for ( int i = 0 ; i < ( int )tables.m_FaceVec.size() && j < ( int )face_list.size() ; i++ )
         {
-            if ( SubSurfaceMgr.MatchPartAndTag( allFaceVec[i].m_Tags, part, tag ) )
-            {
-                fprintf( file_id, "%d\n", iface + 1 );
-            }
-            iface++;
-
-            if( allFaceVec[i].m_isQuad )
+            int ntri = tables.m_FaceVec[i].m_isQuad ? 2 : 1;
+            if ( face_list[j] == i )
             {
-                if ( SubSurfaceMgr.MatchPartAndTag( allFaceVec[i].m_Tags, part, tag ) )
+                for ( int k = 0; k < ntri; k++ )
                 {
-                    fprintf( file_id, "%d\n", iface + 1 );
+                    buf.AppendInt( iface + k + 1 );
+                    buf.Append( '\n' );
                 }
-                iface++;
+                j++;
             }
+            iface += ntri;
         }
     }
+
+    buf.Flush();
 }
 
-void CfdMeshMgrSingleton::WriteFacet( const string &facet_fn )
+void CfdMeshMgrSingleton::WriteFacet( const string &facet_fn, const CfdExportTables & tables )
 {
-    // Note: Wake mesh not included in Facet export
-
-    //==== Find All Points and Tri Counts ====//
-    vector< vec3d > allPntVec;
-    vector < vector < int > > allPntKey;
-    allPntKey.resize( m_SurfVec.size() );
-    int k = 0;
-    for ( int i = 0; i < (int)m_SurfVec.size(); i++ )
-    {
-        vector< vec3d >& sPntVec = m_SurfVec[i]->GetMesh()->GetSimpPntVec();
-        allPntKey[i].resize( sPntVec.size() );
-        for ( int v = 0; v < (int)sPntVec.size(); v++ )
-        {
-            if ( !m_SurfVec[i]->GetWakeFlag() )
-            {
-                allPntVec.push_back( sPntVec[v] );
-                allPntKey[i][v] = k;
-                k++;
-            }
-        }
-    }
-
-    //==== Build Map ====//
-    PntNodeCloud pnCloud;
-    pnCloud.AddPntNodes( allPntVec );
-
-    double tol = PT_MERGE_TOL;
-    //==== Use NanoFlann to Find Close Points and Group ====//
-    IndexPntNodes( pnCloud, tol );
-
-    //==== Assemble Normal Tris ====//
-    vector< SimpFace > allFaceVec;
-    for ( int i = 0; i < (int)m_SurfVec.size(); i++ )
-    {
-        if ( !m_SurfVec[i]->GetWakeFlag() )
-        {
-            vector < SimpFace >& sFaceVec = m_SurfVec[ i ]->GetMesh()->GetSimpFaceVec();
-            vector< vec3d >& sPntVec = m_SurfVec[i]->GetMesh()->GetSimpPntVec();
-            for ( int f = 0; f < (int)sFaceVec.size(); f++ )
-            {
-                int i0 = pnCloud.GetNodeUsedIndex( allPntKey[i][sFaceVec[f].ind0] );
-                int i1 = pnCloud.GetNodeUsedIndex( allPntKey[i][sFaceVec[f].ind1] );
-                int i2 = pnCloud.GetNodeUsedIndex( allPntKey[i][sFaceVec[f].ind2] );
-                SimpFace sface;
-                sface.ind0 = i0 + 1;
-                sface.ind1 = i1 + 1;
-                sface.ind2 = i2 + 1;
-                sface.m_Tags = sFaceVec[f].m_Tags;
-                if ( sFaceVec[f].m_isQuad )
-                {
-                    sface.m_isQuad = true;
-                    int i3 = pnCloud.GetNodeUsedIndex( allPntKey[i][sFaceVec[f].ind3] );
-                    sface.ind3 = i3 + 1;
-                }
-                allFaceVec.push_back( sface );
-            }
-        }
-    }
-    //==== Assemble All Used Points ====//
-    vector< vec3d > allUsedPntVec;
-    for ( int i = 0; i < (int)allPntVec.size(); i++ )
-    {
-        if ( pnCloud.UsedNode( i ) )
-        {
-            allUsedPntVec.push_back( allPntVec[i] );
-        }
-    }
+    // Note: Wake mesh not included in Facet export.  Solid points and faces
+    // are at the front of the split tables.
+    int npnt = tables.m_NumSolidPnts;
+    int nface = tables.m_NumSolidFaces;
+    const vector< SimpFace > &allFaceVec = tables.m_FaceVec;
 
     //=====================================================================================//
     //==== Write Facet File for Xpatch ====================================================//
@@ -2296,91 +2509,105 @@ void CfdMeshMgrSingleton::WriteFacet( const string &facet_fn )
 
         if ( fp )
         {
-            fprintf( fp, "Exported from %s\n", VSPVERSION4 ); // Title/comment line
-            fprintf( fp, "1 \n" ); // Number of "Big" parts (1 Vehicle broken into small parts by geom and subsurface)
+            ExportBuffer buf( fp );
 
-            fprintf( fp, "%s\n", m_Vehicle->GetName().c_str() ); // Name of "Big" part
+            buf.Append( string( "Exported from " ) + VSPVERSION4 + "\n" ); // Title/comment line
+            buf.Append( "1 \n" ); // Number of "Big" parts (1 Vehicle broken into small parts by geom and subsurface)
+
+            buf.Append( m_Vehicle->GetName() + "\n" ); // Name of "Big" part
 
             // mirror -> i, a b c d
             //     if i = 0 -> no mirror
             //     if i = 1 -> "Big" part is mirrored across plane defined by ax+by+cz-d=0
-            fprintf( fp, "0, 0.000 1.000 0.000 0.000 \n" );
+            buf.Append( "0, 0.000 1.000 0.000 0.000 \n" );
 
-            fprintf( fp, "%d \n", (int)allUsedPntVec.size() ); // # of nodes in "Big" part
+            buf.AppendInt( npnt ); // # of nodes in "Big" part
+            buf.Append( " \n" );
 
             //==== Write All Pnts (Nodes) ====//
-            for ( int i = 0; i < (int)allUsedPntVec.size(); i++ )
+            ExportUtil::ParallelAppend( buf, npnt, [&]( ExportBuffer & b, int i )
             {
-                fprintf( fp, "%16.10g %16.10g %16.10g\n", allUsedPntVec[i].x(), allUsedPntVec[i].y(), allUsedPntVec[i].z() );
-            }
-
-            vector < int > face_offset; // vector of number of faces for each tag
+                ExportUtil::AppendXYZ( b, tables.m_PntVec[i], 'g', 10, 16 );
+                b.Append( '\n' );
+            } );
 
             int materialID = 0; // Default Material ID of PEC (Referred to as "iCoat" in XPatch facet file documentation)
 
             vector < int > all_tag_vec = SubSurfaceMgr.GetAllTags(); // vector of tags, where each tag identifies a part or group of facets
 
-            //==== Get # of facets for each part ====//
+            //==== Group Faces by Tag ====//
+            map< int, int > tag_index;
             for ( unsigned int i = 0; i < all_tag_vec.size(); i++ )
             {
-                int tag_count = 0;
+                tag_index[ all_tag_vec[i] ] = i;
+            }
 
-                for ( unsigned int j = 0; j < allFaceVec.size(); j++ )
+            vector< vector< int > > tag_faces( all_tag_vec.size() );
+            vector < int > face_offset( all_tag_vec.size(), 0 ); // vector of number of faces for each tag
+            for ( int j = 0; j < nface; j++ )
+            {
+                map< int, int >::const_iterator mit = tag_index.find( tables.m_FaceTag[j] );
+                if ( mit != tag_index.end() )
                 {
-                    if ( all_tag_vec[i] == SubSurfaceMgr.GetTag( allFaceVec[j].m_Tags ) )
-                    {
-                        tag_count++;
+                    tag_faces[ mit->second ].push_back( j );
 
-                        // Count extra tri as quads will be split.
-                        if( allFaceVec[j].m_isQuad )
-                        {
-                            tag_count++;
-                        }
-                    }
+                    // Count extra tri as quads will be split.
+                    face_offset[ mit->second ] += allFaceVec[j].m_isQuad ? 2 : 1;
                 }
-
-                face_offset.push_back( tag_count );
             }
 
-            fprintf( fp, "%zu \n", face_offset.size() ); // # of "Small" parts
+            buf.AppendInt( ( long long int ) face_offset.size() ); // # of "Small" parts
+            buf.Append( " \n" );
 
             int facet_count = 0; // counter for number of tris/facets
 
-                                 //==== Write Out Tris ====//
+            //==== Write Out Tris ====//
             for ( unsigned int i = 0; i < all_tag_vec.size(); i++ )
             {
-                int curr_tag = all_tag_vec[i];
-                bool new_section = true; // flag to write small part section header
+                const vector< int > &flist = tag_faces[i];
+                if ( flist.empty() )
+                {
+                    continue;
+                }
+
+                // Write small part header
+                string name = SubSurfaceMgr.GetTagNames( allFaceVec[ flist[0] ].m_Tags );
+                buf.Append( name + "\n" ); // Write name of small part
+                buf.AppendInt( face_offset[i] ); // Number of facets for the part, 3 nodes per facet
+                buf.Append( " 3\n" );
 
-                for ( unsigned int j = 0; j < allFaceVec.size(); j++ )
+                for ( unsigned int j = 0; j < flist.size(); j++ )
                 {
-                    if ( curr_tag == SubSurfaceMgr.GetTag( allFaceVec[j].m_Tags ) ) // only write out current tris for surrent tag
-                    {
-                        if ( new_section ) // write small part header and get material ID for small part
-                        {
-                            string name = SubSurfaceMgr.GetTagNames( allFaceVec[j].m_Tags );
-                            fprintf( fp, "%s\n", name.c_str() ); // Write name of small part
-                            fprintf( fp, "%d 3\n", face_offset[i] ); // Number of facets for the part, 3 nodes per facet
+                    const SimpFace &f = allFaceVec[ flist[j] ];
 
-                            new_section = false;
-                        }
+                    // 3 nodes of facet, material ID, component ID, running facet #:
+                    // Split quad into two tris.  It may be possible to write out tris and quads separately by
+                    // grouping them appropriately and then writing separate groups.  However, without documentation
+                    // of the facet file format, this approach is the least risky.
+                    int ind[2][3] = { { f.ind0, f.ind1, f.ind2 }, { f.ind0, f.ind2, f.ind3 } };
+                    int ntri = f.m_isQuad ? 2 : 1;
 
+                    for ( int k = 0; k < ntri; k++ )
+                    {
                         facet_count++;
 
-                        // 3 nodes of facet, material ID, component ID, running facet #:
-                        fprintf( fp, "%d %d %d %d %u %d\n", allFaceVec[j].ind0, allFaceVec[j].ind1, allFaceVec[j].ind2, materialID, i + 1, facet_count );
-
-                        // Split quad into two tris.  It may be possible to write out tris and quads separately by
-                        // grouping them appropriately and then writing separate groups.  However, without documentation
-                        // of the facet file format, this approach is the least risky.
-                        if( allFaceVec[j].m_isQuad )
-                        {
-                            facet_count++;
-                            fprintf( fp, "%d %d %d %d %u %d\n", allFaceVec[j].ind0, allFaceVec[j].ind2, allFaceVec[j].ind3, materialID, i + 1, facet_count );
-                        }
+                        buf.AppendInt( ind[k][0] );
+                        buf.Append( ' ' );
+                        buf.AppendInt( ind[k][1] );
+                        buf.Append( ' ' );
+                        buf.AppendInt( ind[k][2] );
+                        buf.Append( ' ' );
+                        buf.AppendInt( materialID );
+                        buf.Append( ' ' );
+                        buf.AppendInt( i + 1 );
+                        buf.Append( ' ' );
+                        buf.AppendInt( facet_count );
+                        buf.Append( '\n' );
                     }
                 }
             }
+
+            buf.Flush();
             fclose( fp );
         }
     }
@@ -73,6 +73,7 @@
 
 #include <cassert>
 
+#include <deque>
 #include <set>
 #include <map>
 #include <vector>
@@ -80,6 +81,36 @@
 #include <string>
 using namespace std;
 
+class ExportBuffer;
+
+//////////////////////////////////////////////////////////////////////
+// Merged point and face tables built once per export and shared by all of
+// the output formats.  Face node indices are 1-based into m_PntVec.  When
+// built with the wake split out, solid points and faces come first and the
+// wake points and faces follow.
+class CfdExportTables
+{
+public:
+    CfdExportTables()
+    {
+        m_NumTris = 0;
+        m_NumSolidPnts = 0;
+        m_NumSolidFaces = 0;
+    }
+
+    vector< vec3d > m_PntVec;
+    vector< int > m_PntID;                      // 1-based index of each used point before merging
+    vector< SimpFace > m_FaceVec;
+    vector< int > m_FaceTag;                    // SubSurfaceMgr tag of each face
+    vector< int > m_FacePart;
+    vector< vec2d > m_FaceUW;                   // Four per face, split tables only
+    vector < deque < pair < int, int > > > m_Wakes;
+
+    int m_NumTris;                              // Face count with quads split into two tris
+    int m_NumSolidPnts;
+    int m_NumSolidFaces;
+};
+
 //////////////////////////////////////////////////////////////////////
 class CfdMeshMgrSingleton : public SurfaceIntersectionSingleton
 {
@@ -149,13 +180,15 @@ public:
 
     void UpdateDisplaySettings() override;
 
+    virtual void BuildExportTables( CfdExportTables & tables, bool split_wake );
+
     virtual void WriteSTL( const string &filename );
-    virtual void WriteTaggedSTL( const string &filename );
-    virtual void WriteTetGen( const string &filename );
-    virtual void WriteNASCART_Obj_Tri_Gmsh( const string &dat_fn, const string &key_fn, const string &obj_fn, const string &tri_fn, const string &gmsh_fn, const string & vspgeom_fn );
-    virtual void WriteTagFiles( string file_name, const vector< SimpFace > &allFaceVec, bool allowquads );
-    virtual void WriteTagFile( FILE* file_id, int part, int tag, const vector< SimpFace > &allFaceVec, bool allowquads );
-    virtual void WriteFacet( const string &facet_fn );
+    virtual void WriteTaggedSTL( const string &filename, const CfdExportTables & tables );
+    virtual void WriteTetGen( const string &filename, const CfdExportTables & tables );
+    virtual void WriteNASCART_Obj_Tri_Gmsh( const string &dat_fn, const string &key_fn, const string &obj_fn, const string &tri_fn, const string &gmsh_fn, const string & vspgeom_fn, const CfdExportTables & tables );
+    virtual void WriteTagFiles( string file_name, const CfdExportTables & tables, bool allowquads );
+    virtual void WriteTagFile( FILE* file_id, const vector< int > & face_list, const CfdExportTables & tables, bool allowquads );
+    virtual void WriteFacet( const string &facet_fn, const CfdExportTables & tables );
 
     void ExportFiles() override;
     //virtual void CheckDupOrAdd( Node* node, vector< Node* > & nodeVec );
@@ -168,6 +201,9 @@ public:
 
     enum { QUIET_OUTPUT, VOCAL_OUTPUT, };
     virtual void Remesh( int output_type );
+    virtual bool FindRemeshCache( Surf* surf, const HalfEdgeMesh & hem, uint64_t & key, HalfEdgeMesh & result, int & num_rev_removed );
+
+    void ClearMeshCache() override;
 
     virtual void PostMesh();
 
@@ -241,6 +277,9 @@ protected:
     vector< IPnt* > m_DegenCorners;
     vector< ISegChain* > m_DegenCornerChains;
 
+    RemeshCache m_RemeshCache;                  // Final surface meshes from the previous Remesh()
+    RemeshCache m_NextRemeshCache;
+
 private:
     DrawObj m_MeshBadEdgeDO;
     DrawObj m_MeshBadTriDO;
@@ -109,7 +109,7 @@ public:
     Node* n1;
 
     // Split node along border.  These points should lie on both surfaces along an intersection
-    // curve.  Created in Mesh::InitMesh.  Used in Mesh::ConvertToQuads().  Manipulated in Mesh::CollapseEdge.
+    // curve.  Created in Mesh::InitMesh.  Used in Mesh::ConvertToQuads().  Manipulated in HalfEdgeMesh::CollapseEdge.
     Node* ns;
 
     Face* f0;
@@ -16,6 +16,7 @@
 #include "FeaMeshMgr.h"
 #include "StringUtil.h"
 #include "StlHelper.h"
+#include "ExportBuffer.h"
 
 using namespace StringUtil;
 
@@ -23,6 +24,16 @@ using namespace StringUtil;
 //==================== FeaNode =====================//
 //////////////////////////////////////////////////////
 
+// Append node indices with separator sep and optional field width.
+static void AppendNodeIndices( ExportBuffer & buf, const vector< FeaNode* > & nodes, long long int noffset, char sep, int width = 0 )
+{
+    for ( size_t i = 0; i < nodes.size(); i++ )
+    {
+        buf.Append( sep );
+        buf.AppendInt( nodes[ i ]->GetIndex() + noffset, width );
+    }
+}
+
 void FeaNode::AddTag( int index )
 {
     //==== Check For Duplicate Tags ====//
@@ -66,20 +77,27 @@ long long int FeaNode::GetIndex()
     return m_Index;
 }
 
-void FeaNode::WriteNASTRAN( FILE* fp, long long int noffset, bool includeBC )
+void FeaNode::WriteNASTRAN( ExportBuffer & buf, long long int noffset, bool includeBC )
 {
     double x = m_Pnt.x();
     double y = m_Pnt.y();
     double z = m_Pnt.z();
 
-    string bcstr;
+    // GRID    ,%8lld,        ,x,y,z,        ,%s
+    buf.Append( "GRID    ," );
+    buf.AppendInt( m_Index + noffset, 8 );
+    buf.Append( ",        ," );
+    buf.AppendDouble( x, NasFmt( x ) );
+    buf.Append( ',' );
+    buf.AppendDouble( y, NasFmt( y ) );
+    buf.Append( ',' );
+    buf.AppendDouble( z, NasFmt( z ) );
+    buf.Append( ",        ," );
     if ( includeBC )
     {
-        bcstr = m_BCs.AsNASTRAN();
+        buf.Append( m_BCs.AsNASTRAN() );
     }
-
-    string fmt = "GRID    ,%8lld,        ," + NasFmt( x ) + "," + NasFmt( y ) + "," + NasFmt( z ) + ",        ,%s\n";
-    fprintf( fp, fmt.c_str(), m_Index + noffset, x, y, z, bcstr.c_str() );
+    buf.Append( '\n' );
 }
 
 void FeaNode::WriteNASTRAN_SPC1( FILE* fp, long long int noffset )
@@ -92,21 +110,27 @@ void FeaNode::WriteNASTRAN_SPC1( FILE* fp, long long int noffset )
     }
 }
 
-void FeaNode::WriteCalculix( FILE* fp, long long int noffset )
+void FeaNode::WriteCalculix( ExportBuffer & buf, long long int noffset )
 {
-    if ( true )   // print 'just' nodes.
-    {
-        fprintf( fp, "%lld,%f,%f,%f\n", m_Index + noffset, m_Pnt.x(), m_Pnt.y(), m_Pnt.z() );
-    }
-    else          // also print node tags for debugging.
+    // "%lld,%f,%f,%f"
+    buf.AppendInt( m_Index + noffset );
+    buf.Append( ',' );
+    buf.AppendDouble( m_Pnt.x(), 'f', 6 );
+    buf.Append( ',' );
+    buf.AppendDouble( m_Pnt.y(), 'f', 6 );
+    buf.Append( ',' );
+    buf.AppendDouble( m_Pnt.z(), 'f', 6 );
+
+    if ( false )  // also print node tags for debugging.
     {
-        fprintf( fp, "%lld,%f,%f,%f  ** ", m_Index + noffset, m_Pnt.x(), m_Pnt.y(), m_Pnt.z() );
+        buf.Append( "  ** " );
         for ( int i = 0; i < m_Tags.size(); i++ )
         {
-            fprintf( fp, "%d ", m_Tags[ i ] );
+            buf.AppendInt( m_Tags[ i ] );
+            buf.Append( ' ' );
         }
-        fprintf( fp, "\n" );
     }
+    buf.Append( '\n' );
 }
 
 void FeaNode::WriteCalculixBCs( FILE* fp, long long int noffset )
@@ -123,9 +147,13 @@ void FeaNode::WriteCalculixBCs( FILE* fp, long long int noffset )
     }
 }
 
-void FeaNode::WriteGmsh( FILE* fp, long long int noffset )
+void FeaNode::WriteGmsh( ExportBuffer & buf, long long int noffset )
 {
-    fprintf( fp, "%lld %f %f %f\n", m_Index + noffset, m_Pnt.x(), m_Pnt.y(), m_Pnt.z() );
+    // "%lld %f %f %f"
+    buf.AppendInt( m_Index + noffset );
+    buf.Append( ' ' );
+    ExportUtil::AppendXYZ( buf, m_Pnt, 'f', 6 );
+    buf.Append( '\n' );
 }
 
 //////////////////////////////////////////////////////
@@ -199,22 +227,18 @@ void FeaTri::Create( vec3d & p0, vec3d & p1, vec3d & p2, bool highorder )
     }
 }
 
-void FeaTri::WriteCalculix( FILE* fp, int id, long long int noffset, long long int eoffset )
+void FeaTri::WriteCalculix( ExportBuffer & buf, int id, long long int noffset, long long int eoffset )
 {
-    if ( m_ElementType == FEA_TRI_3 )
-    {
-        fprintf( fp, "%lld,%lld,%lld,%lld\n", id + eoffset,
-                 m_Corners[0]->GetIndex() + noffset, m_Corners[1]->GetIndex() + noffset, m_Corners[2]->GetIndex() + noffset );
-    }
-    else
+    buf.AppendInt( id + eoffset );
+    AppendNodeIndices( buf, m_Corners, noffset, ',' );
+    if ( m_ElementType != FEA_TRI_3 )
     {
-        fprintf( fp, "%lld,%lld,%lld,%lld,%lld,%lld,%lld\n", id + eoffset,
-                 m_Corners[0]->GetIndex() + noffset, m_Corners[1]->GetIndex() + noffset, m_Corners[2]->GetIndex() + noffset,
-                 m_Mids[0]->GetIndex() + noffset, m_Mids[1]->GetIndex() + noffset, m_Mids[2]->GetIndex() + noffset );
+        AppendNodeIndices( buf, m_Mids, noffset, ',' );
     }
+    buf.Append( '\n' );
 }
 
-void FeaTri::WriteNASTRAN( FILE* fp, int id, int property_index, long long int noffset, long long int eoffset )
+void FeaTri::WriteNASTRAN( ExportBuffer & buf, int id, int property_index, long long int noffset, long long int eoffset )
 {
     vec3d v01 = m_Corners[1]->m_Pnt - m_Corners[0]->m_Pnt;
     vec3d v12 = m_Corners[2]->m_Pnt - m_Corners[1]->m_Pnt;
@@ -233,40 +257,52 @@ void FeaTri::WriteNASTRAN( FILE* fp, int id, int property_index, long long int n
 
     if ( m_ElementType == FEA_TRI_3 )
     {
-        string format_string = "CTRIA3  ,%8lld,%8lld,%8lld,%8lld,%8lld," + NasFmt( theta_material ) + "\n";
-
-        fprintf( fp, format_string.c_str(), id + eoffset, property_index + 1,
-                 m_Corners[0]->GetIndex() + noffset, m_Corners[1]->GetIndex() + noffset, m_Corners[2]->GetIndex() + noffset,
-                 theta_material );
+        buf.Append( "CTRIA3  ," );
     }
     else
     {
-        string format_string = "CTRIA6  ,%8lld,%8lld,%8lld,%8lld,%8lld,%8lld,%8lld,%8lld,\n        ," + NasFmt( theta_material ) + "\n";
+        buf.Append( "CTRIA6  ," );
+    }
 
-        fprintf( fp, format_string.c_str(), id + eoffset, property_index + 1,
-                 m_Corners[0]->GetIndex() + noffset, m_Corners[1]->GetIndex() + noffset, m_Corners[2]->GetIndex() + noffset,
-                 m_Mids[0]->GetIndex() + noffset, m_Mids[1]->GetIndex() + noffset, m_Mids[2]->GetIndex() + noffset, theta_material );
+    buf.AppendInt( id + eoffset, 8 );
+    buf.Append( ',' );
+    buf.AppendInt( property_index + 1, 8 );
+    AppendNodeIndices( buf, m_Corners, noffset, ',', 8 );
+
+    if ( m_ElementType != FEA_TRI_3 )
+    {
+        AppendNodeIndices( buf, m_Mids, noffset, ',', 8 );
+        buf.Append( ",\n        " );
     }
+
+    buf.Append( ',' );
+    buf.AppendDouble( theta_material, NasFmt( theta_material ) );
+    buf.Append( '\n' );
 }
 
-void FeaTri::WriteGmsh( FILE* fp, int id, int fea_part_index, long long int noffset, long long int eoffset )
+void FeaTri::WriteGmsh( ExportBuffer & buf, int id, int fea_part_index, long long int noffset, long long int eoffset )
 {
+    buf.AppendInt( id + eoffset );
     if ( m_ElementType == FEA_TRI_3 )
     {
         // 3-node triangle element type (2)
-        fprintf( fp, "%lld 2 1 %d %lld %lld %lld\n", id + eoffset, fea_part_index,
-                 m_Corners[0]->GetIndex() + noffset, m_Corners[1]->GetIndex() + noffset, m_Corners[2]->GetIndex() + noffset );
+        buf.Append( " 2 1 " );
     }
     else
     {
         // 6-node second order triangle element type (9)
-        fprintf( fp, "%lld 9 1 %d %lld %lld %lld %lld %lld %lld\n", id + eoffset, fea_part_index,
-                 m_Corners[0]->GetIndex() + noffset, m_Corners[1]->GetIndex() + noffset, m_Corners[2]->GetIndex() + noffset,
-                 m_Mids[0]->GetIndex() + noffset,m_Mids[1]->GetIndex() + noffset, m_Mids[2]->GetIndex() + noffset );
+        buf.Append( " 9 1 " );
     }
+    buf.AppendInt( fea_part_index );
+    AppendNodeIndices( buf, m_Corners, noffset, ' ' );
+    if ( m_ElementType != FEA_TRI_3 )
+    {
+        AppendNodeIndices( buf, m_Mids, noffset, ' ' );
+    }
+    buf.Append( '\n' );
 }
 
-void FeaTri::WriteSTL( FILE* fp )
+void FeaTri::WriteSTL( ExportBuffer & buf )
 {
     vec3d p0 = m_Corners[0]->m_Pnt;
     vec3d p1 = m_Corners[1]->m_Pnt;
@@ -276,15 +312,7 @@ void FeaTri::WriteSTL( FILE* fp )
     vec3d norm = cross( v01, v12 );
     norm.normalize();
 
-    fprintf( fp, " facet normal  %2.10le %2.10le %2.10le\n",  norm.x(), norm.y(), norm.z() );
-    fprintf( fp, "   outer loop\n" );
-
-    fprintf( fp, "     vertex %2.10le %2.10le %2.10le\n", p0.x(), p0.y(), p0.z() );
-    fprintf( fp, "     vertex %2.10le %2.10le %2.10le\n", p1.x(), p1.y(), p1.z() );
-    fprintf( fp, "     vertex %2.10le %2.10le %2.10le\n", p2.x(), p2.y(), p2.z() );
-
-    fprintf( fp, "   endloop\n" );
-    fprintf( fp, " endfacet\n" );
+    ExportUtil::AppendSTLFacet( buf, norm, p0, p1, p2 );
 }
 
 double FeaTri::ComputeMass( int property_index )
@@ -353,21 +381,17 @@ void FeaQuad::Create( vec3d & p0, vec3d & p1, vec3d & p2, vec3d & p3, bool higho
     }
 }
 
-void FeaQuad::WriteCalculix( FILE* fp, int id, long long int noffset, long long int eoffset )
+void FeaQuad::WriteCalculix( ExportBuffer & buf, int id, long long int noffset, long long int eoffset )
 {
-    if ( m_ElementType == FEA_QUAD_4 )
+    buf.AppendInt( id + eoffset );
+    AppendNodeIndices( buf, m_Corners, noffset, ',' );
+    if ( m_ElementType != FEA_QUAD_4 )
     {
-        fprintf( fp, "%lld,%lld,%lld,%lld,%lld\n", id + eoffset,
-                 m_Corners[0]->GetIndex() + noffset, m_Corners[1]->GetIndex() + noffset, m_Corners[2]->GetIndex() + noffset, m_Corners[3]->GetIndex() + noffset );
-    }
-    else
-    {
-        fprintf( fp, "%lld,%lld,%lld,%lld,%lld,%lld,%lld,%lld,%lld\n", id + eoffset,
-                 m_Corners[0]->GetIndex() + noffset, m_Corners[1]->GetIndex() + noffset, m_Corners[2]->GetIndex() + noffset, m_Corners[3]->GetIndex() + noffset,
-                 m_Mids[0]->GetIndex() + noffset, m_Mids[1]->GetIndex() + noffset, m_Mids[2]->GetIndex() + noffset, m_Mids[3]->GetIndex() + noffset );
+        AppendNodeIndices( buf, m_Mids, noffset, ',' );
     }
+    buf.Append( '\n' );
 }
-void FeaQuad::WriteNASTRAN( FILE* fp, int id, int property_index, long long int noffset, long long int eoffset )
+void FeaQuad::WriteNASTRAN( ExportBuffer & buf, int id, int property_index, long long int noffset, long long int eoffset )
 {
     vec3d v01 = m_Corners[1]->m_Pnt - m_Corners[0]->m_Pnt;
     vec3d v12 = m_Corners[2]->m_Pnt - m_Corners[1]->m_Pnt;
@@ -385,40 +409,57 @@ void FeaQuad::WriteNASTRAN( FILE* fp, int id, int property_index, long long int
 
     if ( m_ElementType == FEA_QUAD_4 )
     {
-        string format_string = "CQUAD4  ,%8lld,%8d,%8lld,%8lld,%8lld,%8lld," + NasFmt( theta_material ) + "\n";
-
-        fprintf( fp, format_string.c_str(), id + eoffset, property_index + 1,
-                 m_Corners[0]->GetIndex() + noffset, m_Corners[1]->GetIndex() + noffset, m_Corners[2]->GetIndex() + noffset, m_Corners[3]->GetIndex() + noffset, theta_material );
+        buf.Append( "CQUAD4  ," );
     }
     else
     {
-        string format_string = "CQUAD8  ,%8lld,%8d,%8lld,%8lld,%8lld,%8lld,%8lld,%8lld,\n        ,%8lld,%8lld,        ,        ,        ,        ," + NasFmt( theta_material ) + "\n";
+        buf.Append( "CQUAD8  ," );
+    }
 
-        fprintf( fp, format_string.c_str(), id + eoffset, property_index + 1,
-                 m_Corners[0]->GetIndex() + noffset, m_Corners[1]->GetIndex() + noffset, m_Corners[2]->GetIndex() + noffset, m_Corners[3]->GetIndex() + noffset,
-                 m_Mids[0]->GetIndex() + noffset, m_Mids[1]->GetIndex() + noffset, m_Mids[2]->GetIndex() + noffset, m_Mids[3]->GetIndex() + noffset, theta_material );
+    buf.AppendInt( id + eoffset, 8 );
+    buf.Append( ',' );
+    buf.AppendInt( property_index + 1, 8 );
+    AppendNodeIndices( buf, m_Corners, noffset, ',', 8 );
 
+    if ( m_ElementType != FEA_QUAD_4 )
+    {
+        // Two mid side nodes fit on the first line, the rest continue on the second.
+        for ( int i = 0; i < 4; i++ )
+        {
+            buf.Append( i == 2 ? ",\n        ," : "," );
+            buf.AppendInt( m_Mids[i]->GetIndex() + noffset, 8 );
+        }
+        buf.Append( ",        ,        ,        ,        " );
     }
+
+    buf.Append( ',' );
+    buf.AppendDouble( theta_material, NasFmt( theta_material ) );
+    buf.Append( '\n' );
 }
 
-void FeaQuad::WriteGmsh( FILE* fp, int id, int fea_part_index, long long int noffset, long long int eoffset )
+void FeaQuad::WriteGmsh( ExportBuffer & buf, int id, int fea_part_index, long long int noffset, long long int eoffset )
 {
+    buf.AppendInt( id + eoffset );
     if ( m_ElementType == FEA_QUAD_4 )
     {
         // 4-node quadrangle element type (3)
-        fprintf( fp, "%lld 3 1 %d %lld %lld %lld %lld\n", id + eoffset, fea_part_index,
-                 m_Corners[0]->GetIndex() + noffset, m_Corners[1]->GetIndex() + noffset, m_Corners[2]->GetIndex() + noffset, m_Corners[3]->GetIndex() + noffset );
+        buf.Append( " 3 1 " );
     }
     else
     {
         // 8-node second order quadrangle element type (16)
-        fprintf( fp, "%lld 16 1 %d %lld %lld %lld %lld %lld %lld %lld %lld\n", id + eoffset, fea_part_index,
-                 m_Corners[0]->GetIndex() + noffset, m_Corners[1]->GetIndex() + noffset, m_Corners[2]->GetIndex() + noffset, m_Corners[3]->GetIndex() + noffset,
-                 m_Mids[0]->GetIndex() + noffset, m_Mids[1]->GetIndex() + noffset, m_Mids[2]->GetIndex() + noffset, m_Mids[3]->GetIndex() + noffset );
+        buf.Append( " 16 1 " );
+    }
+    buf.AppendInt( fea_part_index );
+    AppendNodeIndices( buf, m_Corners, noffset, ' ' );
+    if ( m_ElementType != FEA_QUAD_4 )
+    {
+        AppendNodeIndices( buf, m_Mids, noffset, ' ' );
     }
+    buf.Append( '\n' );
 }
 
-void FeaQuad::WriteSTL( FILE* fp )
+void FeaQuad::WriteSTL( ExportBuffer & buf )
 {
     vec3d p0 = m_Corners[0]->m_Pnt;
     vec3d p1 = m_Corners[1]->m_Pnt;
@@ -428,15 +469,7 @@ void FeaQuad::WriteSTL( FILE* fp )
     vec3d norm = cross( v01, v12 );
     norm.normalize();
 
-    fprintf( fp, " facet normal  %2.10le %2.10le %2.10le\n",  norm.x(), norm.y(), norm.z() );
-    fprintf( fp, "   outer loop\n" );
-
-    fprintf( fp, "     vertex %2.10le %2.10le %2.10le\n", p0.x(), p0.y(), p0.z() );
-    fprintf( fp, "     vertex %2.10le %2.10le %2.10le\n", p1.x(), p1.y(), p1.z() );
-    fprintf( fp, "     vertex %2.10le %2.10le %2.10le\n", p2.x(), p2.y(), p2.z() );
-
-    fprintf( fp, "   endloop\n" );
-    fprintf( fp, " endfacet\n" );
+    ExportUtil::AppendSTLFacet( buf, norm, p0, p1, p2 );
 
     vec3d p3 = m_Corners[3]->m_Pnt;
     vec3d v23 = p3 - p2;
@@ -444,15 +477,7 @@ void FeaQuad::WriteSTL( FILE* fp )
     norm = cross( v23, v30 );
     norm.normalize();
 
-    fprintf( fp, " facet normal  %2.10le %2.10le %2.10le\n",  norm.x(), norm.y(), norm.z() );
-    fprintf( fp, "   outer loop\n" );
-
-    fprintf( fp, "     vertex %2.10le %2.10le %2.10le\n", p0.x(), p0.y(), p0.z() );
-    fprintf( fp, "     vertex %2.10le %2.10le %2.10le\n", p2.x(), p2.y(), p2.z() );
-    fprintf( fp, "     vertex %2.10le %2.10le %2.10le\n", p3.x(), p3.y(), p3.z() );
-
-    fprintf( fp, "   endloop\n" );
-    fprintf( fp, " endfacet\n" );
+    ExportUtil::AppendSTLFacet( buf, norm, p0, p2, p3 );
 }
 
 double FeaQuad::ComputeMass( int property_index )
@@ -511,22 +536,41 @@ void FeaBeam::Create( vec3d &p0, vec3d &p1, vec3d &norm0, vec3d &norm1 )
     m_Norm1 = norm1;
 }
 
-void FeaBeam::WriteCalculix( FILE* fp, int id, long long int noffset, long long int eoffset )
+void FeaBeam::WriteCalculix( ExportBuffer & buf, int id, long long int noffset, long long int eoffset )
 {
-    fprintf( fp, "%lld,%lld,%lld,%lld\n", id + eoffset,
-             m_Corners[0]->GetIndex() + noffset, m_Mids[0]->GetIndex() + noffset, m_Corners[1]->GetIndex() + noffset );
+    buf.AppendInt( id + eoffset );
+    buf.Append( ',' );
+    buf.AppendInt( m_Corners[0]->GetIndex() + noffset );
+    buf.Append( ',' );
+    buf.AppendInt( m_Mids[0]->GetIndex() + noffset );
+    buf.Append( ',' );
+    buf.AppendInt( m_Corners[1]->GetIndex() + noffset );
+    buf.Append( '\n' );
 
     m_ElementIndex = id; // Save element index 
 }
 
-void FeaBeam::WriteCalculixNormal( FILE* fp, long long int noffset, long long int eoffset )
+void FeaBeam::WriteCalculixNormal( ExportBuffer & buf, long long int noffset, long long int eoffset )
 {
     vec3d norm = ( m_Norm0 + m_Norm1 ) * 0.5;
     norm.normalize();
 
-    fprintf( fp, "%lld,%lld,%f,%f,%f\n", m_ElementIndex + eoffset, m_Corners[0]->GetIndex() + noffset, m_Norm0.x(), m_Norm0.y(), m_Norm0.z() );
-    fprintf( fp, "%lld,%lld,%f,%f,%f\n", m_ElementIndex + eoffset, m_Mids[0]->GetIndex() + noffset, norm.x(), norm.y(), norm.z() );
-    fprintf( fp, "%lld,%lld,%f,%f,%f\n", m_ElementIndex + eoffset, m_Corners[1]->GetIndex() + noffset, m_Norm1.x(), m_Norm1.y(), m_Norm1.z() );
+    FeaNode* nodes[3] = { m_Corners[0], m_Mids[0], m_Corners[1] };
+    vec3d norms[3] = { m_Norm0, norm, m_Norm1 };
+
+    for ( int i = 0; i < 3; i++ )
+    {
+        // "%lld,%lld,%f,%f,%f"
+        buf.AppendInt( m_ElementIndex + eoffset );
+        buf.Append( ',' );
+        buf.AppendInt( nodes[i]->GetIndex() + noffset );
+        for ( int k = 0; k < 3; k++ )
+        {
+            buf.Append( ',' );
+            buf.AppendDouble( norms[i][k], 'f', 6 );
+        }
+        buf.Append( '\n' );
+    }
 }
 
 void FeaBeam::WriteCalculixNormal( FILE* fp )
@@ -534,20 +578,32 @@ void FeaBeam::WriteCalculixNormal( FILE* fp )
     fprintf( fp, "%f,%f,%f\n", m_Norm0.x(), m_Norm0.y(), m_Norm0.z() );
 }
 
-void FeaBeam::WriteNASTRAN( FILE* fp, int id, int property_index, long long int noffset, long long int eoffset )
+void FeaBeam::WriteNASTRAN( ExportBuffer & buf, int id, int property_index, long long int noffset, long long int eoffset )
 {
-    string format_string = "CBAR    ,%8lld,%8d,%8lld,%8lld," + NasFmt( m_Norm0.x() ) + "," +
-                           NasFmt( m_Norm0.y() ) + "," + NasFmt( m_Norm0.z() ) + "\n";
-
-    fprintf( fp, format_string.c_str(), id + eoffset, property_index + 1, m_Corners[0]->GetIndex() + noffset,
-             m_Corners[1]->GetIndex() + noffset, m_Norm0.x(), m_Norm0.y(), m_Norm0.z() );
+    buf.Append( "CBAR    ," );
+    buf.AppendInt( id + eoffset, 8 );
+    buf.Append( ',' );
+    buf.AppendInt( property_index + 1, 8 );
+    buf.Append( ',' );
+    buf.AppendInt( m_Corners[0]->GetIndex() + noffset, 8 );
+    buf.Append( ',' );
+    buf.AppendInt( m_Corners[1]->GetIndex() + noffset, 8 );
+    for ( int k = 0; k < 3; k++ )
+    {
+        buf.Append( ',' );
+        buf.AppendDouble( m_Norm0[k], NasFmt( m_Norm0[k] ) );
+    }
+    buf.Append( '\n' );
 }
 
-void FeaBeam::WriteGmsh( FILE* fp, int id, int fea_part_index, long long int noffset, long long int eoffset )
+void FeaBeam::WriteGmsh( ExportBuffer & buf, int id, int fea_part_index, long long int noffset, long long int eoffset )
 {
     // 2 node line line (1)
-    fprintf( fp, "%lld 1 1 %d %lld %lld\n", id + eoffset, fea_part_index,
-             m_Corners[0]->GetIndex() + noffset, m_Corners[1]->GetIndex() + noffset );
+    buf.AppendInt( id + eoffset );
+    buf.Append( " 1 1 " );
+    buf.AppendInt( fea_part_index );
+    AppendNodeIndices( buf, m_Corners, noffset, ' ' );
+    buf.Append( '\n' );
 }
 
 double FeaBeam::ComputeMass( int property_index )
@@ -601,17 +657,22 @@ void FeaPointMass::Create( vec3d & p0, double mass )
     m_Mass = mass;
 }
 
-void FeaPointMass::WriteCalculix( FILE* fp, int id, long long int noffset, long long int eoffset )
+void FeaPointMass::WriteCalculix( ExportBuffer & buf, int id, long long int noffset, long long int eoffset )
 {
-    fprintf( fp, "%lld,%lld\n", id + eoffset, m_Corners[0]->GetIndex() + noffset );
+    buf.AppendInt( id + eoffset );
+    AppendNodeIndices( buf, m_Corners, noffset, ',' );
+    buf.Append( '\n' );
 }
 
-void FeaPointMass::WriteNASTRAN( FILE* fp, int id, int property_index, long long int noffset, long long int eoffset )
+void FeaPointMass::WriteNASTRAN( ExportBuffer & buf, int id, int property_index, long long int noffset, long long int eoffset )
 {
     // Note: property_index ignored
-    string format_string = "CONM2   ,%8lld,%8lld,        ," + NasFmt( m_Mass ) + "\n";
-
-    fprintf( fp, format_string.c_str(), id + eoffset, m_Corners[0]->GetIndex() + noffset, m_Mass );
+    buf.Append( "CONM2   ," );
+    buf.AppendInt( id + eoffset, 8 );
+    AppendNodeIndices( buf, m_Corners, noffset, ',', 8 );
+    buf.Append( ",        ," );
+    buf.AppendDouble( m_Mass, NasFmt( m_Mass ) );
+    buf.Append( '\n' );
 }
 
 //////////////////////////////////////////////////////
@@ -19,6 +19,8 @@
 #include "FeaStructure.h"
 #include "BitMask.h"
 
+class ExportBuffer;
+
 using namespace std;
 
 class FeaNode
@@ -49,11 +51,11 @@ public:
     bool HasOnlyTag( int ind );
     vector< int > m_Tags;
 
-    void WriteNASTRAN( FILE* fp, long long int noffset, bool includeBC = false );
+    void WriteNASTRAN( ExportBuffer & buf, long long int noffset, bool includeBC = false );
     void WriteNASTRAN_SPC1( FILE* fp, long long int noffset );
-    void WriteCalculix( FILE* fp, long long int noffset );
+    void WriteCalculix( ExportBuffer & buf, long long int noffset );
     void WriteCalculixBCs( FILE* fp, long long int noffset );
-    void WriteGmsh( FILE* fp, long long int noffset );
+    void WriteGmsh( ExportBuffer & buf, long long int noffset );
 };
 
 class FeaElement
@@ -102,10 +104,10 @@ public:
         return m_ChainIndex;
     }
 
-    virtual void WriteCalculix( FILE* fp, int id, long long int noffset, long long int eoffset ) = 0;
-    virtual void WriteNASTRAN( FILE* fp, int id, int property_index, long long int noffset, long long int eoffset ) = 0;
-    virtual void WriteGmsh( FILE* fp, int id, int fea_part_index, long long int noffset, long long int eoffset ) = 0;
-    virtual void WriteSTL( FILE* fp ) = 0;
+    virtual void WriteCalculix( ExportBuffer & buf, int id, long long int noffset, long long int eoffset ) = 0;
+    virtual void WriteNASTRAN( ExportBuffer & buf, int id, int property_index, long long int noffset, long long int eoffset ) = 0;
+    virtual void WriteGmsh( ExportBuffer & buf, int id, int fea_part_index, long long int noffset, long long int eoffset ) = 0;
+    virtual void WriteSTL( ExportBuffer & buf ) = 0;
     virtual double ComputeMass( int property_index ) = 0;
 
     virtual int GetFeaSSIndex()
@@ -143,10 +145,10 @@ public:
     virtual ~FeaTri()    {};
 
     virtual void Create( vec3d & p0, vec3d & p1, vec3d & p2, bool highorder );
-    virtual void WriteCalculix( FILE* fp, int id, long long int noffset, long long int eoffset );
-    virtual void WriteNASTRAN( FILE* fp, int id, int property_index, long long int noffset, long long int eoffset );
-    virtual void WriteGmsh( FILE* fp, int id, int fea_part_index, long long int noffset, long long int eoffset );
-    virtual void WriteSTL( FILE* fp );
+    virtual void WriteCalculix( ExportBuffer & buf, int id, long long int noffset, long long int eoffset );
+    virtual void WriteNASTRAN( ExportBuffer & buf, int id, int property_index, long long int noffset, long long int eoffset );
+    virtual void WriteGmsh( ExportBuffer & buf, int id, int fea_part_index, long long int noffset, long long int eoffset );
+    virtual void WriteSTL( ExportBuffer & buf );
     virtual double ComputeMass( int property_index );
 };
 
@@ -158,10 +160,10 @@ public:
     virtual ~FeaQuad()    {};
 
     virtual void Create( vec3d & p0, vec3d & p1, vec3d & p2, vec3d & p3, bool highorder );
-    virtual void WriteCalculix( FILE* fp, int id, long long int noffset, long long int eoffset );
-    virtual void WriteNASTRAN( FILE* fp, int id, int property_index, long long int noffset, long long int eoffset );
-    virtual void WriteGmsh( FILE* fp, int id, int fea_part_index, long long int noffset, long long int eoffset );
-    virtual void WriteSTL( FILE* fp );
+    virtual void WriteCalculix( ExportBuffer & buf, int id, long long int noffset, long long int eoffset );
+    virtual void WriteNASTRAN( ExportBuffer & buf, int id, int property_index, long long int noffset, long long int eoffset );
+    virtual void WriteGmsh( ExportBuffer & buf, int id, int fea_part_index, long long int noffset, long long int eoffset );
+    virtual void WriteSTL( ExportBuffer & buf );
     virtual double ComputeMass( int property_index );
 };
 
@@ -173,12 +175,12 @@ public:
     virtual ~FeaBeam()    {};
 
     virtual void Create( vec3d &p0, vec3d &p1, vec3d &norm0, vec3d &norm1 );
-    virtual void WriteCalculix( FILE* fp, int id, long long int noffset, long long int eoffset );
-    virtual void WriteCalculixNormal( FILE* fp, long long int noffset, long long int eoffset );
+    virtual void WriteCalculix( ExportBuffer & buf, int id, long long int noffset, long long int eoffset );
+    virtual void WriteCalculixNormal( ExportBuffer & buf, long long int noffset, long long int eoffset );
     virtual void WriteCalculixNormal( FILE* fp );
-    virtual void WriteNASTRAN( FILE* fp, int id, int property_index, long long int noffset, long long int eoffset );
-    virtual void WriteGmsh( FILE* fp, int id, int fea_part_index, long long int noffset, long long int eoffset );
-    virtual void WriteSTL( FILE* fp ) {};
+    virtual void WriteNASTRAN( ExportBuffer & buf, int id, int property_index, long long int noffset, long long int eoffset );
+    virtual void WriteGmsh( ExportBuffer & buf, int id, int fea_part_index, long long int noffset, long long int eoffset );
+    virtual void WriteSTL( ExportBuffer & buf ) {};
     virtual double ComputeMass( int property_index );
 
     vec3d m_Norm0; // Vector from end point in the displacement coordinate system at the end point
@@ -197,10 +199,10 @@ public:
     virtual ~FeaPointMass()    {};
 
     virtual void Create( vec3d & p0, double mass );
-    virtual void WriteCalculix( FILE* fp, int id, long long int noffset, long long int eoffset );
-    virtual void WriteNASTRAN( FILE* fp, int id, int property_index, long long int noffset, long long int eoffset );
-    virtual void WriteGmsh( FILE* fp, int id, int fea_part_index, long long int noffset, long long int eoffset )    {};
-    virtual void WriteSTL( FILE* fp ) {};
+    virtual void WriteCalculix( ExportBuffer & buf, int id, long long int noffset, long long int eoffset );
+    virtual void WriteNASTRAN( ExportBuffer & buf, int id, int property_index, long long int noffset, long long int eoffset );
+    virtual void WriteGmsh( ExportBuffer & buf, int id, int fea_part_index, long long int noffset, long long int eoffset )    {};
+    virtual void WriteSTL( ExportBuffer & buf ) {};
     virtual double ComputeMass( int property_index )
     {
         return m_Mass;
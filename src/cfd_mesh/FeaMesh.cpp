@@ -8,6 +8,10 @@
 #include "FeaMeshMgr.h"
 #include "FileUtil.h"
 #include "StringUtil.h"
+#include "ExportBuffer.h"
+
+#include <algorithm>
+#include <functional>
 
 // Although this appears to be an angle comparison (via the dot product), it is actually the signed distance
 // between the point and the plane.  Hence, a comparison to the mesh minimum length as a tolerance is appropriate.
@@ -71,6 +75,7 @@ FeaMesh::FeaMesh( const string & struct_id )
 
     m_MeshDOUpToDate = false;
     m_MeshReady = false;
+    m_ExportTablesValid = false;
 }
 
 FeaMesh::~FeaMesh()
@@ -105,6 +110,13 @@ void FeaMesh::Cleanup()
 
     m_FeaNodeVecUsed.clear();
 
+    m_ExportTablesValid = false;
+    m_ExportTagNodeVec.clear();
+    m_ExportUntaggedNodeVec.clear();
+    m_ExportBCNodeVec.clear();
+    m_ExportPartElemVec.clear();
+    m_ExportOwnerElemVec.clear();
+
     m_StructName = "";
 
     m_TotalMass = 0;
@@ -1039,12 +1051,122 @@ void FeaMesh::WriteNASTRANHeader( FILE* dat_fp )
     }
 }
 
+void FeaMesh::BuildExportTables()
+{
+    int ntag = m_NumFeaParts + m_NumFeaSubSurfs;
+
+    m_ExportTagNodeVec.assign( ntag, vector < int > () );
+    m_ExportUntaggedNodeVec.clear();
+    m_ExportBCNodeVec.clear();
+
+    for ( int j = 0; j < (int)m_FeaNodeVec.size(); j++ )
+    {
+        if ( m_FeaNodeVecUsed[ j ] )
+        {
+            FeaNode* node = m_FeaNodeVec[ j ];
+
+            if ( node->m_Tags.size() == 0 )
+            {
+                m_ExportUntaggedNodeVec.push_back( j );
+            }
+            else if ( node->HasOnlyTag( node->m_Tags[ 0 ] ) )
+            {
+                int tag = node->m_Tags[ 0 ];
+                if ( tag >= 0 && tag < ntag )
+                {
+                    m_ExportTagNodeVec[ tag ].push_back( j );
+                }
+            }
+
+            if ( node->m_BCs.AsNum() > 0 )
+            {
+                m_ExportBCNodeVec.push_back( j );
+            }
+        }
+    }
+
+    m_ExportPartElemVec.assign( m_NumFeaParts, vector < int > () );
+    m_ExportOwnerElemVec.assign( ntag, vector < int > () );
+
+    for ( int j = 0; j < (int)m_FeaElementVec.size(); j++ )
+    {
+        int ipart = m_FeaElementVec[ j ]->GetFeaPartIndex();
+        int iss = m_FeaElementVec[ j ]->GetFeaSSIndex();
+
+        if ( ipart >= 0 && ipart < m_NumFeaParts )
+        {
+            m_ExportPartElemVec[ ipart ].push_back( j );
+        }
+
+        if ( iss >= 0 )
+        {
+            if ( iss < m_NumFeaSubSurfs )
+            {
+                m_ExportOwnerElemVec[ m_NumFeaParts + iss ].push_back( j );
+            }
+        }
+        else if ( ipart >= 0 && ipart < m_NumFeaParts )
+        {
+            m_ExportOwnerElemVec[ ipart ].push_back( j );
+        }
+    }
+
+    m_ExportTablesValid = true;
+}
+
+vector < int > FeaMesh::GetExportTagNodes( int tag )
+{
+    UpdateExportTables();
+
+    // HasOnlyTag() is also true for untagged nodes, merge them in to keep node order.
+    vector < int > node_vec;
+    if ( tag >= 0 && tag < (int)m_ExportTagNodeVec.size() )
+    {
+        node_vec.resize( m_ExportTagNodeVec[ tag ].size() + m_ExportUntaggedNodeVec.size() );
+        std::merge( m_ExportTagNodeVec[ tag ].begin(), m_ExportTagNodeVec[ tag ].end(),
+                    m_ExportUntaggedNodeVec.begin(), m_ExportUntaggedNodeVec.end(), node_vec.begin() );
+    }
+    else
+    {
+        node_vec = m_ExportUntaggedNodeVec;
+    }
+
+    // Skip fixed points, they are written separately.
+    vector < int > result;
+    result.reserve( node_vec.size() );
+    for ( int k = 0; k < (int)node_vec.size(); k++ )
+    {
+        if ( m_FeaNodeVec[ node_vec[ k ] ]->m_Index > m_FixPtOffset )
+        {
+            result.push_back( node_vec[ k ] );
+        }
+    }
+    return result;
+}
+
+// Subset of index_vec for which keep( element ) is true.
+static vector < int > FilterElements( const vector < FeaElement* > & elem_vec, const vector < int > & index_vec, const std::function < bool( FeaElement* ) > & keep )
+{
+    vector < int > result;
+    for ( int k = 0; k < (int)index_vec.size(); k++ )
+    {
+        if ( keep( elem_vec[ index_vec[ k ] ] ) )
+        {
+            result.push_back( index_vec[ k ] );
+        }
+    }
+    return result;
+}
+
 void FeaMesh::WriteNASTRANNodes( FILE* dat_fp, FILE* bdf_fp, FILE* nkey_fp, int &set_cnt )
 {
     unsigned long long int noffset = m_StructSettings.m_NodeOffset;
 
     if ( dat_fp && bdf_fp )
     {
+        UpdateExportTables();
+
+        ExportBuffer buf( bdf_fp );
         vector < long long int > node_id_vec;
         string name;
 
@@ -1055,15 +1177,15 @@ void FeaMesh::WriteNASTRANNodes( FILE* dat_fp, FILE* bdf_fp, FILE* nkey_fp, int
 
             FixPoint fxpt = m_FixPntVec[i];
 
-            fprintf( bdf_fp, "\n" );
-            fprintf( bdf_fp, "$ %s %s Fixed Gridpoints\n", m_FeaPartNameVec[ fxpt.m_FeaPartIndex ].c_str(), m_StructName.c_str() );
+            buf.Append( "\n" );
+            buf.Printf( "$ %s %s Fixed Gridpoints\n", m_FeaPartNameVec[ fxpt.m_FeaPartIndex ].c_str(), m_StructName.c_str() );
 
             for ( unsigned int j = 0; j < (int)fxpt.m_Pnt.size(); j++ )
             {
                 if ( fxpt.m_NodeIndex[j] >= 0 )
                 {
                     string fmt = "GRID    ,%8lld,        ," + StringUtil::NasFmt( fxpt.m_Pnt[j][0] ) + "," + StringUtil::NasFmt( fxpt.m_Pnt[j][1] ) + "," + StringUtil::NasFmt( fxpt.m_Pnt[j][2] ) + ",        ,%s\n";
-                    fprintf( bdf_fp, fmt.c_str(), fxpt.m_NodeIndex[j] + noffset, fxpt.m_Pnt[j][0], fxpt.m_Pnt[j][1], fxpt.m_Pnt[j][2], "" );
+                    buf.Printf( fmt.c_str(), fxpt.m_NodeIndex[j] + noffset, fxpt.m_Pnt[j][0], fxpt.m_Pnt[j][1], fxpt.m_Pnt[j][2], "" );
 
                     node_id_vec.push_back( fxpt.m_NodeIndex[j] );
                 }
@@ -1087,14 +1209,14 @@ void FeaMesh::WriteNASTRANNodes( FILE* dat_fp, FILE* bdf_fp, FILE* nkey_fp, int
                 {
                     if ( fxpt.m_NodeIndex[ j ] >= 0 )
                     {
-                        fprintf( bdf_fp, "\n" );
-                        fprintf( bdf_fp, "$ Node %d spider points\n", (int) ( fxpt.m_NodeIndex[ j ] + noffset ) );
+                        buf.Append( "\n" );
+                        buf.Printf( "$ Node %d spider points\n", (int) ( fxpt.m_NodeIndex[ j ] + noffset ) );
 
                         for ( int ispider = 0; ispider < fxpt.m_SpiderIndex[ j ].size(); ispider++ )
                         {
                             int spider_ind = (int) fxpt.m_SpiderIndex[ j ][ ispider ];
 
-                            m_FeaNodeVec[ spider_ind ]->WriteNASTRAN( bdf_fp, noffset );
+                            m_FeaNodeVec[ spider_ind ]->WriteNASTRAN( buf, noffset );
                             node_id_vec.push_back( m_FeaNodeVec[ spider_ind ]->m_Index );
                         }
 
@@ -1111,29 +1233,17 @@ void FeaMesh::WriteNASTRANNodes( FILE* dat_fp, FILE* bdf_fp, FILE* nkey_fp, int
         {
             node_id_vec.clear();
 
-            bool partheader = false;
-
             if ( m_FeaPartTypeVec[i] != vsp::FEA_FIX_POINT )
             {
-                for ( unsigned int j = 0; j < (int)m_FeaNodeVec.size(); j++ )
-                {
-                    if ( m_FeaNodeVecUsed[ j ] && m_FeaNodeVec[ j ]->m_Index > m_FixPtOffset )
-                    {
-                        if ( m_FeaNodeVec[ j ]->HasOnlyTag( i ) )
-                        {
-                            if ( !partheader )
-                            {
-                                partheader = true;
+                vector < int > part_nodes = GetExportTagNodes( i );
 
-                                fprintf( bdf_fp, "\n" );
-                                fprintf( bdf_fp, "$ %s %s Gridpoints\n", m_FeaPartNameVec[i].c_str(), m_StructName.c_str() );
-                            }
-
-                            m_FeaNodeVec[j]->WriteNASTRAN( bdf_fp, noffset );
-                            node_id_vec.push_back( m_FeaNodeVec[j]->m_Index );
-                        }
-                    }
+                if ( part_nodes.size() > 0 )
+                {
+                    buf.Append( "\n" );
+                    buf.Printf( "$ %s %s Gridpoints\n", m_FeaPartNameVec[i].c_str(), m_StructName.c_str() );
                 }
+
+                WriteNASTRANNodeList( buf, part_nodes, node_id_vec );
             }
 
             // Write FEA part node set
@@ -1144,29 +1254,18 @@ void FeaMesh::WriteNASTRANNodes( FILE* dat_fp, FILE* bdf_fp, FILE* nkey_fp, int
         // SubSurface Nodes
         for ( unsigned int i = 0; i < m_NumFeaSubSurfs; i++ )
         {
-            bool ssheader = false;
-
             node_id_vec.clear();
 
-            for ( unsigned int j = 0; j < (int)m_FeaNodeVec.size(); j++ )
-            {
-                if ( m_FeaNodeVecUsed[ j ] && m_FeaNodeVec[ j ]->m_Index > m_FixPtOffset )
-                {
-                    if ( m_FeaNodeVec[ j ]->HasOnlyTag( i + m_NumFeaParts ) )
-                    {
-                        if ( !ssheader )
-                        {
-                            ssheader = true;
+            vector < int > ss_nodes = GetExportTagNodes( i + m_NumFeaParts );
 
-                            fprintf( bdf_fp, "\n" );
-                            fprintf( bdf_fp, "$ %s %s Gridpoints\n", m_SimpleSubSurfaceVec[i].GetName().c_str(), m_StructName.c_str() );
-                        }
-                        m_FeaNodeVec[j]->WriteNASTRAN( bdf_fp, noffset );
-                        node_id_vec.push_back( m_FeaNodeVec[j]->m_Index );
-                    }
-                }
+            if ( ss_nodes.size() > 0 )
+            {
+                buf.Append( "\n" );
+                buf.Printf( "$ %s %s Gridpoints\n", m_SimpleSubSurfaceVec[i].GetName().c_str(), m_StructName.c_str() );
             }
 
+            WriteNASTRANNodeList( buf, ss_nodes, node_id_vec );
+
             // Write subsurface node set
             name = m_SimpleSubSurfaceVec[i].GetName() + "_" + m_StructName + "_Gridpoints";
             WriteNASTRANSet( dat_fp, nkey_fp, set_cnt, node_id_vec, name, noffset );
@@ -1175,25 +1274,26 @@ void FeaMesh::WriteNASTRANNodes( FILE* dat_fp, FILE* bdf_fp, FILE* nkey_fp, int
         node_id_vec.clear();
 
         // Intersection Nodes
-        bool IntersectHeader = false;
+        vector < int > intersect_nodes;
         for ( unsigned int j = 0; j < (int)m_FeaNodeVec.size(); j++ )
         {
             if ( m_FeaNodeVecUsed[ j ] && m_FeaNodeVec[ j ]->m_Index > m_FixPtOffset )
             {
                 if ( m_FeaNodeVec[j]->m_Tags.size() > 1 && !m_FeaNodeVec[j]->m_FixedPointFlag )
                 {
-                    if ( !IntersectHeader )
-                    {
-                        fprintf( bdf_fp, "\n" );
-                        fprintf( bdf_fp, "$ %s Intersections\n", m_StructName.c_str() );
-                        IntersectHeader = true;
-                    }
-                    m_FeaNodeVec[j]->WriteNASTRAN( bdf_fp, noffset );
-                    node_id_vec.push_back( m_FeaNodeVec[j]->m_Index );
+                    intersect_nodes.push_back( j );
                 }
             }
         }
 
+        if ( intersect_nodes.size() > 0 )
+        {
+            buf.Append( "\n" );
+            buf.Printf( "$ %s Intersections\n", m_StructName.c_str() );
+        }
+
+        WriteNASTRANNodeList( buf, intersect_nodes, node_id_vec );
+
         // Write intersection node set
         name = m_StructName + "_Intersection_Gridpoints";
         WriteNASTRANSet( dat_fp, nkey_fp, set_cnt, node_id_vec, name, noffset );
@@ -1201,22 +1301,25 @@ void FeaMesh::WriteNASTRANNodes( FILE* dat_fp, FILE* bdf_fp, FILE* nkey_fp, int
         node_id_vec.clear();
 
         //==== Remaining Nodes ====//
-        bool RemainingHeader = false;
-        for ( int i = 0; i < (int)m_FeaNodeVec.size(); i++ )
+        vector < int > remain_nodes = GetExportTagNodes( -1 );
+
+        if ( remain_nodes.size() > 0 )
         {
-            node_id_vec.clear();
+            buf.Append( "\n" );
+            buf.Printf( "$ %s Remainingnodes\n", m_StructName.c_str() );
+        }
 
-            if ( m_FeaNodeVecUsed[ i ] && m_FeaNodeVec[i]->m_Tags.size() == 0 && m_FeaNodeVec[ i ]->m_Index > m_FixPtOffset )
-            {
-                if ( !RemainingHeader )
-                {
-                    fprintf( bdf_fp, "\n" );
-                    fprintf( bdf_fp, "$ %s Remainingnodes\n", m_StructName.c_str() );
-                    RemainingHeader = true;
-                }
-                m_FeaNodeVec[i]->WriteNASTRAN( bdf_fp, noffset );
-                node_id_vec.push_back( m_FeaNodeVec[i]->m_Index );
-            }
+        WriteNASTRANNodeList( buf, remain_nodes, node_id_vec );
+
+        // The remaining node set is only written when the last node of the
+        // mesh is a remaining node, and then holds just that node.
+        if ( remain_nodes.size() > 0 && remain_nodes.back() == (int)m_FeaNodeVec.size() - 1 )
+        {
+            node_id_vec.erase( node_id_vec.begin(), node_id_vec.end() - 1 );
+        }
+        else
+        {
+            node_id_vec.clear();
         }
 
         // Write remaining node set
@@ -1225,36 +1328,51 @@ void FeaMesh::WriteNASTRANNodes( FILE* dat_fp, FILE* bdf_fp, FILE* nkey_fp, int
     }
 }
 
+void FeaMesh::WriteNASTRANNodeList( ExportBuffer & buf, const vector < int > & node_index_vec, vector < long long int > & node_id_vec )
+{
+    unsigned long long int noffset = m_StructSettings.m_NodeOffset;
+
+    ExportUtil::ParallelAppend( buf, (int)node_index_vec.size(), [&]( ExportBuffer & b, int k )
+    {
+        m_FeaNodeVec[ node_index_vec[ k ] ]->WriteNASTRAN( b, noffset );
+    } );
+
+    for ( int k = 0; k < (int)node_index_vec.size(); k++ )
+    {
+        node_id_vec.push_back( m_FeaNodeVec[ node_index_vec[ k ] ]->m_Index );
+    }
+}
+
 void FeaMesh::WriteNASTRANSPC1( FILE *bdf_fp )
 {
     unsigned long long int noffset = m_StructSettings.m_NodeOffset;
 
     if ( bdf_fp )
     {
+        UpdateExportTables();
+
+        // Only nodes with boundary conditions write SPC1 cards.
+        const vector < int > & bc_nodes = m_ExportBCNodeVec;
+
         for ( unsigned int i = 0; i < m_NumFeaParts; i++ )
         {
             bool FPHeader = false;
 
             if ( m_FeaPartTypeVec[i] == vsp::FEA_FIX_POINT ) // FixedPoint Nodes
             {
-                for ( unsigned int j = 0; j < (int)m_FeaNodeVec.size(); j++ )
+                for ( int k = 0; k < (int)bc_nodes.size(); k++ )
                 {
-                    if ( m_FeaNodeVecUsed[ j ] )
+                    int j = bc_nodes[ k ];
+                    if ( m_FeaNodeVec[j]->m_Tags.size() > 0 && m_FeaNodeVec[j]->m_FixedPointFlag && m_FeaNodeVec[j]->HasTag( i ) )
                     {
-                        if ( m_FeaNodeVec[j]->m_Tags.size() > 0 && m_FeaNodeVec[j]->m_FixedPointFlag && m_FeaNodeVec[j]->HasTag( i ) )
+                        if ( !FPHeader )
                         {
-                            if ( m_FeaNodeVec[ j ]->m_BCs.AsNum() > 0 )
-                            {
-                                if ( !FPHeader )
-                                {
-                                    FPHeader = true;
+                            FPHeader = true;
 
-                                    fprintf( bdf_fp, "\n" );
-                                    fprintf( bdf_fp, "$ %s %s Fixed point constraints\n", m_FeaPartNameVec[i].c_str(), m_StructName.c_str() );
-                                }
-                               m_FeaNodeVec[j]->WriteNASTRAN_SPC1( bdf_fp, noffset );
-                            }
+                            fprintf( bdf_fp, "\n" );
+                            fprintf( bdf_fp, "$ %s %s Fixed point constraints\n", m_FeaPartNameVec[i].c_str(), m_StructName.c_str() );
                         }
+                        m_FeaNodeVec[j]->WriteNASTRAN_SPC1( bdf_fp, noffset );
                     }
                 }
             }
@@ -1267,24 +1385,19 @@ void FeaMesh::WriteNASTRANSPC1( FILE *bdf_fp )
 
             if ( m_FeaPartTypeVec[i] != vsp::FEA_FIX_POINT )
             {
-                for ( unsigned int j = 0; j < (int)m_FeaNodeVec.size(); j++ )
+                for ( int k = 0; k < (int)bc_nodes.size(); k++ )
                 {
-                    if ( m_FeaNodeVecUsed[ j ] )
+                    int j = bc_nodes[ k ];
+                    if ( m_FeaNodeVec[ j ]->HasOnlyTag( i ) )
                     {
-                        if ( m_FeaNodeVec[ j ]->HasOnlyTag( i ) )
+                        if ( !partheader )
                         {
-                            if ( m_FeaNodeVec[ j ]->m_BCs.AsNum() > 0 )
-                            {
-                                if ( !partheader )
-                                {
-                                    partheader = true;
+                            partheader = true;
 
-                                    fprintf( bdf_fp, "\n" );
-                                    fprintf( bdf_fp, "$ %s %s Constraints\n", m_FeaPartNameVec[i].c_str(), m_StructName.c_str() );
-                                }
-                                m_FeaNodeVec[j]->WriteNASTRAN_SPC1( bdf_fp, noffset );
-                            }
+                            fprintf( bdf_fp, "\n" );
+                            fprintf( bdf_fp, "$ %s %s Constraints\n", m_FeaPartNameVec[i].c_str(), m_StructName.c_str() );
                         }
+                        m_FeaNodeVec[j]->WriteNASTRAN_SPC1( bdf_fp, noffset );
                     }
                 }
             }
@@ -1295,66 +1408,54 @@ void FeaMesh::WriteNASTRANSPC1( FILE *bdf_fp )
         {
             bool ssheader = false;
 
-            for ( unsigned int j = 0; j < (int)m_FeaNodeVec.size(); j++ )
+            for ( int k = 0; k < (int)bc_nodes.size(); k++ )
             {
-                if ( m_FeaNodeVecUsed[ j ] )
+                int j = bc_nodes[ k ];
+                if ( m_FeaNodeVec[ j ]->HasOnlyTag( i + m_NumFeaParts ) )
                 {
-                    if ( m_FeaNodeVec[ j ]->HasOnlyTag( i + m_NumFeaParts ) )
+                    if ( !ssheader )
                     {
-                        if ( m_FeaNodeVec[ j ]->m_BCs.AsNum() > 0 )
-                        {
-                            if ( !ssheader )
-                            {
-                                ssheader = true;
+                        ssheader = true;
 
-                                fprintf( bdf_fp, "\n" );
-                                fprintf( bdf_fp, "$ %s %s Constraints\n", m_SimpleSubSurfaceVec[i].GetName().c_str(), m_StructName.c_str() );
-                            }
-                            m_FeaNodeVec[j]->WriteNASTRAN_SPC1( bdf_fp, noffset );
-                        }
+                        fprintf( bdf_fp, "\n" );
+                        fprintf( bdf_fp, "$ %s %s Constraints\n", m_SimpleSubSurfaceVec[i].GetName().c_str(), m_StructName.c_str() );
                     }
+                    m_FeaNodeVec[j]->WriteNASTRAN_SPC1( bdf_fp, noffset );
                 }
             }
         }
 
         // Intersection Nodes
         bool IntersectHeader = false;
-        for ( unsigned int j = 0; j < (int)m_FeaNodeVec.size(); j++ )
+        for ( int k = 0; k < (int)bc_nodes.size(); k++ )
         {
-            if ( m_FeaNodeVecUsed[ j ] )
+            int j = bc_nodes[ k ];
+            if ( m_FeaNodeVec[j]->m_Tags.size() > 1 && !m_FeaNodeVec[j]->m_FixedPointFlag )
             {
-                if ( m_FeaNodeVec[j]->m_Tags.size() > 1 && !m_FeaNodeVec[j]->m_FixedPointFlag )
+                if ( !IntersectHeader )
                 {
-                    if ( m_FeaNodeVec[ j ]->m_BCs.AsNum() > 0 )
-                    {
-                        if ( !IntersectHeader )
-                        {
-                            fprintf( bdf_fp, "\n" );
-                            fprintf( bdf_fp, "$ %s Intersection constraints\n", m_StructName.c_str() );
-                            IntersectHeader = true;
-                        }
-                        m_FeaNodeVec[j]->WriteNASTRAN_SPC1( bdf_fp, noffset );
-                    }
+                    fprintf( bdf_fp, "\n" );
+                    fprintf( bdf_fp, "$ %s Intersection constraints\n", m_StructName.c_str() );
+                    IntersectHeader = true;
                 }
+                m_FeaNodeVec[j]->WriteNASTRAN_SPC1( bdf_fp, noffset );
             }
         }
 
         //==== Remaining Nodes ====//
         bool RemainingHeader = false;
-        for ( int i = 0; i < (int)m_FeaNodeVec.size(); i++ )
+        for ( int k = 0; k < (int)bc_nodes.size(); k++ )
         {
-            if ( m_FeaNodeVecUsed[ i ] && m_FeaNodeVec[i]->m_Tags.size() == 0 )
+            int i = bc_nodes[ k ];
+            if ( m_FeaNodeVec[i]->m_Tags.size() == 0 )
             {
-                if ( m_FeaNodeVec[ i ]->m_BCs.AsNum() > 0 )
+                if ( !RemainingHeader )
                 {
-                    if ( !RemainingHeader )
-                    {
-                        fprintf( bdf_fp, "\n" );
-                        fprintf( bdf_fp, "$ %s Remaining node constraints\n", m_StructName.c_str() );
-                        RemainingHeader = true;
-                    }
-                    m_FeaNodeVec[i]->WriteNASTRAN_SPC1( bdf_fp, noffset );
+                    fprintf( bdf_fp, "\n" );
+                    fprintf( bdf_fp, "$ %s Remaining node constraints\n", m_StructName.c_str() );
+                    RemainingHeader = true;
                 }
+                m_FeaNodeVec[i]->WriteNASTRAN_SPC1( bdf_fp, noffset );
             }
         }
 
@@ -1363,11 +1464,13 @@ void FeaMesh::WriteNASTRANSPC1( FILE *bdf_fp )
 
 void FeaMesh::WriteNASTRANElements( FILE* dat_fp, FILE* bdf_fp, FILE* nkey_fp, int &set_cnt )
 {
-    unsigned long long int noffset = m_StructSettings.m_NodeOffset;
     unsigned long long int eoffset = m_StructSettings.m_ElementOffset;
 
     if ( dat_fp && bdf_fp )
     {
+        UpdateExportTables();
+
+        ExportBuffer buf( bdf_fp );
         string name;
         vector < long long int > shell_elem_id_vec, beam_elem_id_vec;
         int elem_id = 1;
@@ -1378,28 +1481,21 @@ void FeaMesh::WriteNASTRANElements( FILE* dat_fp, FILE* bdf_fp, FILE* nkey_fp, i
             FixPoint fxpt = m_FixPntVec[i];
             if ( fxpt.m_PtMassFlag )
             {
-                bool FPHeader = false;
-
                 vector < long long int > mass_elem_id_vec;
 
-                for ( int j = 0; j < m_FeaElementVec.size(); j++ )
+                vector < int > mass_elems = FilterElements( m_FeaElementVec, m_ExportOwnerElemVec[ fxpt.m_FeaPartIndex ], []( FeaElement* elem )
                 {
-                    if ( m_FeaElementVec[j]->GetElementType() == FeaElement::FEA_POINT_MASS && m_FeaElementVec[j]->GetFeaPartIndex() == fxpt.m_FeaPartIndex && m_FeaElementVec[j]->GetFeaSSIndex() < 0 )
-                    {
-                        if ( !FPHeader )
-                        {
-                            FPHeader = true;
-
-                            fprintf( bdf_fp, "\n" );
-                            fprintf( bdf_fp, "$ %s %s\n", m_FeaPartNameVec[fxpt.m_FeaPartIndex].c_str(), m_StructName.c_str() );
-                        }
+                    return elem->GetElementType() == FeaElement::FEA_POINT_MASS;
+                } );
 
-                        m_FeaElementVec[j]->WriteNASTRAN( bdf_fp, elem_id, -1, noffset, eoffset ); // property ID ignored for Point Masses
-                        mass_elem_id_vec.push_back( elem_id );
-                        elem_id++;
-                    }
+                if ( mass_elems.size() > 0 )
+                {
+                    buf.Append( "\n" );
+                    buf.Printf( "$ %s %s\n", m_FeaPartNameVec[fxpt.m_FeaPartIndex].c_str(), m_StructName.c_str() );
                 }
 
+                WriteNASTRANElementList( buf, mass_elems, -1, elem_id, mass_elem_id_vec ); // property ID ignored for Point Masses
+
                 // Write mass element set
                 name = m_FeaPartNameVec[fxpt.m_FeaPartIndex] + "_" +  m_StructName + "_MassElements";
                 WriteNASTRANSet( dat_fp, nkey_fp, set_cnt, mass_elem_id_vec, name, eoffset );
@@ -1417,62 +1513,43 @@ void FeaMesh::WriteNASTRANElements( FILE* dat_fp, FILE* bdf_fp, FILE* nkey_fp, i
                 int cap_property_id = m_FeaPartCapPropertyIndexVec[i];
 
                 // Write shell elements
-                bool partheader = false;
-
-                for ( int j = 0; j < m_FeaElementVec.size(); j++ )
+                vector < int > shell_elems = FilterElements( m_FeaElementVec, m_ExportOwnerElemVec[ i ], []( FeaElement* elem )
                 {
-                    if ( m_FeaElementVec[j]->GetFeaPartIndex() == i && m_FeaElementVec[j]->GetFeaSSIndex() < 0 && m_FeaElementVec[j]->GetElementType() != FeaElement::FEA_BEAM )
-                    {
-                        if ( !partheader )
-                        {
-                            partheader = true;
+                    return elem->GetElementType() != FeaElement::FEA_BEAM;
+                } );
 
-                            fprintf( bdf_fp, "\n" );
-                            fprintf( bdf_fp, "$ %s %s shell\n", m_FeaPartNameVec[i].c_str(), m_StructName.c_str()  );
-                        }
-
-                        m_FeaElementVec[j]->WriteNASTRAN( bdf_fp, elem_id, property_id, noffset, eoffset );
-                        shell_elem_id_vec.push_back( elem_id );
-                        FeaMeshMgr.MarkPropMatUsed( property_id );
-
-                        elem_id++;
-                    }
+                if ( shell_elems.size() > 0 )
+                {
+                    buf.Append( "\n" );
+                    buf.Printf( "$ %s %s shell\n", m_FeaPartNameVec[i].c_str(), m_StructName.c_str()  );
+                    FeaMeshMgr.MarkPropMatUsed( property_id );
                 }
 
+                WriteNASTRANElementList( buf, shell_elems, property_id, elem_id, shell_elem_id_vec );
+
                 // Write shell element set
                 name = m_FeaPartNameVec[i] + "_" + m_StructName + "_ShellElements";
                 WriteNASTRANSet( dat_fp, nkey_fp, set_cnt, shell_elem_id_vec, name, eoffset );
 
                 for ( int ichain = 0; ichain < m_FeaPartNumChainsVec[ i ]; ichain++ )
                 {
-
                     beam_elem_id_vec.clear();
 
                     // Write beam elements
-                    partheader = false;
-
-                    for ( int j = 0; j < m_FeaElementVec.size(); j++ )
+                    vector < int > beam_elems = FilterElements( m_FeaElementVec, m_ExportOwnerElemVec[ i ], [ichain]( FeaElement* elem )
                     {
-                        if ( m_FeaElementVec[j]->GetFeaPartIndex() == i &&
-                             m_FeaElementVec[j]->GetFeaSSIndex() < 0 &&
-                             m_FeaElementVec[j]->GetChainIndex() == ichain &&
-                             m_FeaElementVec[j]->GetElementType() == FeaElement::FEA_BEAM )
-                        {
-                            if ( !partheader )
-                            {
-                                partheader = true;
+                        return elem->GetChainIndex() == ichain && elem->GetElementType() == FeaElement::FEA_BEAM;
+                    } );
 
-                                fprintf( bdf_fp, "\n" );
-                                fprintf( bdf_fp, "$ %s %s %d beam\n", m_FeaPartNameVec[i].c_str(), m_StructName.c_str(), ichain );
-                            }
+                    if ( beam_elems.size() > 0 )
+                    {
+                        buf.Append( "\n" );
+                        buf.Printf( "$ %s %s %d beam\n", m_FeaPartNameVec[i].c_str(), m_StructName.c_str(), ichain );
+                        FeaMeshMgr.MarkPropMatUsed( cap_property_id );
+                    }
 
-                            m_FeaElementVec[j]->WriteNASTRAN( bdf_fp, elem_id, cap_property_id, noffset, eoffset );
-                            beam_elem_id_vec.push_back( elem_id );
-                            FeaMeshMgr.MarkPropMatUsed( cap_property_id );
+                    WriteNASTRANElementList( buf, beam_elems, cap_property_id, elem_id, beam_elem_id_vec );
 
-                            elem_id++;
-                        }
-                    }
                     // Write beam element set
                     name = m_FeaPartNameVec[i] + "_" + m_StructName + "_" + to_string( ichain ) + "_BeamElements";
                     WriteNASTRANSet( dat_fp, nkey_fp, set_cnt, beam_elem_id_vec, name, eoffset );
@@ -1489,61 +1566,43 @@ void FeaMesh::WriteNASTRANElements( FILE* dat_fp, FILE* bdf_fp, FILE* nkey_fp, i
             shell_elem_id_vec.clear();
 
             // Write shell elements
-            bool ssheader = false;
-
-            for ( int j = 0; j < m_FeaElementVec.size(); j++ )
+            vector < int > shell_elems = FilterElements( m_FeaElementVec, m_ExportOwnerElemVec[ i + m_NumFeaParts ], []( FeaElement* elem )
             {
-                if ( m_FeaElementVec[j]->GetFeaSSIndex() == i && m_FeaElementVec[j]->GetElementType() != FeaElement::FEA_BEAM )
-                {
-                    if ( !ssheader )
-                    {
-                        ssheader = true;
-
-                        fprintf( bdf_fp, "\n" );
-                        fprintf( bdf_fp, "$ %s %s shell\n", m_SimpleSubSurfaceVec[i].GetName().c_str(), m_StructName.c_str() );
-                    }
+                return elem->GetElementType() != FeaElement::FEA_BEAM;
+            } );
 
-                    m_FeaElementVec[j]->WriteNASTRAN( bdf_fp, elem_id, property_id, noffset, eoffset );
-                    shell_elem_id_vec.push_back( elem_id );
-                    FeaMeshMgr.MarkPropMatUsed( property_id );
-
-                    elem_id++;
-                }
+            if ( shell_elems.size() > 0 )
+            {
+                buf.Append( "\n" );
+                buf.Printf( "$ %s %s shell\n", m_SimpleSubSurfaceVec[i].GetName().c_str(), m_StructName.c_str() );
+                FeaMeshMgr.MarkPropMatUsed( property_id );
             }
 
+            WriteNASTRANElementList( buf, shell_elems, property_id, elem_id, shell_elem_id_vec );
+
             // Write shell element set
             name = m_SimpleSubSurfaceVec[i].GetName() + "_" + m_StructName + "_ShellElements";
             WriteNASTRANSet( dat_fp, nkey_fp, set_cnt, shell_elem_id_vec, name, eoffset );
 
             for ( int ichain = 0; ichain < m_FeaPartNumChainsVec[ i ]; ichain++ )
             {
-
                 beam_elem_id_vec.clear();
 
                 // Write beam elements
-                ssheader = false;
-
-                for ( int j = 0; j < m_FeaElementVec.size(); j++ )
+                vector < int > beam_elems = FilterElements( m_FeaElementVec, m_ExportOwnerElemVec[ i + m_NumFeaParts ], [ichain]( FeaElement* elem )
                 {
-                    if ( m_FeaElementVec[j]->GetFeaSSIndex() == i &&
-                         m_FeaElementVec[j]->GetChainIndex() == ichain &&
-                         m_FeaElementVec[j]->GetElementType() == FeaElement::FEA_BEAM )
-                    {
-                        if ( !ssheader )
-                        {
-                            ssheader = true;
+                    return elem->GetChainIndex() == ichain && elem->GetElementType() == FeaElement::FEA_BEAM;
+                } );
 
-                            fprintf( bdf_fp, "\n" );
-                            fprintf( bdf_fp, "$ %s %s %d beam\n", m_SimpleSubSurfaceVec[i].GetName().c_str(), m_StructName.c_str(), ichain );
-                        }
+                if ( beam_elems.size() > 0 )
+                {
+                    buf.Append( "\n" );
+                    buf.Printf( "$ %s %s %d beam\n", m_SimpleSubSurfaceVec[i].GetName().c_str(), m_StructName.c_str(), ichain );
+                    FeaMeshMgr.MarkPropMatUsed( cap_property_id );
+                }
 
-                        m_FeaElementVec[j]->WriteNASTRAN( bdf_fp, elem_id, cap_property_id, noffset, eoffset );
-                        beam_elem_id_vec.push_back( elem_id );
-                        FeaMeshMgr.MarkPropMatUsed( cap_property_id );
+                WriteNASTRANElementList( buf, beam_elems, cap_property_id, elem_id, beam_elem_id_vec );
 
-                        elem_id++;
-                    }
-                }
                 // Write beam element set
                 name = m_SimpleSubSurfaceVec[i].GetName() + "_" + m_StructName + "_" + to_string( ichain ) + "_BeamElements";
                 WriteNASTRANSet( dat_fp, nkey_fp, set_cnt, beam_elem_id_vec, name, eoffset );
@@ -1552,6 +1611,25 @@ void FeaMesh::WriteNASTRANElements( FILE* dat_fp, FILE* bdf_fp, FILE* nkey_fp, i
     }
 }
 
+void FeaMesh::WriteNASTRANElementList( ExportBuffer & buf, const vector < int > & elem_index_vec, int property_id, int & elem_id, vector < long long int > & elem_id_vec )
+{
+    unsigned long long int noffset = m_StructSettings.m_NodeOffset;
+    unsigned long long int eoffset = m_StructSettings.m_ElementOffset;
+
+    int first_id = elem_id;
+
+    ExportUtil::ParallelAppend( buf, (int)elem_index_vec.size(), [&]( ExportBuffer & b, int k )
+    {
+        m_FeaElementVec[ elem_index_vec[ k ] ]->WriteNASTRAN( b, first_id + k, property_id, noffset, eoffset );
+    } );
+
+    for ( int k = 0; k < (int)elem_index_vec.size(); k++ )
+    {
+        elem_id_vec.push_back( elem_id );
+        elem_id++;
+    }
+}
+
 void CloseNASTRAN( FILE *dat_fp, FILE *bdf_header_fp, FILE *bdf_fp, FILE *nkey_fp )
 {
     if ( dat_fp )
@@ -1578,25 +1656,28 @@ void FeaMesh::WriteNASTRANSet( FILE* dat_fp, FILE* nkey_fp, int & set_num, vecto
 {
     if ( set_ids.size() > 0 && dat_fp )
     {
-        fprintf( dat_fp, "\n$ %d, %s\n", set_num, set_name.c_str() );
-        fprintf( dat_fp, "SET %d = ", set_num );
+        ExportBuffer buf( dat_fp );
+
+        buf.Printf( "\n$ %d, %s\n", set_num, set_name.c_str() );
+        buf.Printf( "SET %d = ", set_num );
 
         for ( size_t i = 0; i < set_ids.size(); i++ )
         {
-            fprintf( dat_fp, "%lld", set_ids[i] + offset );
+            buf.AppendInt( set_ids[i] + offset );
 
             if ( i != set_ids.size() - 1 )
             {
-                fprintf( dat_fp, "," );
+                buf.Append( ',' );
 
                 if ( ( i + 1 ) % 9 == 0 ) // 9 IDs per line
                 {
-                    fprintf( dat_fp, "\n" );
+                    buf.Append( '\n' );
                 }
             }
         }
 
-        fprintf( dat_fp, "\n" );
+        buf.Append( '\n' );
+        buf.Flush();
 
         if ( nkey_fp ) // Write to NASTRAN key file if defined
         {
@@ -1661,39 +1742,27 @@ void FeaMesh::WriteCalculixNodes( FILE* fp )
 
     if ( fp )
     {
-        int elem_id = 0;
-        char str[256];
+        UpdateExportTables();
+
+        ExportBuffer buf( fp );
 
         //==== Write Fixed Points ====//
         for ( size_t i = 0; i < m_NumFeaFixPoints; i++ )
         {
             FixPoint fxpt = m_FixPntVec[i];
 
-            fprintf( fp, "** Fixed Point: %s %s\n", m_FeaPartNameVec[fxpt.m_FeaPartIndex].c_str(), m_StructName.c_str() );
-            fprintf( fp, "*NODE, NSET=N%s_%s\n", m_FeaPartNameVec[fxpt.m_FeaPartIndex].c_str(), m_StructName.c_str() );
-
-            // for ( unsigned int j = 0; j < (int)m_FeaNodeVec.size(); j++ )
-            // {
-            //     if ( m_PntShift[j] >= 0 )
-            //     {
-            //         if ( m_FeaNodeVec[j]->m_Tags.size() > 1 &&
-            //              m_FeaNodeVec[j]->m_FixedPointFlag &&
-            //              m_FeaNodeVec[j]->HasTag( fxpt.m_FeaPartIndex ) )
-            //         {
-            //             m_FeaNodeVec[j]->WriteCalculix( fp, noffset );
-            //         }
-            //     }
-            // }
+            buf.Printf( "** Fixed Point: %s %s\n", m_FeaPartNameVec[fxpt.m_FeaPartIndex].c_str(), m_StructName.c_str() );
+            buf.Printf( "*NODE, NSET=N%s_%s\n", m_FeaPartNameVec[fxpt.m_FeaPartIndex].c_str(), m_StructName.c_str() );
 
             for ( unsigned int j = 0; j < (int)fxpt.m_Pnt.size(); j++ )
             {
                 if ( fxpt.m_NodeIndex[j] >= 0 )
                 {
-                    fprintf( fp, "%llu,%f,%f,%f\n", fxpt.m_NodeIndex[j] + noffset, fxpt.m_Pnt[j][0], fxpt.m_Pnt[j][1], fxpt.m_Pnt[j][2] );
+                    buf.Printf( "%llu,%f,%f,%f\n", fxpt.m_NodeIndex[j] + noffset, fxpt.m_Pnt[j][0], fxpt.m_Pnt[j][1], fxpt.m_Pnt[j][2] );
                 }
             }
 
-            fprintf( fp, "\n" );
+            buf.Append( "\n" );
         }
 
         //==== Write Spider Points ====//
@@ -1707,18 +1776,18 @@ void FeaMesh::WriteCalculixNodes( FILE* fp )
                 {
                     if ( fxpt.m_NodeIndex[j] >= 0 )
                     {
-                        fprintf( fp, "** Spider points for node: %d\n", (int) ( fxpt.m_NodeIndex[ j ] + noffset ) );
-                        fprintf( fp, "*NODE, NSET=N_%d_Spider\n", (int) ( fxpt.m_NodeIndex[ j ] + noffset ) );
+                        buf.Printf( "** Spider points for node: %d\n", (int) ( fxpt.m_NodeIndex[ j ] + noffset ) );
+                        buf.Printf( "*NODE, NSET=N_%d_Spider\n", (int) ( fxpt.m_NodeIndex[ j ] + noffset ) );
 
                         for ( int ispider = 0; ispider < fxpt.m_SpiderIndex[ j ].size(); ispider++ )
                         {
                             int spider_ind = (int) fxpt.m_SpiderIndex[ j ][ ispider ];
-                            m_FeaNodeVec[ spider_ind ]->WriteCalculix( fp, noffset );
+                            m_FeaNodeVec[ spider_ind ]->WriteCalculix( buf, noffset );
                         }
                     }
                 }
 
-                fprintf( fp, "\n" );
+                buf.Append( "\n" );
             }
         }
 
@@ -1727,55 +1796,36 @@ void FeaMesh::WriteCalculixNodes( FILE* fp )
         {
             if ( m_FeaPartTypeVec[i] != vsp::FEA_FIX_POINT )
             {
-                bool NodeHeader = false;
+                vector < int > part_nodes = GetExportTagNodes( i );
 
-                for ( unsigned int j = 0; j < (int)m_FeaNodeVec.size(); j++ )
+                if ( part_nodes.size() > 0 )
                 {
-                    if ( m_FeaNodeVecUsed[ j ] && m_FeaNodeVec[ j ]->m_Index > m_FixPtOffset )
-                    {
-                        if ( m_FeaNodeVec[ j ]->HasOnlyTag( i ) )
-                        {
-                            if ( !NodeHeader )
-                            {
-                                fprintf( fp, "** %s %s\n", m_FeaPartNameVec[i].c_str(), m_StructName.c_str() );
-                                fprintf( fp, "*NODE, NSET=N%s_%s\n", m_FeaPartNameVec[i].c_str(), m_StructName.c_str() );
-                                NodeHeader = true;
-                            }
-                            m_FeaNodeVec[j]->WriteCalculix( fp, noffset );
-                        }
-                    }
+                    buf.Printf( "** %s %s\n", m_FeaPartNameVec[i].c_str(), m_StructName.c_str() );
+                    buf.Printf( "*NODE, NSET=N%s_%s\n", m_FeaPartNameVec[i].c_str(), m_StructName.c_str() );
                 }
+                WriteCalculixNodeList( buf, part_nodes );
 
-                fprintf( fp, "\n" );
+                buf.Append( "\n" );
             }
         }
 
         //==== Write SubSurfaces ====//
         for ( unsigned int i = 0; i < m_NumFeaSubSurfs; i++ )
         {
-            bool SubSurfHeader = false;
+            vector < int > ss_nodes = GetExportTagNodes( i + m_NumFeaParts );
 
-            for ( unsigned int j = 0; j < (int)m_FeaNodeVec.size(); j++ )
+            if ( ss_nodes.size() > 0 )
             {
-                if ( m_FeaNodeVecUsed[ j ] && m_FeaNodeVec[ j ]->m_Index > m_FixPtOffset )
-                {
-                    if ( m_FeaNodeVec[ j ]->HasOnlyTag( i + m_NumFeaParts ) )
-                    {
-                        if ( !SubSurfHeader )
-                        {
-                            fprintf( fp, "** %s %s\n", m_SimpleSubSurfaceVec[i].GetName().c_str(), m_StructName.c_str() );
-                            fprintf( fp, "*NODE, NSET=N%s_%s\n", m_SimpleSubSurfaceVec[i].GetName().c_str(), m_StructName.c_str() );
-                            SubSurfHeader = true;
-                        }
-                        m_FeaNodeVec[j]->WriteCalculix( fp, noffset );
-                    }
-                }
+                buf.Printf( "** %s %s\n", m_SimpleSubSurfaceVec[i].GetName().c_str(), m_StructName.c_str() );
+                buf.Printf( "*NODE, NSET=N%s_%s\n", m_SimpleSubSurfaceVec[i].GetName().c_str(), m_StructName.c_str() );
             }
-            fprintf( fp, "\n" );
+            WriteCalculixNodeList( buf, ss_nodes );
+
+            buf.Append( "\n" );
         }
 
         //==== Intersection Nodes ====//
-        bool IntersectHeader = false;
+        vector < int > intersect_nodes;
         for ( unsigned int j = 0; j < (int)m_FeaNodeVec.size(); j++ )
         {
             if ( m_FeaNodeVecUsed[ j ] && m_FeaNodeVec[ j ]->m_Index > m_FixPtOffset )
@@ -1783,45 +1833,40 @@ void FeaMesh::WriteCalculixNodes( FILE* fp )
                 if ( m_FeaNodeVec[j]->m_Tags.size() > 1 &&
                      !m_FeaNodeVec[j]->m_FixedPointFlag )
                 {
-                    if ( !IntersectHeader )
-                    {
-                        fprintf( fp, "** Intersections %s\n", m_StructName.c_str() );
-                        fprintf( fp, "*NODE, NSET=Nintersections_%s\n", m_StructName.c_str() );
-                        IntersectHeader = true;
-                    }
-                    m_FeaNodeVec[j]->WriteCalculix( fp, noffset );
+                    intersect_nodes.push_back( j );
                 }
             }
         }
-        if ( IntersectHeader )
+        if ( intersect_nodes.size() > 0 )
         {
-            fprintf( fp, "\n" );
+            buf.Printf( "** Intersections %s\n", m_StructName.c_str() );
+            buf.Printf( "*NODE, NSET=Nintersections_%s\n", m_StructName.c_str() );
+            WriteCalculixNodeList( buf, intersect_nodes );
+            buf.Append( "\n" );
         }
 
         //==== Remaining Nodes ====//
-        bool RemainingHeader = false;
-        for ( int i = 0; i < (int)m_FeaNodeVec.size(); i++ )
+        vector < int > remain_nodes = GetExportTagNodes( -1 );
+        if ( remain_nodes.size() > 0 )
         {
-            if ( m_FeaNodeVecUsed[ i ] &&
-                 m_FeaNodeVec[ i ]->m_Tags.size() == 0 &&
-                 m_FeaNodeVec[ i ]->m_Index > m_FixPtOffset )
-            {
-                if ( !RemainingHeader )
-                {
-                    fprintf( fp, "** Remaining Nodes %s\n", m_StructName.c_str() );
-                    fprintf( fp, "*NODE, NSET=RemainingNodes_%s\n", m_StructName.c_str() );
-                    RemainingHeader = true;
-                }
-                m_FeaNodeVec[i]->WriteCalculix( fp, noffset );
-            }
-        }
-        if ( RemainingHeader )
-        {
-            fprintf( fp, "\n" );
+            buf.Printf( "** Remaining Nodes %s\n", m_StructName.c_str() );
+            buf.Printf( "*NODE, NSET=RemainingNodes_%s\n", m_StructName.c_str() );
+            WriteCalculixNodeList( buf, remain_nodes );
+            buf.Append( "\n" );
         }
     }
 }
 
+void FeaMesh::WriteCalculixNodeList( ExportBuffer & buf, const vector < int > & node_index_vec )
+{
+    unsigned long long int noffset = m_StructSettings.m_NodeOffset;
+
+    ExportUtil::ParallelAppend( buf, (int)node_index_vec.size(), [&]( ExportBuffer & b, int k )
+    {
+        m_FeaNodeVec[ node_index_vec[ k ] ]->WriteCalculix( b, noffset );
+    } );
+}
+
 void FeaMesh::WriteCalculixElements( FILE* fp )
 {
     unsigned long long int noffset = m_StructSettings.m_NodeOffset;
@@ -1833,8 +1878,10 @@ void FeaMesh::WriteCalculixElements( FILE* fp )
 
     if ( fp )
     {
+        UpdateExportTables();
+
+        ExportBuffer buf( fp );
         int elem_id = 1;
-        char str[256];
 
         //==== Write Fixed Points ====//
         for ( size_t i = 0; i < m_NumFeaFixPoints; i++ )
@@ -1843,26 +1890,21 @@ void FeaMesh::WriteCalculixElements( FILE* fp )
 
             if ( fxpt.m_PtMassFlag )
             {
-                fprintf( fp, "\n" );
-                fprintf( fp, "** Fixed Point: %s %s\n", m_FeaPartNameVec[fxpt.m_FeaPartIndex].c_str(), m_StructName.c_str() );
-                fprintf( fp, "*ELEMENT, TYPE=MASS, ELSET=EP%s_%s\n", m_FeaPartNameVec[fxpt.m_FeaPartIndex].c_str(), m_StructName.c_str() );
+                buf.Append( "\n" );
+                buf.Printf( "** Fixed Point: %s %s\n", m_FeaPartNameVec[fxpt.m_FeaPartIndex].c_str(), m_StructName.c_str() );
+                buf.Printf( "*ELEMENT, TYPE=MASS, ELSET=EP%s_%s\n", m_FeaPartNameVec[fxpt.m_FeaPartIndex].c_str(), m_StructName.c_str() );
 
-                for ( int j = 0; j < m_FeaElementVec.size(); j++ )
+                vector < int > mass_elems = FilterElements( m_FeaElementVec, m_ExportOwnerElemVec[ fxpt.m_FeaPartIndex ], []( FeaElement* elem )
                 {
-                    if ( m_FeaElementVec[j]->GetFeaPartIndex() == fxpt.m_FeaPartIndex &&
-                         m_FeaElementVec[j]->GetElementType() == FeaElement::FEA_POINT_MASS &&
-                         m_FeaElementVec[j]->GetFeaSSIndex() < 0 )
-                    {
-                        m_FeaElementVec[j]->WriteCalculix( fp, elem_id, noffset, eoffset );
-                        elem_id++;
-                    }
-                }
+                    return elem->GetElementType() == FeaElement::FEA_POINT_MASS;
+                } );
+                WriteCalculixElementList( buf, mass_elems, elem_id );
 
-                fprintf( fp, "\n" );
+                buf.Append( "\n" );
 
-                fprintf( fp, "*MASS, ELSET=EP%s_%s\n", m_FeaPartNameVec[fxpt.m_FeaPartIndex].c_str(), m_StructName.c_str() );
-                fprintf( fp, "%f\n", fxpt.m_PtMass );
-                fprintf( fp, "\n" );
+                buf.Printf( "*MASS, ELSET=EP%s_%s\n", m_FeaPartNameVec[fxpt.m_FeaPartIndex].c_str(), m_StructName.c_str() );
+                buf.Printf( "%f\n", fxpt.m_PtMass );
+                buf.Append( "\n" );
             }
         }
 
@@ -1871,7 +1913,7 @@ void FeaMesh::WriteCalculixElements( FILE* fp )
         {
             if ( m_FeaPartTypeVec[i] != vsp::FEA_FIX_POINT )
             {
-                fprintf( fp, "** %s %s\n", m_FeaPartNameVec[i].c_str(), m_StructName.c_str() );
+                buf.Printf( "** %s %s\n", m_FeaPartNameVec[i].c_str(), m_StructName.c_str() );
 
                 int surf_num = m_FeaPartNumSurfVec[i];
 
@@ -1882,20 +1924,16 @@ void FeaMesh::WriteCalculixElements( FILE* fp )
                         int nnode = 3;
                         if ( m_StructSettings.m_HighOrderElementFlag ) nnode = 6;
 
-                        fprintf( fp, "*ELEMENT, TYPE=S%d, ELSET=E%s_%s_%d\n", nnode, m_FeaPartNameVec[i].c_str(), m_StructName.c_str(), isurf );
+                        buf.Printf( "*ELEMENT, TYPE=S%d, ELSET=E%s_%s_%d\n", nnode, m_FeaPartNameVec[i].c_str(), m_StructName.c_str(), isurf );
 
-                        for ( int j = 0; j < m_FeaElementVec.size(); j++ )
+                        vector < int > tri_elems = FilterElements( m_FeaElementVec, m_ExportOwnerElemVec[ i ], [isurf]( FeaElement* elem )
                         {
-                            if ( m_FeaElementVec[j]->GetFeaPartIndex() == i &&
-                                 ( m_FeaElementVec[j]->GetElementType() == FeaElement::FEA_TRI_3 || m_FeaElementVec[j]->GetElementType() == FeaElement::FEA_TRI_6 ) &&
-                                 m_FeaElementVec[j]->GetFeaSSIndex() < 0 &&
-                                 m_FeaElementVec[j]->GetFeaPartSurfNum() == isurf )
-                            {
-                                m_FeaElementVec[j]->WriteCalculix( fp, elem_id, noffset, eoffset );
-                                elem_id++;
-                            }
-                        }
-                        fprintf( fp, "\n" );
+                            return ( elem->GetElementType() == FeaElement::FEA_TRI_3 || elem->GetElementType() == FeaElement::FEA_TRI_6 ) &&
+                                   elem->GetFeaPartSurfNum() == isurf;
+                        } );
+                        WriteCalculixElementList( buf, tri_elems, elem_id );
+
+                        buf.Append( "\n" );
                     }
 
                     if ( m_StructSettings.m_ConvertToQuadsFlag && m_FeaPartKeepDelShellElementsVec[i] == vsp::FEA_KEEP )
@@ -1903,63 +1941,41 @@ void FeaMesh::WriteCalculixElements( FILE* fp )
                         int nnode = 4;
                         if ( m_StructSettings.m_HighOrderElementFlag ) nnode = 8;
 
-                        fprintf( fp, "*ELEMENT, TYPE=S%d, ELSET=E%s_%s_%d\n", nnode, m_FeaPartNameVec[i].c_str(), m_StructName.c_str(), isurf );
+                        buf.Printf( "*ELEMENT, TYPE=S%d, ELSET=E%s_%s_%d\n", nnode, m_FeaPartNameVec[i].c_str(), m_StructName.c_str(), isurf );
 
-                        for ( int j = 0; j < m_FeaElementVec.size(); j++ )
+                        vector < int > quad_elems = FilterElements( m_FeaElementVec, m_ExportOwnerElemVec[ i ], [isurf]( FeaElement* elem )
                         {
-                            if ( m_FeaElementVec[j]->GetFeaPartIndex() == i &&
-                                 ( m_FeaElementVec[j]->GetElementType() == FeaElement::FEA_QUAD_4 || m_FeaElementVec[j]->GetElementType() == FeaElement::FEA_QUAD_8 ) &&
-                                 m_FeaElementVec[j]->GetFeaSSIndex() < 0 &&
-                                 m_FeaElementVec[j]->GetFeaPartSurfNum() == isurf )
-                            {
-                                m_FeaElementVec[j]->WriteCalculix( fp, elem_id, noffset, eoffset );
-                                elem_id++;
-                            }
-                        }
-                        fprintf( fp, "\n" );
+                            return ( elem->GetElementType() == FeaElement::FEA_QUAD_4 || elem->GetElementType() == FeaElement::FEA_QUAD_8 ) &&
+                                   elem->GetFeaPartSurfNum() == isurf;
+                        } );
+                        WriteCalculixElementList( buf, quad_elems, elem_id );
+
+                        buf.Append( "\n" );
                     }
 
                     if ( m_FeaPartCreateBeamElementsVec[i] )
                     {
                         for ( int ichain = 0; ichain < m_FeaPartNumChainsVec[i]; ichain++ )
                         {
-                            fprintf( fp, "*ELEMENT, TYPE=B32R, ELSET=EB%s_%s_%d_%d_CAP\n", m_FeaPartNameVec[i].c_str(), m_StructName.c_str(), isurf, ichain );
+                            buf.Printf( "*ELEMENT, TYPE=B32R, ELSET=EB%s_%s_%d_%d_CAP\n", m_FeaPartNameVec[i].c_str(), m_StructName.c_str(), isurf, ichain );
 
-                            for ( int j = 0; j < m_FeaElementVec.size(); j++ )
+                            vector < int > beam_elems = FilterElements( m_FeaElementVec, m_ExportOwnerElemVec[ i ], [isurf, ichain]( FeaElement* elem )
                             {
-                                if ( m_FeaElementVec[j]->GetFeaPartIndex() == i &&
-                                     m_FeaElementVec[j]->GetElementType() == FeaElement::FEA_BEAM &&
-                                     m_FeaElementVec[j]->GetFeaSSIndex() < 0 &&
-                                     m_FeaElementVec[j]->GetChainIndex() == ichain &&
-                                     m_FeaElementVec[j]->GetFeaPartSurfNum() == isurf )
-                                {
-                                    m_FeaElementVec[j]->WriteCalculix( fp, elem_id, noffset, eoffset );
-                                    elem_id++;
-                                }
-                            }
+                                return elem->GetElementType() == FeaElement::FEA_BEAM &&
+                                       elem->GetChainIndex() == ichain &&
+                                       elem->GetFeaPartSurfNum() == isurf;
+                            } );
+                            WriteCalculixElementList( buf, beam_elems, elem_id );
 
                             if ( m_StructSettings.m_BeamPerElementNormal )
                             {
                                 // Write Normal Vectors
-                                fprintf( fp, "\n" );
-                                fprintf( fp, "*NORMAL\n" );
-
-                                for ( int j = 0; j < m_FeaElementVec.size(); j++ )
-                                {
-                                    if ( m_FeaElementVec[j]->GetFeaPartIndex() == i &&
-                                         m_FeaElementVec[j]->GetElementType() == FeaElement::FEA_BEAM &&
-                                         m_FeaElementVec[j]->GetFeaSSIndex() < 0 &&
-                                         m_FeaElementVec[j]->GetChainIndex() == ichain &&
-                                         m_FeaElementVec[j]->GetFeaPartSurfNum() == isurf )
-                                    {
-                                        FeaBeam* beam = dynamic_cast<FeaBeam*>( m_FeaElementVec[j] );
-                                        assert( beam );
-                                        beam->WriteCalculixNormal( fp, noffset, eoffset );
-                                    }
-                                }
+                                buf.Append( "\n" );
+                                buf.Append( "*NORMAL\n" );
+                                WriteCalculixBeamNormalList( buf, beam_elems );
                             }
 
-                            fprintf( fp, "\n" );
+                            buf.Append( "\n" );
                         }
                     }
                 }
@@ -1970,6 +1986,7 @@ void FeaMesh::WriteCalculixElements( FILE* fp )
         for ( unsigned int i = 0; i < m_NumFeaSubSurfs; i++ )
         {
             int surf_num = m_SimpleSubSurfaceVec[i].GetFeaOrientationVec().size();
+            const vector < int > & ss_elems = m_ExportOwnerElemVec[ i + m_NumFeaParts ];
 
             for ( int isurf = 0; isurf < surf_num; isurf++ )
             {
@@ -1978,19 +1995,16 @@ void FeaMesh::WriteCalculixElements( FILE* fp )
                     int nnode = 3;
                     if ( m_StructSettings.m_HighOrderElementFlag ) nnode = 6;
 
-                    fprintf( fp, "\n*ELEMENT, TYPE=S%d, ELSET=E%s_%s_%d\n", nnode, m_SimpleSubSurfaceVec[i].GetName().c_str(), m_StructName.c_str(), isurf );
+                    buf.Printf( "\n*ELEMENT, TYPE=S%d, ELSET=E%s_%s_%d\n", nnode, m_SimpleSubSurfaceVec[i].GetName().c_str(), m_StructName.c_str(), isurf );
 
-                    for ( int j = 0; j < m_FeaElementVec.size(); j++ )
+                    vector < int > tri_elems = FilterElements( m_FeaElementVec, ss_elems, [isurf]( FeaElement* elem )
                     {
-                        if ( m_FeaElementVec[j]->GetFeaSSIndex() == i &&
-                             ( m_FeaElementVec[j]->GetElementType() == FeaElement::FEA_TRI_3 || m_FeaElementVec[j]->GetElementType() == FeaElement::FEA_TRI_6 ) &&
-                             m_FeaElementVec[j]->GetFeaPartSurfNum() == isurf )
-                        {
-                            m_FeaElementVec[j]->WriteCalculix( fp, elem_id, noffset, eoffset );
-                            elem_id++;
-                        }
-                    }
-                    fprintf( fp, "\n" );
+                        return ( elem->GetElementType() == FeaElement::FEA_TRI_3 || elem->GetElementType() == FeaElement::FEA_TRI_6 ) &&
+                               elem->GetFeaPartSurfNum() == isurf;
+                    } );
+                    WriteCalculixElementList( buf, tri_elems, elem_id );
+
+                    buf.Append( "\n" );
                 }
 
                 if ( m_StructSettings.m_ConvertToQuadsFlag && m_SimpleSubSurfaceVec[i].m_KeepDelShellElements == vsp::FEA_KEEP )
@@ -1998,63 +2012,42 @@ void FeaMesh::WriteCalculixElements( FILE* fp )
                     int nnode = 4;
                     if ( m_StructSettings.m_HighOrderElementFlag ) nnode = 8;
 
-                    fprintf( fp, "\n*ELEMENT, TYPE=S%d, ELSET=E%s_%s_%d\n", nnode, m_SimpleSubSurfaceVec[i].GetName().c_str(), m_StructName.c_str(), isurf );
+                    buf.Printf( "\n*ELEMENT, TYPE=S%d, ELSET=E%s_%s_%d\n", nnode, m_SimpleSubSurfaceVec[i].GetName().c_str(), m_StructName.c_str(), isurf );
 
-                    for ( int j = 0; j < m_FeaElementVec.size(); j++ )
+                    vector < int > quad_elems = FilterElements( m_FeaElementVec, ss_elems, [isurf]( FeaElement* elem )
                     {
-                        if ( m_FeaElementVec[j]->GetFeaSSIndex() == i &&
-                             ( m_FeaElementVec[j]->GetElementType() == FeaElement::FEA_QUAD_4 || m_FeaElementVec[j]->GetElementType() == FeaElement::FEA_QUAD_8 ) &&
-                             m_FeaElementVec[j]->GetFeaPartSurfNum() == isurf )
-                        {
-                            m_FeaElementVec[j]->WriteCalculix( fp, elem_id, noffset, eoffset );
-                            elem_id++;
-                        }
-                    }
-                    fprintf( fp, "\n" );
+                        return ( elem->GetElementType() == FeaElement::FEA_QUAD_4 || elem->GetElementType() == FeaElement::FEA_QUAD_8 ) &&
+                               elem->GetFeaPartSurfNum() == isurf;
+                    } );
+                    WriteCalculixElementList( buf, quad_elems, elem_id );
+
+                    buf.Append( "\n" );
                 }
 
                 if ( m_SimpleSubSurfaceVec[i].m_CreateBeamElements )
                 {
                     for ( int ichain = 0; ichain < m_FeaPartNumChainsVec[i]; ichain++ )
                     {
+                        buf.Append( "\n" );
+                        buf.Printf( "*ELEMENT, TYPE=B32R, ELSET=EB%s_%s_%d_%d_CAP\n", m_SimpleSubSurfaceVec[i].GetName().c_str(), m_StructName.c_str(), isurf, ichain );
 
-                        fprintf( fp, "\n" );
-                        fprintf( fp, "*ELEMENT, TYPE=B32R, ELSET=EB%s_%s_%d_%d_CAP\n", m_SimpleSubSurfaceVec[i].GetName().c_str(), m_StructName.c_str(), isurf, ichain );
-
-                        for ( int j = 0; j < m_FeaElementVec.size(); j++ )
+                        vector < int > beam_elems = FilterElements( m_FeaElementVec, ss_elems, [isurf, ichain]( FeaElement* elem )
                         {
-                            if ( m_FeaElementVec[j]->GetFeaSSIndex() == i &&
-                                 m_FeaElementVec[j]->GetElementType() == FeaElement::FEA_BEAM &&
-                                 m_FeaElementVec[j]->GetChainIndex() == ichain &&
-                                 m_FeaElementVec[j]->GetFeaPartSurfNum() == isurf )
-                            {
-                                m_FeaElementVec[j]->WriteCalculix( fp, elem_id, noffset, eoffset );
-                                elem_id++;
-                            }
-                        }
-
+                            return elem->GetElementType() == FeaElement::FEA_BEAM &&
+                                   elem->GetChainIndex() == ichain &&
+                                   elem->GetFeaPartSurfNum() == isurf;
+                        } );
+                        WriteCalculixElementList( buf, beam_elems, elem_id );
 
                         if ( m_StructSettings.m_BeamPerElementNormal )
                         {
                             // Write Normal Vectors
-                            fprintf( fp, "\n" );
-                            fprintf( fp, "*NORMAL\n" );
-
-                            for ( int j = 0; j < m_FeaElementVec.size(); j++ )
-                            {
-                                if ( m_FeaElementVec[j]->GetFeaSSIndex() == i &&
-                                     m_FeaElementVec[j]->GetElementType() == FeaElement::FEA_BEAM &&
-                                     m_FeaElementVec[j]->GetChainIndex() == ichain &&
-                                     m_FeaElementVec[j]->GetFeaPartSurfNum() == isurf )
-                                {
-                                    FeaBeam* beam = dynamic_cast<FeaBeam*>( m_FeaElementVec[j] );
-                                    assert( beam );
-                                    beam->WriteCalculixNormal( fp, noffset, eoffset );
-                                }
-                            }
+                            buf.Append( "\n" );
+                            buf.Append( "*NORMAL\n" );
+                            WriteCalculixBeamNormalList( buf, beam_elems );
                         }
 
-                        fprintf( fp, "\n" );
+                        buf.Append( "\n" );
                     }
                 }
             }
@@ -2062,6 +2055,34 @@ void FeaMesh::WriteCalculixElements( FILE* fp )
     }
 }
 
+void FeaMesh::WriteCalculixElementList( ExportBuffer & buf, const vector < int > & elem_index_vec, int & elem_id )
+{
+    unsigned long long int noffset = m_StructSettings.m_NodeOffset;
+    unsigned long long int eoffset = m_StructSettings.m_ElementOffset;
+
+    int first_id = elem_id;
+
+    ExportUtil::ParallelAppend( buf, (int)elem_index_vec.size(), [&]( ExportBuffer & b, int k )
+    {
+        m_FeaElementVec[ elem_index_vec[ k ] ]->WriteCalculix( b, first_id + k, noffset, eoffset );
+    } );
+
+    elem_id += elem_index_vec.size();
+}
+
+void FeaMesh::WriteCalculixBeamNormalList( ExportBuffer & buf, const vector < int > & elem_index_vec )
+{
+    unsigned long long int noffset = m_StructSettings.m_NodeOffset;
+    unsigned long long int eoffset = m_StructSettings.m_ElementOffset;
+
+    ExportUtil::ParallelAppend( buf, (int)elem_index_vec.size(), [&]( ExportBuffer & b, int k )
+    {
+        FeaBeam* beam = dynamic_cast<FeaBeam*>( m_FeaElementVec[ elem_index_vec[ k ] ] );
+        assert( beam );
+        beam->WriteCalculixNormal( b, noffset, eoffset );
+    } );
+}
+
 void FeaMesh::WriteCalculixBCs( FILE* fp )
 {
     unsigned long long int noffset = m_StructSettings.m_NodeOffset;
@@ -2306,13 +2327,15 @@ void FeaMesh::WriteGmshNodes( FILE* fp )
 {
     unsigned long long int noffset = m_StructSettings.m_NodeOffset;
 
-    for ( unsigned int j = 0; j < (int)m_FeaNodeVec.size(); j++ )
+    ExportBuffer buf( fp );
+
+    ExportUtil::ParallelAppend( buf, (int)m_FeaNodeVec.size(), [&]( ExportBuffer & b, int j )
     {
         if ( m_FeaNodeVecUsed[ j ] )
         {
-            m_FeaNodeVec[j]->WriteGmsh( fp, noffset );
+            m_FeaNodeVec[j]->WriteGmsh( b, noffset );
         }
-    }
+    } );
 }
 
 void FeaMesh::WriteGmshElements( FILE* fp, int & ele_cnt )
@@ -2320,16 +2343,21 @@ void FeaMesh::WriteGmshElements( FILE* fp, int & ele_cnt )
     unsigned long long int noffset = m_StructSettings.m_NodeOffset;
     unsigned long long int eoffset = m_StructSettings.m_ElementOffset;
 
+    UpdateExportTables();
+
+    ExportBuffer buf( fp );
+
     for ( unsigned int j = 0; j < m_NumFeaParts; j++ )
     {
-        for ( int i = 0; i < (int)m_FeaElementVec.size(); i++ )
+        const vector < int > & part_elems = m_ExportPartElemVec[ j ];
+        int first_id = ele_cnt;
+
+        ExportUtil::ParallelAppend( buf, (int)part_elems.size(), [&]( ExportBuffer & b, int k )
         {
-            if ( m_FeaElementVec[i]->GetFeaPartIndex() == j )
-            {
-                m_FeaElementVec[i]->WriteGmsh( fp, ele_cnt, j + 1, noffset, eoffset );
-                ele_cnt++;
-            }
-        }
+            m_FeaElementVec[ part_elems[ k ] ]->WriteGmsh( b, first_id + k, j + 1, noffset, eoffset );
+        } );
+
+        ele_cnt += part_elems.size();
     }
 }
 
@@ -2349,6 +2377,10 @@ void FeaMesh::WriteSTL( FILE* fp )
 {
     if ( fp )
     {
+        UpdateExportTables();
+
+        ExportBuffer buf( fp );
+
         for ( unsigned int i = 0; i < m_NumFeaParts; i++ )
         {
             int surf_num = m_FeaPartNumSurfVec[i];
@@ -2357,19 +2389,11 @@ void FeaMesh::WriteSTL( FILE* fp )
             {
                 if ( m_FeaPartKeepDelShellElementsVec[i] == vsp::FEA_KEEP )
                 {
-                    fprintf( fp, "solid %s_%d\n", m_FeaPartNameVec[ i ].c_str(), isurf );
+                    buf.Printf( "solid %s_%d\n", m_FeaPartNameVec[ i ].c_str(), isurf );
 
-                    for ( int j = 0; j < m_FeaElementVec.size(); j++ )
-                    {
-                        if ( m_FeaElementVec[j]->GetFeaPartIndex() == i &&
-                             m_FeaElementVec[j]->GetFeaSSIndex() < 0 &&
-                             m_FeaElementVec[j]->GetFeaPartSurfNum() == isurf )
-                        {
-                            m_FeaElementVec[j]->WriteSTL( fp );
-                        }
-                    }
+                    WriteSTLElementList( buf, m_ExportOwnerElemVec[ i ], isurf );
 
-                    fprintf( fp, "endsolid %s_%d\n", m_FeaPartNameVec[ i ].c_str(), isurf );
+                    buf.Printf( "endsolid %s_%d\n", m_FeaPartNameVec[ i ].c_str(), isurf );
                 }
             }
         }
@@ -2382,23 +2406,30 @@ void FeaMesh::WriteSTL( FILE* fp )
             {
                 if ( m_SimpleSubSurfaceVec[i].m_KeepDelShellElements == vsp::FEA_KEEP )
                 {
-                    fprintf( fp, "solid %s_%d\n", m_SimpleSubSurfaceVec[i].GetName().c_str(), isurf );
+                    buf.Printf( "solid %s_%d\n", m_SimpleSubSurfaceVec[i].GetName().c_str(), isurf );
 
-                    for ( int j = 0; j < m_FeaElementVec.size(); j++ )
-                    {
-                        if ( m_FeaElementVec[j]->GetFeaSSIndex() == i &&
-                             m_FeaElementVec[j]->GetFeaPartSurfNum() == isurf )
-                        {
-                            m_FeaElementVec[j]->WriteSTL( fp );
-                        }
-                    }
-                    fprintf( fp, "endsolid %s_%d\n", m_SimpleSubSurfaceVec[i].GetName().c_str(), isurf );
+                    WriteSTLElementList( buf, m_ExportOwnerElemVec[ i + m_NumFeaParts ], isurf );
+
+                    buf.Printf( "endsolid %s_%d\n", m_SimpleSubSurfaceVec[i].GetName().c_str(), isurf );
                 }
             }
         }
     }
 }
 
+void FeaMesh::WriteSTLElementList( ExportBuffer & buf, const vector < int > & elem_index_vec, int isurf )
+{
+    vector < int > surf_elems = FilterElements( m_FeaElementVec, elem_index_vec, [isurf]( FeaElement* elem )
+    {
+        return elem->GetFeaPartSurfNum() == isurf;
+    } );
+
+    ExportUtil::ParallelAppend( buf, (int)surf_elems.size(), [&]( ExportBuffer & b, int k )
+    {
+        m_FeaElementVec[ surf_elems[ k ] ]->WriteSTL( b );
+    } );
+}
+
 void FeaMesh::ComputeWriteMass()
 {
     string fn = GetStructSettingsPtr()->GetExportFileName( vsp::FEA_MASS_FILE_NAME );
@@ -121,12 +121,37 @@ public:
     virtual void WriteSTL();
     virtual void WriteSTL( FILE* fp );
 
+    // Node and element lookup tables shared by all writers.  Built once after
+    // meshing so each writer visits only the nodes/elements of a part instead
+    // of scanning the whole mesh once per part.
+    virtual void BuildExportTables();
+    virtual void UpdateExportTables()
+    {
+        if ( !m_ExportTablesValid )
+        {
+            BuildExportTables();
+        }
+    }
+    virtual vector < int > GetExportTagNodes( int tag );
+
     // Was protected.
     virtual void WriteNASTRANSet( FILE* dat_fp, FILE* nkey_fp, int & set_num, vector < long long int > set_ids, const string &set_name, const long long int &offset );
 
     virtual void ComputeWriteMass();
     virtual void ComputeWriteMass( FILE* fp );
 
+protected:
+
+    // Write the listed nodes/elements, formatted in parallel.
+    virtual void WriteNASTRANNodeList( ExportBuffer & buf, const vector < int > & node_index_vec, vector < long long int > & node_id_vec );
+    virtual void WriteNASTRANElementList( ExportBuffer & buf, const vector < int > & elem_index_vec, int property_id, int & elem_id, vector < long long int > & elem_id_vec );
+    virtual void WriteCalculixNodeList( ExportBuffer & buf, const vector < int > & node_index_vec );
+    virtual void WriteCalculixElementList( ExportBuffer & buf, const vector < int > & elem_index_vec, int & elem_id );
+    virtual void WriteCalculixBeamNormalList( ExportBuffer & buf, const vector < int > & elem_index_vec );
+    virtual void WriteSTLElementList( ExportBuffer & buf, const vector < int > & elem_index_vec, int isurf );
+
+public:
+
     virtual FixPoint* GetFixPointByID( const string &id );
 
     // This is a duplicate of SurfaceIntersectionMgr::m_SimpleSubSurfaceVec
@@ -183,6 +208,14 @@ public:
     vector < FeaNode* > m_FeaNodeVec;
     vector < bool > m_FeaNodeVecUsed;
 
+    // Export lookup tables, indices into m_FeaNodeVec and m_FeaElementVec.
+    bool m_ExportTablesValid;
+    vector < vector < int > > m_ExportTagNodeVec;     // Used nodes with only this tag, parts then subsurfaces
+    vector < int > m_ExportUntaggedNodeVec;           // Used nodes without tags, HasOnlyTag() is true for any tag
+    vector < int > m_ExportBCNodeVec;                 // Used nodes with boundary conditions
+    vector < vector < int > > m_ExportPartElemVec;    // Elements by FeaPart index
+    vector < vector < int > > m_ExportOwnerElemVec;   // Elements by owner, parts ( not in a subsurface ) then subsurfaces
+
     vector < FixPoint > m_FixPntVec; // Fix point data map.
     int m_FixPtOffset;
 
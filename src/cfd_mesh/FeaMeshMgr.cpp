@@ -630,6 +630,8 @@ void FeaMeshMgrSingleton::GenerateFeaMesh()
     addOutputText( "Tag Fea Nodes\n" );
     TagFeaNodes();
 
+    GetMeshPtr()->BuildExportTables();
+
     GetMeshPtr()->m_MeshReady = true;
 
     UpdateDrawObjs();
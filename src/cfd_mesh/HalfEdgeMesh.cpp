@@ -0,0 +1,1412 @@
+//
+// This file is released under the terms of the NASA Open Source Agreement (NOSA)
+// version 1.3 as detailed in the LICENSE file which accompanies this software.
+//
+
+// HalfEdgeMesh
+//
+//////////////////////////////////////////////////////////////////////
+
+#define _USE_MATH_DEFINES
+#include "HalfEdgeMesh.h"
+#include "Surf.h"
+#include "MeshCache.h"
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+
+static bool LongEdgeIndexCompare( const pair< int, double >& a, const pair< int, double >& b )
+{
+    if ( a.second == b.second )
+    {
+        return a.first < b.first;
+    }
+    return ( b.second < a.second );
+}
+static bool ShortEdgeIndexCompare( const pair< int, double >& a, const pair< int, double >& b )
+{
+    if ( a.second == b.second )
+    {
+        return a.first < b.first;
+    }
+    return ( a.second < b.second );
+}
+
+HalfEdgeMesh::HalfEdgeMesh()
+{
+    m_Surf = nullptr;
+    m_GridDensity = nullptr;
+    m_NumFaces = 0;
+}
+
+HalfEdgeMesh::~HalfEdgeMesh()
+{
+}
+
+void HalfEdgeMesh::Clear()
+{
+    m_X.clear();
+    m_Y.clear();
+    m_Z.clear();
+    m_U.clear();
+    m_W.clear();
+    m_NodeHE.clear();
+    m_NodeFixed.clear();
+    m_NodeAlive.clear();
+
+    m_EdgeHE.clear();
+    m_EdgeBorder.clear();
+    m_EdgeRidge.clear();
+    m_EdgeSplitNode.clear();
+    m_EdgeTargetLen.clear();
+    m_EdgeLength.clear();
+    m_EdgeAlive.clear();
+
+    m_FaceNode.clear();
+    m_HETwin.clear();
+    m_HEEdge.clear();
+    m_FaceAlive.clear();
+    m_NumFaces = 0;
+
+    m_FreeNodes.clear();
+    m_FreeEdges.clear();
+    m_FreeFaces.clear();
+
+    m_GarbageNodes.clear();
+    m_GarbageEdges.clear();
+    m_GarbageFaces.clear();
+}
+
+void HalfEdgeMesh::AddHash( GeomHash & hash ) const
+{
+    hash.AddVec( m_X );
+    hash.AddVec( m_Y );
+    hash.AddVec( m_Z );
+    hash.AddVec( m_U );
+    hash.AddVec( m_W );
+    hash.AddVec( m_NodeHE );
+    hash.AddVec( m_NodeFixed );
+    hash.AddVec( m_NodeAlive );
+
+    hash.AddVec( m_EdgeHE );
+    hash.AddVec( m_EdgeBorder );
+    hash.AddVec( m_EdgeRidge );
+    hash.AddVec( m_EdgeSplitNode );
+    hash.AddVec( m_EdgeTargetLen );
+    hash.AddVec( m_EdgeLength );
+    hash.AddVec( m_EdgeAlive );
+
+    hash.AddVec( m_FaceNode );
+    hash.AddVec( m_HETwin );
+    hash.AddVec( m_HEEdge );
+    hash.AddVec( m_FaceAlive );
+    hash.Add( m_NumFaces );
+
+    hash.AddVec( m_FreeNodes );
+    hash.AddVec( m_FreeEdges );
+    hash.AddVec( m_FreeFaces );
+
+    hash.AddVec( m_GarbageNodes );
+    hash.AddVec( m_GarbageEdges );
+    hash.AddVec( m_GarbageFaces );
+}
+
+bool HalfEdgeMesh::SameAs( const HalfEdgeMesh & hem ) const
+{
+    return m_X == hem.m_X && m_Y == hem.m_Y && m_Z == hem.m_Z &&
+           m_U == hem.m_U && m_W == hem.m_W &&
+           m_NodeHE == hem.m_NodeHE && m_NodeFixed == hem.m_NodeFixed && m_NodeAlive == hem.m_NodeAlive &&
+           m_EdgeHE == hem.m_EdgeHE && m_EdgeBorder == hem.m_EdgeBorder && m_EdgeRidge == hem.m_EdgeRidge &&
+           m_EdgeSplitNode == hem.m_EdgeSplitNode && m_EdgeTargetLen == hem.m_EdgeTargetLen &&
+           m_EdgeLength == hem.m_EdgeLength && m_EdgeAlive == hem.m_EdgeAlive &&
+           m_FaceNode == hem.m_FaceNode && m_HETwin == hem.m_HETwin && m_HEEdge == hem.m_HEEdge &&
+           m_FaceAlive == hem.m_FaceAlive && m_NumFaces == hem.m_NumFaces &&
+           m_FreeNodes == hem.m_FreeNodes && m_FreeEdges == hem.m_FreeEdges && m_FreeFaces == hem.m_FreeFaces &&
+           m_GarbageNodes == hem.m_GarbageNodes && m_GarbageEdges == hem.m_GarbageEdges &&
+           m_GarbageFaces == hem.m_GarbageFaces;
+}
+
+void HalfEdgeMesh::Reserve( int num_nodes, int num_edges, int num_faces )
+{
+    m_X.reserve( num_nodes );
+    m_Y.reserve( num_nodes );
+    m_Z.reserve( num_nodes );
+    m_U.reserve( num_nodes );
+    m_W.reserve( num_nodes );
+    m_NodeHE.reserve( num_nodes );
+    m_NodeFixed.reserve( num_nodes );
+    m_NodeAlive.reserve( num_nodes );
+
+    m_EdgeHE.reserve( num_edges );
+    m_EdgeBorder.reserve( num_edges );
+    m_EdgeRidge.reserve( num_edges );
+    m_EdgeSplitNode.reserve( num_edges );
+    m_EdgeTargetLen.reserve( num_edges );
+    m_EdgeLength.reserve( num_edges );
+    m_EdgeAlive.reserve( num_edges );
+
+    m_FaceNode.reserve( 3 * num_faces );
+    m_HETwin.reserve( 3 * num_faces );
+    m_HEEdge.reserve( 3 * num_faces );
+    m_FaceAlive.reserve( num_faces );
+}
+
+//==== Slot Management ====//
+int HalfEdgeMesh::NewNode()
+{
+    int n;
+    if ( !m_FreeNodes.empty() )
+    {
+        n = m_FreeNodes.back();
+        m_FreeNodes.pop_back();
+    }
+    else
+    {
+        n = ( int )m_X.size();
+        m_X.push_back( 0.0 );
+        m_Y.push_back( 0.0 );
+        m_Z.push_back( 0.0 );
+        m_U.push_back( 0.0 );
+        m_W.push_back( 0.0 );
+        m_NodeHE.push_back( -1 );
+        m_NodeFixed.push_back( 0 );
+        m_NodeAlive.push_back( 0 );
+    }
+
+    m_NodeHE[ n ] = -1;
+    m_NodeFixed[ n ] = 0;
+    m_NodeAlive[ n ] = 1;
+    return n;
+}
+
+int HalfEdgeMesh::NewEdge()
+{
+    int e;
+    if ( !m_FreeEdges.empty() )
+    {
+        e = m_FreeEdges.back();
+        m_FreeEdges.pop_back();
+    }
+    else
+    {
+        e = ( int )m_EdgeHE.size();
+        m_EdgeHE.push_back( -1 );
+        m_EdgeBorder.push_back( 0 );
+        m_EdgeRidge.push_back( 0 );
+        m_EdgeSplitNode.push_back( -1 );
+        m_EdgeTargetLen.push_back( 0.0 );
+        m_EdgeLength.push_back( 0.0 );
+        m_EdgeAlive.push_back( 0 );
+    }
+
+    m_EdgeHE[ e ] = -1;
+    m_EdgeBorder[ e ] = 0;
+    m_EdgeRidge[ e ] = 0;
+    m_EdgeSplitNode[ e ] = -1;
+    m_EdgeTargetLen[ e ] = 0.0;
+    m_EdgeLength[ e ] = 0.0;
+    m_EdgeAlive[ e ] = 1;
+    return e;
+}
+
+int HalfEdgeMesh::NewFace()
+{
+    int f;
+    if ( !m_FreeFaces.empty() )
+    {
+        f = m_FreeFaces.back();
+        m_FreeFaces.pop_back();
+    }
+    else
+    {
+        f = ( int )m_FaceAlive.size();
+        m_FaceAlive.push_back( 0 );
+        for ( int k = 0; k < 3; k++ )
+        {
+            m_FaceNode.push_back( -1 );
+            m_HETwin.push_back( -1 );
+            m_HEEdge.push_back( -1 );
+        }
+    }
+
+    for ( int k = 0; k < 3; k++ )
+    {
+        m_FaceNode[ 3 * f + k ] = -1;
+        m_HETwin[ 3 * f + k ] = -1;
+        m_HEEdge[ 3 * f + k ] = -1;
+    }
+    m_FaceAlive[ f ] = 1;
+    m_NumFaces++;
+    return f;
+}
+
+void HalfEdgeMesh::RemoveNode( int n )
+{
+    if ( m_NodeAlive[ n ] )
+    {
+        m_NodeAlive[ n ] = 0;
+        m_NodeHE[ n ] = -1;
+        m_GarbageNodes.push_back( n );
+    }
+}
+
+void HalfEdgeMesh::RemoveEdge( int e )
+{
+    if ( m_EdgeAlive[ e ] )
+    {
+        m_EdgeAlive[ e ] = 0;
+        m_GarbageEdges.push_back( e );
+    }
+}
+
+void HalfEdgeMesh::RemoveFace( int f )
+{
+    if ( m_FaceAlive[ f ] )
+    {
+        for ( int k = 0; k < 3; k++ )
+        {
+            int h = 3 * f + k;
+            int t = m_HETwin[ h ];
+            int e = m_HEEdge[ h ];
+
+            if ( t >= 0 && m_HETwin[ t ] == h )
+            {
+                m_HETwin[ t ] = -1;
+            }
+
+            // Keep surviving edges pointing at a live half-edge.
+            if ( e >= 0 && m_EdgeAlive[ e ] && m_EdgeHE[ e ] == h )
+            {
+                m_EdgeHE[ e ] = t;
+            }
+        }
+
+        m_FaceAlive[ f ] = 0;
+        m_NumFaces--;
+        m_GarbageFaces.push_back( f );
+    }
+}
+
+void HalfEdgeMesh::DumpGarbage()
+{
+    m_FreeNodes.insert( m_FreeNodes.end(), m_GarbageNodes.begin(), m_GarbageNodes.end() );
+    m_GarbageNodes.clear();
+
+    m_FreeEdges.insert( m_FreeEdges.end(), m_GarbageEdges.begin(), m_GarbageEdges.end() );
+    m_GarbageEdges.clear();
+
+    m_FreeFaces.insert( m_FreeFaces.end(), m_GarbageFaces.begin(), m_GarbageFaces.end() );
+    m_GarbageFaces.clear();
+}
+
+void HalfEdgeMesh::SetFace( int f, int n0, int n1, int n2 )
+{
+    m_FaceNode[ 3 * f ] = n0;
+    m_FaceNode[ 3 * f + 1 ] = n1;
+    m_FaceNode[ 3 * f + 2 ] = n2;
+
+    m_NodeHE[ n0 ] = 3 * f;
+    m_NodeHE[ n1 ] = 3 * f + 1;
+    m_NodeHE[ n2 ] = 3 * f + 2;
+}
+
+void HalfEdgeMesh::SetHalfEdge( int h, int e, int twin )
+{
+    m_HEEdge[ h ] = e;
+    m_HETwin[ h ] = twin;
+    if ( twin >= 0 )
+    {
+        m_HETwin[ twin ] = h;
+    }
+    m_EdgeHE[ e ] = h;
+}
+
+void HalfEdgeMesh::SetPnt( int n, const vec3d & p )
+{
+    m_X[ n ] = p.x();
+    m_Y[ n ] = p.y();
+    m_Z[ n ] = p.z();
+}
+
+void HalfEdgeMesh::SetUW( int n, const vec2d & uw )
+{
+    m_U[ n ] = uw.x();
+    m_W[ n ] = uw.y();
+}
+
+//==== Construction ====//
+int HalfEdgeMesh::AddNode( const vec3d &p, const vec2d &uw, bool fixed )
+{
+    int n = NewNode();
+    SetPnt( n, p );
+    SetUW( n, uw );
+    m_NodeFixed[ n ] = fixed;
+    return n;
+}
+
+int HalfEdgeMesh::AddEdge()
+{
+    return NewEdge();
+}
+
+int HalfEdgeMesh::AddFace( int n0, int n1, int n2, int e0, int e1, int e2 )
+{
+    int f = NewFace();
+    SetFace( f, n0, n1, n2 );
+
+    int ev[3] = { e0, e1, e2 };
+    for ( int k = 0; k < 3; k++ )
+    {
+        int h = 3 * f + k;
+        int e = ev[ k ];
+        m_HEEdge[ h ] = e;
+
+        int other = m_EdgeHE[ e ];
+        if ( other < 0 )
+        {
+            m_EdgeHE[ e ] = h;
+        }
+        else if ( m_HETwin[ other ] < 0 )
+        {
+            m_HETwin[ h ] = other;
+            m_HETwin[ other ] = h;
+        }
+        else
+        {
+            printf( "HalfEdgeMesh: More Than 2 Faces On Edge %d\n", e );
+        }
+    }
+    return f;
+}
+
+//==== Topology Queries ====//
+void HalfEdgeMesh::GetNodeRing( int n, vector< int > & faces, vector< int > & edges ) const
+{
+    faces.clear();
+    edges.clear();
+
+    int h0 = m_NodeHE[ n ];
+    if ( h0 < 0 )
+    {
+        return;
+    }
+
+    const int max_ring = 1024;
+
+    //==== Rotate Through Twin of Incoming Half-Edge ====//
+    bool open = false;
+    int h = h0;
+    while ( ( int )faces.size() < max_ring )
+    {
+        faces.push_back( HEFace( h ) );
+        edges.push_back( m_HEEdge[ h ] );
+
+        int hp = Prev( h );
+        int t = m_HETwin[ hp ];
+        if ( t < 0 )
+        {
+            edges.push_back( m_HEEdge[ hp ] );
+            open = true;
+            break;
+        }
+        if ( t == h0 )
+        {
+            break;
+        }
+        h = t;
+    }
+
+    //==== Boundary Node - Rotate Back The Other Way ====//
+    if ( open )
+    {
+        h = h0;
+        while ( ( int )faces.size() < max_ring )
+        {
+            int t = m_HETwin[ h ];
+            if ( t < 0 )
+            {
+                break;
+            }
+            h = Next( t );
+            faces.push_back( HEFace( h ) );
+            edges.push_back( m_HEEdge[ h ] );
+        }
+    }
+}
+
+void HalfEdgeMesh::GetEdgeNodes( int e, int & n0, int & n1 ) const
+{
+    int h = m_EdgeHE[ e ];
+    n0 = Origin( h );
+    n1 = Target( h );
+}
+
+int HalfEdgeMesh::OtherFaceNode( int f, int n0, int n1 ) const
+{
+    for ( int k = 0; k < 3; k++ )
+    {
+        int n = m_FaceNode[ 3 * f + k ];
+        if ( n != n0 && n != n1 )
+        {
+            return n;
+        }
+    }
+    return -1;
+}
+
+int HalfEdgeMesh::FindShortEdge( int f ) const
+{
+    int e = -1;
+    double dmin = DBL_MAX;
+    for ( int k = 0; k < 3; k++ )
+    {
+        int h = 3 * f + k;
+        double d = dist_squared( GetPnt( Origin( h ) ), GetPnt( Target( h ) ) );
+        if ( d < dmin )
+        {
+            dmin = d;
+            e = m_HEEdge[ h ];
+        }
+    }
+    return e;
+}
+
+double HalfEdgeMesh::EdgeLength( int e ) const
+{
+    int n0, n1;
+    GetEdgeNodes( e, n0, n1 );
+    return dist( GetPnt( n0 ), GetPnt( n1 ) );
+}
+
+double HalfEdgeMesh::FaceArea( int f ) const
+{
+    return area( GetPnt( m_FaceNode[ 3 * f ] ), GetPnt( m_FaceNode[ 3 * f + 1 ] ), GetPnt( m_FaceNode[ 3 * f + 2 ] ) );
+}
+
+vec3d HalfEdgeMesh::FaceNormal( int f ) const
+{
+    vec3d p0 = GetPnt( m_FaceNode[ 3 * f ] );
+    return cross( GetPnt( m_FaceNode[ 3 * f + 1 ] ) - p0, GetPnt( m_FaceNode[ 3 * f + 2 ] ) - p0 );
+}
+
+double HalfEdgeMesh::ComputeTriQual( const vec3d & p0, const vec3d & p1, const vec3d & p2 )
+{
+    double dsqr01 = dist_squared( p0, p1 );
+    double dsqr12 = dist_squared( p1, p2 );
+    double dsqr20 = dist_squared( p2, p0 );
+
+    double d01 = sqrt( dsqr01 );
+    double d12 = sqrt( dsqr12 );
+    double d20 = sqrt( dsqr20 );
+
+    double ang0 = ( -dsqr12 + dsqr01 + dsqr20 ) / ( 2.0 * d01 * d20 );
+    double ang1 = ( -dsqr20 + dsqr01 + dsqr12 ) / ( 2.0 * d01 * d12 );
+    double ang2 = ( -dsqr01 + dsqr12 + dsqr20 ) / ( 2.0 * d12 * d20 );
+
+    double minang = max( ang0, max( ang1, ang2 ) );
+
+    if ( minang > 1.0 )
+    {
+        return 0.0;
+    }
+    else if ( minang < -1.0 )
+    {
+        return M_PI;
+    }
+
+    return acos( minang );
+}
+
+//==== Remesh Operators ====//
+void HalfEdgeMesh::Remesh()
+{
+    int num_split = 1;
+    int num_collapse = 1;
+
+    //==== Find Target Edge Lengths ====//
+    for ( int e = 0; e < GetNumEdgeSlots(); e++ )
+    {
+        if ( m_EdgeAlive[ e ] )
+        {
+            ComputeLength( e );
+            ComputeTargetEdgeLength( e );
+        }
+    }
+
+    LimitTargetEdgeLength();
+
+    for ( int i = 0 ; i < 20 ; i++ )
+    {
+        if ( num_split )
+        {
+            num_split = Split( 1 );
+        }
+        if ( num_collapse )
+        {
+            num_collapse = Collapse( 1 );
+        }
+    }
+
+    int nedge = GetNumEdgeSlots();
+    for ( int e = 0; e < nedge; e++ )
+    {
+        if ( m_EdgeAlive[ e ] && !m_EdgeBorder[ e ] )
+        {
+            SwapEdge( e );
+        }
+    }
+
+    LaplacianSmooth( 2 );
+}
+
+int HalfEdgeMesh::Split( int num_iter )
+{
+    int num_long_edges = 0;
+    for ( int iter = 0 ; iter < num_iter ; iter++ )
+    {
+        //===== Split ====//
+        vector < pair < int, double > > longEdges;
+        longEdges.reserve( GetNumEdgeSlots() );
+        for ( int e = 0; e < GetNumEdgeSlots(); e++ )
+        {
+            if ( m_EdgeAlive[ e ] && !m_EdgeBorder[ e ] )
+            {
+                double rat = m_EdgeLength[ e ] / m_EdgeTargetLen[ e ];
+                if ( rat > 1.41 )
+                {
+                    longEdges.emplace_back( e, rat );
+                }
+            }
+        }
+
+        //==== Sort Matches By Length ====//
+        sort( longEdges.begin(), longEdges.end(), LongEdgeIndexCompare );
+
+        int num_split = longEdges.size() / 10;
+
+        for ( int i = 0 ; i < num_split ; i++ )
+        {
+            int e = longEdges[i].first;
+            if ( m_EdgeAlive[ e ] )
+            {
+                ComputeLength( e );
+                SplitEdge( e );
+            }
+        }
+
+        num_long_edges = longEdges.size();
+    }
+    DumpGarbage();
+
+    return num_long_edges;
+}
+
+int HalfEdgeMesh::Collapse( int num_iter )
+{
+    int num_short_edges = 0;
+    for ( int iter = 0 ; iter < num_iter ; iter++ )
+    {
+        //==== Collapse =====//
+        vector < pair < int, double > > shortEdges;
+        shortEdges.reserve( GetNumEdgeSlots() );
+        for ( int e = 0; e < GetNumEdgeSlots(); e++ )
+        {
+            if ( ValidCollapse( e ) )
+            {
+                double rat = m_EdgeLength[ e ] / m_EdgeTargetLen[ e ];
+                if ( rat < 0.707 )
+                {
+                    shortEdges.emplace_back( e, rat );
+                }
+            }
+        }
+
+        //==== Sort Matches By Length ====//
+        sort( shortEdges.begin(), shortEdges.end(), ShortEdgeIndexCompare );
+
+        int num_colapse = shortEdges.size() / 10;
+
+        num_short_edges = 0;
+        for ( int i = 0 ; i < num_colapse ; i++ )
+        {
+            int e = shortEdges[i].first;
+
+            // Removed edges keep their slot until DumpGarbage, so a stale
+            // index here is always caught by ValidCollapse.
+            if ( ValidCollapse( e ) )
+            {
+                ComputeLength( e );
+                num_short_edges++;
+                CollapseEdge( e );
+            }
+        }
+    }
+
+    DumpGarbage();
+
+    return num_short_edges;
+}
+
+int HalfEdgeMesh::RemoveRevFaces()
+{
+    int badcount = 0;
+
+    vector < int > remEdges;
+
+    for ( int f = 0; f < GetNumFaceSlots(); f++ )
+    {
+        if ( !m_FaceAlive[ f ] )
+        {
+            continue;
+        }
+
+        vec3d nface = FaceNormal( f );
+
+        vec2d avg_uw = ( GetUW( m_FaceNode[ 3 * f ] ) + GetUW( m_FaceNode[ 3 * f + 1 ] ) + GetUW( m_FaceNode[ 3 * f + 2 ] ) ) * ( 1.0 / 3.0 );
+        vec3d nsurf = m_Surf->CompNorm( avg_uw[0], avg_uw[1] );
+
+        double dprod = dot ( nface, nsurf );
+
+        if ( m_Surf->GetFlipFlag() )
+        {
+            dprod = -dprod;
+        }
+
+        if ( dprod < 0.0 )
+        {
+            int e = FindShortEdge( f );
+
+            if ( e >= 0 )
+            {
+                remEdges.push_back( e );
+
+                badcount++;
+            }
+        }
+    }
+
+    for ( int i = 0; i < ( int )remEdges.size(); i++ )
+    {
+        if ( ValidCollapse( remEdges[i] ) )
+        {
+            CollapseEdge( remEdges[i] );
+        }
+    }
+
+    return badcount;
+}
+
+void HalfEdgeMesh::SplitEdge( int e )
+{
+    assert( m_Surf );
+
+    if ( m_EdgeBorder[ e ] )                // Dont Split Borders
+    {
+        return;
+    }
+
+    int h = m_EdgeHE[ e ];
+    int t = m_HETwin[ h ];
+
+    int fa = HEFace( h );
+    int fb = ( t >= 0 ) ? HEFace( t ) : -1;
+
+    // Half-edge h runs n0 -> n1 in fa, so n0, n1 are already in fa's order.
+    int n0 = Origin( h );
+    int n1 = Target( h );
+
+    vec3d psplit  = ( GetPnt( n0 ) + GetPnt( n1 ) ) * 0.5; // Split
+    vec2d uwsplit = ( GetUW( n0 ) + GetUW( n1 ) ) * 0.5;
+
+    vec2d uws = m_Surf->ClosestUW( psplit, uwsplit[0], uwsplit[1] );
+    vec3d ps  = m_Surf->CompPnt( uws.x(), uws.y() );
+
+    //==== Gather Existing Topology Before Rewriting Faces ====//
+    int ha1 = Next( h );        // n1 -> na
+    int ha0 = Prev( h );        // na -> n0
+    int na = Origin( ha0 );
+    int ea1 = m_HEEdge[ ha1 ];
+    int oa1 = m_HETwin[ ha1 ];
+    int ea0 = m_HEEdge[ ha0 ];
+    int oa0 = m_HETwin[ ha0 ];
+
+    int nb = -1, eb0 = -1, ob0 = -1, eb1 = -1, ob1 = -1;
+    if ( fb >= 0 )
+    {
+        int hb0 = Next( t );    // n0 -> nb
+        int hb1 = Prev( t );    // nb -> n1
+        nb = Origin( hb1 );
+        eb0 = m_HEEdge[ hb0 ];
+        ob0 = m_HETwin[ hb0 ];
+        eb1 = m_HEEdge[ hb1 ];
+        ob1 = m_HETwin[ hb1 ];
+    }
+
+    int ns  = AddNode( ps, uws );
+    int es0 = NewEdge();
+    int es1 = NewEdge();
+    m_EdgeRidge[ es0 ] = m_EdgeRidge[ e ];
+    m_EdgeRidge[ es1 ] = m_EdgeRidge[ e ];
+
+    int ea = NewEdge();
+    int fa1 = NewFace();
+
+    int eb = -1, fb1 = -1;
+    if ( fb >= 0 )
+    {
+        eb = NewEdge();
+        fb1 = NewFace();
+    }
+
+    //==== fa -> ( n0, ns, na ) + ( n1, na, ns ) ====//
+    SetFace( fa, n0, ns, na );
+    SetFace( fa1, n1, na, ns );
+
+    SetHalfEdge( 3 * fa, es0, fb >= 0 ? 3 * fb + 2 : -1 );
+    SetHalfEdge( 3 * fa + 1, ea, 3 * fa1 + 1 );
+    SetHalfEdge( 3 * fa + 2, ea0, oa0 );
+
+    SetHalfEdge( 3 * fa1, ea1, oa1 );
+    SetHalfEdge( 3 * fa1 + 1, ea, 3 * fa + 1 );
+    SetHalfEdge( 3 * fa1 + 2, es1, fb >= 0 ? 3 * fb1 : -1 );
+
+    //==== fb -> ( n0, nb, ns ) + ( n1, ns, nb ) ====//
+    if ( fb >= 0 )
+    {
+        SetFace( fb, n0, nb, ns );
+        SetFace( fb1, n1, ns, nb );
+
+        SetHalfEdge( 3 * fb, eb0, ob0 );
+        SetHalfEdge( 3 * fb + 1, eb, 3 * fb1 + 1 );
+        SetHalfEdge( 3 * fb + 2, es0, 3 * fa );
+
+        SetHalfEdge( 3 * fb1, es1, 3 * fa1 + 2 );
+        SetHalfEdge( 3 * fb1 + 1, eb, 3 * fb + 1 );
+        SetHalfEdge( 3 * fb1 + 2, eb1, ob1 );
+
+        ComputeLength( eb );
+    }
+
+    ComputeLength( es0 );
+    ComputeLength( es1 );
+    ComputeLength( ea );
+
+    RemoveEdge( e );
+
+    ComputeTargetEdgeLengthNode( ns );
+    LimitTargetEdgeLengthNode( ns );
+}
+
+void HalfEdgeMesh::SwapEdge( int e )
+{
+    if ( e < 0 || !m_EdgeAlive[ e ] )
+    {
+        return;
+    }
+
+    if ( m_EdgeBorder[ e ] )
+    {
+        return;
+    }
+
+    int h = m_EdgeHE[ e ];
+    int t = m_HETwin[ h ];
+
+    if ( t < 0 )
+    {
+        return;
+    }
+
+    int fa = HEFace( h );
+    int fb = HEFace( t );
+
+    if ( ThreeEdgesThreeFaces( e ) )
+    {
+        return;
+    }
+
+    int n0 = Origin( h );
+    int n1 = Target( h );
+    int na = Origin( Prev( h ) );
+    int nb = Origin( Prev( t ) );
+
+    assert( na != nb );
+
+    if ( na == nb )
+    {
+        return;
+    }
+
+    vec3d p0 = GetPnt( n0 );
+    vec3d p1 = GetPnt( n1 );
+    vec3d pa = GetPnt( na );
+    vec3d pb = GetPnt( nb );
+
+    //==== Determine Face Quality of Existing Faces =====//
+    double qa = ComputeTriQual( p0, p1, pa );
+    double qb = ComputeTriQual( p1, p0, pb );
+    double qc = ComputeTriQual( p0, pb, pa );
+    double qd = ComputeTriQual( p1, pa, pb );
+
+    if ( min( qc, qd ) <= min( qa, qb ) )
+    {
+        return;
+    }
+
+    vec3d norma = FaceNormal( fa );
+    vec3d normb = FaceNormal( fb );
+    vec3d normc = cross( pb - p0, pa - p0 );
+    vec3d normd = cross( pa - p1, pb - p1 );
+
+    double angab = angle( norma, normb );
+
+    if ( angab > 0.25 * M_PI_4  )
+    {
+        return;
+    }
+
+    double angcd = angle( normc, normd );
+
+    if ( angcd > 0.25 * M_PI_4  )
+    {
+        return;
+    }
+
+    double angac = angle( norma, normc );
+
+    if ( angac > 0.25 * M_PI_4 )
+    {
+        return;
+    }
+
+    int ha1 = Next( h );        // n1 -> na
+    int ha0 = Prev( h );        // na -> n0
+    int hb0 = Next( t );        // n0 -> nb
+    int hb1 = Prev( t );        // nb -> n1
+
+    int ea1 = m_HEEdge[ ha1 ];
+    int oa1 = m_HETwin[ ha1 ];
+    int ea0 = m_HEEdge[ ha0 ];
+    int oa0 = m_HETwin[ ha0 ];
+    int eb0 = m_HEEdge[ hb0 ];
+    int ob0 = m_HETwin[ hb0 ];
+    int eb1 = m_HEEdge[ hb1 ];
+    int ob1 = m_HETwin[ hb1 ];
+
+    //==== fa -> ( n0, nb, na ), fb -> ( n1, na, nb ) ====//
+    SetFace( fa, n0, nb, na );
+    SetFace( fb, n1, na, nb );
+
+    SetHalfEdge( 3 * fa, eb0, ob0 );
+    SetHalfEdge( 3 * fa + 1, e, 3 * fb + 1 );
+    SetHalfEdge( 3 * fa + 2, ea0, oa0 );
+
+    SetHalfEdge( 3 * fb, ea1, oa1 );
+    SetHalfEdge( 3 * fb + 1, e, 3 * fa + 1 );
+    SetHalfEdge( 3 * fb + 2, eb1, ob1 );
+
+    ComputeLength( e );
+    ComputeTargetEdgeLength( e );
+
+    LimitTargetEdgeLength( e );
+}
+
+bool HalfEdgeMesh::ThreeEdgesThreeFaces( int e )
+{
+    int n0, n1;
+    GetEdgeNodes( e, n0, n1 );
+
+    vector< int > faces, edges;
+    GetNodeRing( n0, faces, edges );
+    if ( faces.size() == 3 && edges.size() == 3 )
+    {
+        return true;
+    }
+
+    GetNodeRing( n1, faces, edges );
+
+    return faces.size() == 3 && edges.size() == 3;
+}
+
+bool HalfEdgeMesh::ValidCollapse( int e )
+{
+    if ( e < 0 || !m_EdgeAlive[ e ] )
+    {
+        return false;
+    }
+
+    if ( m_EdgeBorder[ e ] || m_EdgeRidge[ e ] )
+    {
+        return false;
+    }
+
+    int h = m_EdgeHE[ e ];
+    int t = m_HETwin[ h ];
+
+    if ( t < 0 )
+    {
+        return false;
+    }
+
+    int n0 = Origin( h );
+    int n1 = Target( h );
+
+    if ( m_NodeFixed[ n0 ] && m_NodeFixed[ n1 ] )
+    {
+        return false;
+    }
+
+    int fa = HEFace( h );
+    int fb = HEFace( t );
+
+    if ( !m_FaceAlive[ fa ] || !m_FaceAlive[ fb ] )
+    {
+        return false;
+    }
+
+    int na = Origin( Prev( h ) );
+    int nb = Origin( Prev( t ) );
+
+    //==== Check 3 Faces in a Face Case =====//
+    int ta0 = m_HETwin[ Prev( h ) ];  // Across na - n0
+    int ta1 = m_HETwin[ Next( h ) ];  // Across n1 - na
+
+    if ( ta0 >= 0 && ta1 >= 0 )
+    {
+        int na0 = OtherFaceNode( HEFace( ta0 ), n0, na );
+        int na1 = OtherFaceNode( HEFace( ta1 ), n1, na );
+
+        if ( na0 == na1 )
+        {
+            return false;
+        }
+    }
+
+    int tb0 = m_HETwin[ Next( t ) ];  // Across n0 - nb
+    int tb1 = m_HETwin[ Prev( t ) ];  // Across nb - n1
+
+    if ( tb0 >= 0 && tb1 >= 0 )
+    {
+        int nb0 = OtherFaceNode( HEFace( tb0 ), n0, nb );
+        int nb1 = OtherFaceNode( HEFace( tb1 ), n1, nb );
+
+        if ( nb0 == nb1 )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool HalfEdgeMesh::ValidNodeMove( int n, const vec3d & move_to, int ignore_face )
+{
+    bool valid_flag = true;
+    vector< int > faces, edges;
+    GetNodeRing( n, faces, edges );
+
+    vector < vec3d > normals;
+    normals.reserve( faces.size() );
+    for ( int i = 0 ; i < ( int )faces.size() ; i++ )
+    {
+        if ( faces[i] != ignore_face )
+        {
+            normals.push_back( FaceNormal( faces[i] ) );
+        }
+    }
+
+    vec3d save_pos = GetPnt( n );
+    SetPnt( n, move_to );
+
+    int cnt = 0;
+    for ( int i = 0 ; i < ( int )faces.size() ; i++ )
+    {
+        if ( faces[i] != ignore_face )
+        {
+            if ( angle( normals[cnt], FaceNormal( faces[i] ) ) >= 0.5 * M_PI_4 )
+            {
+                valid_flag = false;
+                break;
+            }
+            cnt++;
+        }
+    }
+
+    SetPnt( n, save_pos );
+
+    return valid_flag;
+}
+
+void HalfEdgeMesh::CollapseEdge( int e )
+{
+    int h = m_EdgeHE[ e ];
+    int t = m_HETwin[ h ];
+
+    if ( t < 0 )
+    {
+        return;
+    }
+
+    int fa = HEFace( h );
+    int fb = HEFace( t );
+
+    int n0 = Origin( h );
+    int n1 = Target( h );
+    int na = Origin( Prev( h ) );
+    int nb = Origin( Prev( t ) );
+
+    assert( na != nb );
+
+    // fa: h n0->n1, Next(h) n1->na, Prev(h) na->n0
+    // fb: t n1->n0, Next(t) n0->nb, Prev(t) nb->n1
+    int ea0 = m_HEEdge[ Prev( h ) ];
+    int ea1 = m_HEEdge[ Next( h ) ];
+    int eb0 = m_HEEdge[ Next( t ) ];
+    int eb1 = m_HEEdge[ Prev( t ) ];
+
+    int oa0 = m_HETwin[ Prev( h ) ];  // n0 -> na in fa0
+    int oa1 = m_HETwin[ Next( h ) ];  // na -> n1 in fa1
+    int ob0 = m_HETwin[ Next( t ) ];  // nb -> n0 in fb0
+    int ob1 = m_HETwin[ Prev( t ) ];  // n1 -> nb in fb1
+
+    if ( oa0 < 0 || oa1 < 0 || ob0 < 0 || ob1 < 0 )
+    {
+        return;
+    }
+
+    vec3d pc;
+    vec2d uwc;
+    if ( m_NodeFixed[ n0 ] )
+    {
+        pc = GetPnt( n0 );
+        uwc = GetUW( n0 );
+    }
+    else if ( m_NodeFixed[ n1 ] )
+    {
+        pc = GetPnt( n1 );
+        uwc = GetUW( n1 );
+    }
+    else
+    {
+        vec3d psplit = ( GetPnt( n0 ) + GetPnt( n1 ) ) * 0.5;
+        vec2d uwsplit = ( GetUW( n0 ) + GetUW( n1 ) ) * 0.5;
+        uwc = m_Surf->ClosestUW( psplit, uwsplit[0], uwsplit[1] );
+        pc  = m_Surf->CompPnt( uwc.x(), uwc.y() );
+    }
+
+    if ( !ValidNodeMove( n0, pc, fa ) )
+    {
+        return;
+    }
+    if ( !ValidNodeMove( n1, pc, fb ) )
+    {
+        return;
+    }
+
+    //==== Faces That Point To n0 or n1 ====//
+    vector< int > faces0, faces1, edges;
+    GetNodeRing( n0, faces0, edges );
+    GetNodeRing( n1, faces1, edges );
+
+    int nc = AddNode( pc, uwc, m_NodeFixed[ n0 ] || m_NodeFixed[ n1 ] );
+
+    int eca = NewEdge();
+    int ecb = NewEdge();
+
+    if ( m_EdgeBorder[ ea0 ] || m_EdgeBorder[ ea1 ] )
+    {
+        m_EdgeBorder[ eca ] = true;
+
+        if ( m_EdgeSplitNode[ ea0 ] >= 0 )
+        {
+            m_EdgeSplitNode[ eca ] = m_EdgeSplitNode[ ea0 ];
+            m_EdgeSplitNode[ ea0 ] = -1;
+        }
+
+        if ( m_EdgeSplitNode[ ea1 ] >= 0 )
+        {
+            m_EdgeSplitNode[ eca ] = m_EdgeSplitNode[ ea1 ];
+            m_EdgeSplitNode[ ea1 ] = -1;
+        }
+    }
+    if ( m_EdgeBorder[ eb0 ] || m_EdgeBorder[ eb1 ] )
+    {
+        m_EdgeBorder[ ecb ] = true;
+
+        if ( m_EdgeSplitNode[ eb0 ] >= 0 )
+        {
+            m_EdgeSplitNode[ ecb ] = m_EdgeSplitNode[ eb0 ];
+            m_EdgeSplitNode[ eb0 ] = -1;
+        }
+
+        if ( m_EdgeSplitNode[ eb1 ] >= 0 )
+        {
+            m_EdgeSplitNode[ ecb ] = m_EdgeSplitNode[ eb1 ];
+            m_EdgeSplitNode[ eb1 ] = -1;
+        }
+    }
+    if ( m_EdgeRidge[ ea0 ] || m_EdgeRidge[ ea1 ] )
+    {
+        m_EdgeRidge[ eca ] = true;
+    }
+    if ( m_EdgeRidge[ eb0 ] || m_EdgeRidge[ eb1 ] )
+    {
+        m_EdgeRidge[ ecb ] = true;
+    }
+
+    //==== Outer Half-Edges Become Twins Across The New Edges ====//
+    SetHalfEdge( oa0, eca, oa1 );
+    SetHalfEdge( oa1, eca, oa0 );
+    SetHalfEdge( ob0, ecb, ob1 );
+    SetHalfEdge( ob1, ecb, ob0 );
+
+    //==== Change Any Faces That Point to n0 or n1 ====//
+    for ( int i = 0 ; i < ( int )faces0.size() ; i++ )
+    {
+        int f = faces0[i];
+        for ( int k = 0; k < 3; k++ )
+        {
+            if ( m_FaceNode[ 3 * f + k ] == n0 )
+            {
+                m_FaceNode[ 3 * f + k ] = nc;
+            }
+        }
+    }
+    for ( int i = 0 ; i < ( int )faces1.size() ; i++ )
+    {
+        int f = faces1[i];
+        for ( int k = 0; k < 3; k++ )
+        {
+            if ( m_FaceNode[ 3 * f + k ] == n1 )
+            {
+                m_FaceNode[ 3 * f + k ] = nc;
+            }
+        }
+    }
+
+    m_NodeHE[ nc ] = oa0;
+    m_NodeHE[ na ] = oa1;
+    m_NodeHE[ nb ] = ob0;
+
+    RemoveEdge( e );
+    RemoveNode( n0 );
+    RemoveNode( n1 );
+    RemoveEdge( ea0 );
+    RemoveEdge( ea1 );
+    RemoveEdge( eb0 );
+    RemoveEdge( eb1 );
+    RemoveFace( fa );
+    RemoveFace( fb );
+
+    ComputeLength( eca );
+    ComputeLength( ecb );
+
+    ComputeTargetEdgeLengthNode( nc );
+    LimitTargetEdgeLengthNode( nc );
+}
+
+void HalfEdgeMesh::LaplacianSmooth( int num_iter )
+{
+    for ( int i = 0 ; i < num_iter ; i++ )
+    {
+        for ( int n = 0; n < GetNumNodeSlots(); n++ )
+        {
+            if ( m_NodeAlive[ n ] && !m_NodeFixed[ n ] )
+            {
+                AreaWeightedLaplacianSmooth( n );
+            }
+        }
+    }
+}
+
+void HalfEdgeMesh::AreaWeightedLaplacianSmooth( int n )
+{
+    vector< int > faces, edges;
+    GetNodeRing( n, faces, edges );
+
+    vector< double > areas( faces.size() );
+
+    double sum_area = 0.0;
+    for ( int i = 0 ; i < ( int )faces.size() ; i++ )
+    {
+        areas[i] = FaceArea( faces[i] );
+        sum_area += areas[i];
+    }
+
+    if ( sum_area < 1.0e-12 )
+    {
+        return;
+    }
+
+    vec3d movePnt = vec3d( 0, 0, 0 );
+    vec2d moveUW  = vec2d( 0, 0 );
+    double k2 = 1.0 / ( 3.0 * sum_area );
+    for ( int i = 0 ; i < ( int )faces.size() ; i++ )
+    {
+        double k = k2 * areas[i];
+        int f = faces[i];
+        for ( int j = 0; j < 3; j++ )
+        {
+            int m = m_FaceNode[ 3 * f + j ];
+            movePnt = movePnt + GetPnt( m ) * k;
+            moveUW = moveUW + GetUW( m ) * k;
+        }
+    }
+
+    // See Node::AreaWeightedLaplacianSmooth() for notes on the 1/10th lag.
+    vec2d uw = GetUW( n );
+    vec2d close_uw = m_Surf->ClosestUW( movePnt, moveUW.x(),  moveUW.y() );
+
+    uw = uw + ( close_uw - uw ) * 0.1;
+    SetUW( n, uw );
+    SetPnt( n, m_Surf->CompPnt( uw.x(), uw.y() ) );
+}
+
+//==== Target Edge Lengths ====//
+void HalfEdgeMesh::ComputeTargetEdgeLengthNode( int n )
+{
+    vector< int > faces, edges;
+    GetNodeRing( n, faces, edges );
+
+    for( int i = 0; i < ( int )edges.size(); i++ )
+    {
+        ComputeTargetEdgeLength( edges[i] );
+    }
+}
+
+void HalfEdgeMesh::ComputeTargetEdgeLength( int e )
+{
+    assert( m_GridDensity );
+
+    if( m_EdgeBorder[ e ] && m_EdgeLength[ e ] > m_GridDensity->m_MinLen )
+    {
+        m_EdgeTargetLen[ e ] = m_EdgeLength[ e ];
+    }
+    else
+    {
+        int n0, n1;
+        GetEdgeNodes( e, n0, n1 );
+        vec2d uwcent = ( GetUW( n0 ) + GetUW( n1 ) ) * 0.5;
+
+        int reason = -1;
+        m_EdgeTargetLen[ e ] = m_Surf->InterpTargetMap( uwcent.x(), uwcent.y(), reason );
+    }
+}
+
+void HalfEdgeMesh::LimitTargetEdgeLengthNode( int n )
+{
+    vector< int > faces, edges;
+    GetNodeRing( n, faces, edges );
+
+    if ( edges.empty() )
+    {
+        return;
+    }
+
+    for( int i = 0; i < ( int )edges.size(); i++ )
+    {
+        LimitTargetEdgeLength( edges[i], n );
+    }
+
+    double minlen = m_EdgeTargetLen[ edges[0] ];
+    for( int i = 1; i < ( int )edges.size(); i++ )
+    {
+        minlen = min( minlen, m_EdgeTargetLen[ edges[i] ] );
+    }
+
+    double limitlen = minlen * m_GridDensity->m_GrowRatio;
+
+    for( int i = 0; i < ( int )edges.size(); i++ )
+    {
+        if ( m_EdgeTargetLen[ edges[i] ] > limitlen )
+        {
+            m_EdgeTargetLen[ edges[i] ] = limitlen;
+        }
+    }
+}
+
+void HalfEdgeMesh::LimitTargetEdgeLength( int e, int notn )
+{
+    double growratio = m_GridDensity->m_GrowRatio;
+
+    int n0, n1;
+    GetEdgeNodes( e, n0, n1 );
+    int n = ( n0 == notn ) ? n1 : n0;
+
+    vector< int > faces, edges;
+    GetNodeRing( n, faces, edges );
+
+    for ( int i = 0; i < ( int )edges.size(); i++ )
+    {
+        double limitlen = growratio * m_EdgeTargetLen[ edges[i] ];
+        if( m_EdgeTargetLen[ e ] > limitlen )
+        {
+            m_EdgeTargetLen[ e ] = limitlen;
+        }
+    }
+}
+
+void HalfEdgeMesh::LimitTargetEdgeLength( int e )
+{
+    double growratio = m_GridDensity->m_GrowRatio;
+
+    int nv[2];
+    GetEdgeNodes( e, nv[0], nv[1] );
+
+    vector< int > faces, edges;
+    for ( int j = 0; j < 2; j++ )
+    {
+        GetNodeRing( nv[j], faces, edges );
+
+        for ( int i = 0; i < ( int )edges.size(); i++ )
+        {
+            double limitlen = growratio * m_EdgeTargetLen[ edges[i] ];
+            if( m_EdgeTargetLen[ e ] > limitlen )
+            {
+                m_EdgeTargetLen[ e ] = limitlen;
+            }
+        }
+    }
+}
+
+void HalfEdgeMesh::LimitTargetEdgeLength()
+{
+    double growratio = m_GridDensity->m_GrowRatio;
+
+    vector< pair< int, double > > order;
+    order.reserve( GetNumEdgeSlots() );
+    for ( int e = 0; e < GetNumEdgeSlots(); e++ )
+    {
+        if ( m_EdgeAlive[ e ] )
+        {
+            order.emplace_back( e, m_EdgeTargetLen[ e ] );
+        }
+    }
+
+    sort( order.begin(), order.end(), ShortEdgeIndexCompare );
+
+    vector< int > faces, edges;
+    for ( int i = 0; i < ( int )order.size(); i++ )
+    {
+        int e = order[i].first;
+        double limitlen = growratio * m_EdgeTargetLen[ e ];
+
+        int nv[2];
+        GetEdgeNodes( e, nv[0], nv[1] );
+
+        for ( int j = 0; j < 2; j++ )
+        {
+            GetNodeRing( nv[j], faces, edges );
+
+            for ( int k = 0; k < ( int )edges.size(); k++ )
+            {
+                int ne = edges[k];
+                if ( !m_EdgeBorder[ ne ] && m_EdgeTargetLen[ ne ] > limitlen )
+                {
+                    m_EdgeTargetLen[ ne ] = limitlen;
+                }
+            }
+        }
+    }
+}
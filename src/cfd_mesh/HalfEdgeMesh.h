@@ -0,0 +1,294 @@
+//
+// This file is released under the terms of the NASA Open Source Agreement (NOSA)
+// version 1.3 as detailed in the LICENSE file which accompanies this software.
+//
+
+//////////////////////////////////////////////////////////////////////
+// HalfEdgeMesh.h
+//
+// Compact, index based half-edge triangle mesh used as the working core of
+// Mesh::Remesh().  Node coordinates are stored as separate x, y, z, u, w
+// arrays.  Triangles own three consecutive half-edges (h = 3 * face + k), so
+// next/prev are implicit and only the twin and edge of each half-edge are
+// stored.  Removed entities are parked in garbage lists until DumpGarbage()
+// recycles their slots, mirroring the deferred delete semantics of Mesh.
+//
+// The whole structure is a handful of flat vectors, so a snapshot of a mesh
+// is simply a copy of the object.
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(HALFEDGEMESH_HALFEDGEMESH__INCLUDED_)
+#define HALFEDGEMESH_HALFEDGEMESH__INCLUDED_
+
+#include "Vec2d.h"
+#include "Vec3d.h"
+
+#include <vector>
+using namespace std;
+
+class Surf;
+class SimpleGridDensity;
+class GeomHash;
+
+//////////////////////////////////////////////////////////////////////
+class HalfEdgeMesh
+{
+public:
+
+    HalfEdgeMesh();
+    virtual ~HalfEdgeMesh();
+
+    void Clear();
+
+    void SetSurfPtr( Surf* sptr )
+    {
+        m_Surf = sptr;
+    }
+    void SetGridDensityPtr( SimpleGridDensity* gptr )
+    {
+        m_GridDensity = gptr;
+    }
+
+    //==== Construction ====//
+    int AddNode( const vec3d &p, const vec2d &uw, bool fixed = false );
+    int AddEdge();
+    // Edge ek must join node nk to node n(k+1)%3.
+    int AddFace( int n0, int n1, int n2, int e0, int e1, int e2 );
+
+    void Reserve( int num_nodes, int num_edges, int num_faces );
+
+    //==== Remesh Operators ====//
+    void Remesh();
+    int RemoveRevFaces();
+
+    int Split( int num_iter );
+    void SplitEdge( int e );
+
+    bool ThreeEdgesThreeFaces( int e );
+    void SwapEdge( int e );
+
+    int Collapse( int num_iter );
+    bool ValidCollapse( int e );
+    void CollapseEdge( int e );
+
+    void LimitTargetEdgeLength();
+    void LimitTargetEdgeLength( int e );
+    void LimitTargetEdgeLength( int e, int notn );
+    void LimitTargetEdgeLengthNode( int n );
+
+    void ComputeTargetEdgeLength( int e );
+    void ComputeTargetEdgeLengthNode( int n );
+
+    void LaplacianSmooth( int num_iter );
+    void AreaWeightedLaplacianSmooth( int n );
+
+    bool ValidNodeMove( int n, const vec3d & move_to, int ignore_face = -1 );
+
+    void DumpGarbage();
+
+    //==== Snapshots ====//
+    // Hash and compare everything that determines the result of Remesh(),
+    // including free and garbage slots.  Surf and grid density are not included.
+    void AddHash( GeomHash & hash ) const;
+    bool SameAs( const HalfEdgeMesh & hem ) const;
+
+    //==== Topology Queries ====//
+    static int Next( int h )
+    {
+        return ( h % 3 == 2 ) ? h - 2 : h + 1;
+    }
+    static int Prev( int h )
+    {
+        return ( h % 3 == 0 ) ? h + 2 : h - 1;
+    }
+    static int HEFace( int h )
+    {
+        return h / 3;
+    }
+    int Origin( int h ) const
+    {
+        return m_FaceNode[ h ];
+    }
+    int Target( int h ) const
+    {
+        return m_FaceNode[ Next( h ) ];
+    }
+    int Twin( int h ) const
+    {
+        return m_HETwin[ h ];
+    }
+    int HEEdge( int h ) const
+    {
+        return m_HEEdge[ h ];
+    }
+
+    // Faces and edges around node n.  Boundary nodes are handled.
+    void GetNodeRing( int n, vector< int > & faces, vector< int > & edges ) const;
+    void GetEdgeNodes( int e, int & n0, int & n1 ) const;
+    int OtherFaceNode( int f, int n0, int n1 ) const;
+    int FindShortEdge( int f ) const;
+
+    double EdgeLength( int e ) const;
+    double FaceArea( int f ) const;
+    vec3d FaceNormal( int f ) const;
+    static double ComputeTriQual( const vec3d & p0, const vec3d & p1, const vec3d & p2 );
+
+    //==== Accessors ====//
+    int GetNumNodeSlots() const
+    {
+        return ( int )m_X.size();
+    }
+    int GetNumEdgeSlots() const
+    {
+        return ( int )m_EdgeHE.size();
+    }
+    int GetNumFaceSlots() const
+    {
+        return ( int )m_FaceAlive.size();
+    }
+    int GetNumFaces() const
+    {
+        return m_NumFaces;
+    }
+
+    bool NodeAlive( int n ) const
+    {
+        return m_NodeAlive[ n ] != 0;
+    }
+    bool EdgeAlive( int e ) const
+    {
+        return m_EdgeAlive[ e ] != 0;
+    }
+    bool FaceAlive( int f ) const
+    {
+        return m_FaceAlive[ f ] != 0;
+    }
+
+    vec3d GetPnt( int n ) const
+    {
+        return vec3d( m_X[ n ], m_Y[ n ], m_Z[ n ] );
+    }
+    vec2d GetUW( int n ) const
+    {
+        return vec2d( m_U[ n ], m_W[ n ] );
+    }
+    void SetPnt( int n, const vec3d & p );
+    void SetUW( int n, const vec2d & uw );
+
+    bool GetFixed( int n ) const
+    {
+        return m_NodeFixed[ n ] != 0;
+    }
+    void SetFixed( int n, bool f )
+    {
+        m_NodeFixed[ n ] = f;
+    }
+
+    bool GetBorder( int e ) const
+    {
+        return m_EdgeBorder[ e ] != 0;
+    }
+    void SetBorder( int e, bool b )
+    {
+        m_EdgeBorder[ e ] = b;
+    }
+    bool GetRidge( int e ) const
+    {
+        return m_EdgeRidge[ e ] != 0;
+    }
+    void SetRidge( int e, bool r )
+    {
+        m_EdgeRidge[ e ] = r;
+    }
+    int GetSplitNode( int e ) const
+    {
+        return m_EdgeSplitNode[ e ];
+    }
+    void SetSplitNode( int e, int n )
+    {
+        m_EdgeSplitNode[ e ] = n;
+    }
+    double GetTargetLen( int e ) const
+    {
+        return m_EdgeTargetLen[ e ];
+    }
+    void SetTargetLen( int e, double len )
+    {
+        m_EdgeTargetLen[ e ] = len;
+    }
+    double GetLength( int e ) const
+    {
+        return m_EdgeLength[ e ];
+    }
+    double ComputeLength( int e )
+    {
+        m_EdgeLength[ e ] = EdgeLength( e );
+        return m_EdgeLength[ e ];
+    }
+
+    void GetFaceNodes( int f, int & n0, int & n1, int & n2 ) const
+    {
+        n0 = m_FaceNode[ 3 * f ];
+        n1 = m_FaceNode[ 3 * f + 1 ];
+        n2 = m_FaceNode[ 3 * f + 2 ];
+    }
+    void GetFaceEdges( int f, int & e0, int & e1, int & e2 ) const
+    {
+        e0 = m_HEEdge[ 3 * f ];
+        e1 = m_HEEdge[ 3 * f + 1 ];
+        e2 = m_HEEdge[ 3 * f + 2 ];
+    }
+
+protected:
+
+    int NewNode();
+    int NewEdge();
+    int NewFace();
+
+    void RemoveNode( int n );
+    void RemoveEdge( int e );
+    void RemoveFace( int f );
+
+    void SetFace( int f, int n0, int n1, int n2 );
+    void SetHalfEdge( int h, int e, int twin );
+
+    Surf* m_Surf;
+    SimpleGridDensity* m_GridDensity;
+
+    //==== Nodes (SoA) ====//
+    vector< double > m_X;
+    vector< double > m_Y;
+    vector< double > m_Z;
+    vector< double > m_U;
+    vector< double > m_W;
+    vector< int > m_NodeHE;                 // One outgoing half-edge, -1 if isolated
+    vector< char > m_NodeFixed;
+    vector< char > m_NodeAlive;
+
+    //==== Edges ====//
+    vector< int > m_EdgeHE;                 // One half-edge of the edge
+    vector< char > m_EdgeBorder;            // Dont remove or split
+    vector< char > m_EdgeRidge;             // Dont remove but can split
+    vector< int > m_EdgeSplitNode;          // Border split node used by ConvertToQuads, -1 if none
+    vector< double > m_EdgeTargetLen;
+    vector< double > m_EdgeLength;
+    vector< char > m_EdgeAlive;
+
+    //==== Faces and Half-Edges ====//
+    vector< int > m_FaceNode;               // 3 per face, origin of half-edge 3 * f + k
+    vector< int > m_HETwin;                 // 3 per face, -1 on open boundary
+    vector< int > m_HEEdge;                 // 3 per face
+    vector< char > m_FaceAlive;
+    int m_NumFaces;
+
+    //==== Free Lists ====//
+    vector< int > m_FreeNodes;
+    vector< int > m_FreeEdges;
+    vector< int > m_FreeFaces;
+
+    vector< int > m_GarbageNodes;
+    vector< int > m_GarbageEdges;
+    vector< int > m_GarbageFaces;
+};
+
+#endif
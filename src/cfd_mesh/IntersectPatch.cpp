@@ -19,11 +19,18 @@ void intersect( const SurfPatch& bp1, const SurfPatch& bp2, SurfaceIntersectionS
     int MAX_SUB = 12;
     int MIN_SUB = 3;
 
+    SurfPatch::CountPairTest();
+
     if ( !Compare( *bp1.get_bbox(), *bp2.get_bbox() ) )
     {
         return;
     }
 
+    if ( !bp1.obb_overlap( bp2 ) )
+    {
+        return;
+    }
+
     // This test uses a relative tolerance.
     const double tol = 1.0e-3;
 
@@ -58,7 +65,24 @@ void intersect( const SurfPatch& bp1, const SurfPatch& bp2, SurfaceIntersectionS
             ref1 = !planar1; // Refine non-planar surface.
         }
 
-        if ( ref1 )
+        // Shallow splits are cached on the patch and shared by all partners.
+        const SurfPatch* sub = ref1 ? bp1.get_sub_patches() : bp2.get_sub_patches();
+
+        if ( sub )
+        {
+            for ( int i = 0; i < 4; i++ )
+            {
+                if ( ref1 )
+                {
+                    intersect( sub[i], bp2, MeshMgr );
+                }
+                else
+                {
+                    intersect( bp1, sub[i], MeshMgr );
+                }
+            }
+        }
+        else if ( ref1 )
         {
             int n = bp1.degree_u();
             int m = bp1.degree_v();
@@ -70,6 +94,7 @@ void intersect( const SurfPatch& bp1, const SurfPatch& bp2, SurfaceIntersectionS
             SurfPatch bps3( n, m, d );
 
             bp1.split_patch( bps0, bps1, bps2, bps3 );      // Split Patch1 and Keep Subdividing
+            SurfPatch::CountSubPatches( 4 );
 
             intersect( bps0, bp2, MeshMgr );
             intersect( bps1, bp2, MeshMgr );
@@ -88,6 +113,7 @@ void intersect( const SurfPatch& bp1, const SurfPatch& bp2, SurfaceIntersectionS
             SurfPatch bps3( n, m, d );
 
             bp2.split_patch( bps0, bps1, bps2, bps3 );      // Split Patch2 and Keep Subdividing
+            SurfPatch::CountSubPatches( 4 );
 
             intersect( bp1, bps0, MeshMgr );
             intersect( bp1, bps1, MeshMgr );
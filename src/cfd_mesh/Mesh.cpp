@@ -9,8 +9,10 @@
 
 #define _USE_MATH_DEFINES
 #include "Mesh.h"
+#include "HalfEdgeMesh.h"
 #include "Surf.h"
 #include "VspUtil.h"
+#include "ExportBuffer.h"
 #include <triangle.h>
 #include <triangle_api.h>
 #include "delabella.h"
@@ -19,14 +21,6 @@
 #include <numeric>
 #include <random>
 
-bool LongEdgePairLengthCompare( const pair< Edge*, double >& a, const pair< Edge*, double >& b )
-{
-    return ( b.second < a.second );
-}
-bool ShortEdgePairLengthCompare( const pair< Edge*, double >& a, const pair< Edge*, double >& b )
-{
-    return ( a.second < b.second );
-}
 bool ShortEdgeTargetLengthCompare( const Edge* a, const Edge* b )
 {
     return ( a->target_len < b->target_len );
@@ -117,113 +111,138 @@ void Mesh::LimitTargetEdgeLength( Edge* e, Node* notn )
     }
 }
 
-void Mesh::LimitTargetEdgeLength( Edge* e )
+void Mesh::Remesh()
 {
-    Node *n;
-    vector< Edge* >::iterator ne;
-    double growratio = m_GridDensity->m_GrowRatio;
+    HalfEdgeMesh hem;
+    BuildHalfEdgeMesh( hem );
 
-    n = e->n0;
-    for ( ne = n->edgeVec.begin() ; ne != n->edgeVec.end(); ++ne )
-    {
-        double limitlen = growratio * ( *ne )->target_len;
-        if( e->target_len > limitlen )
-        {
-            e->target_len = limitlen;
-        }
-    }
+    hem.Remesh();
 
-    n = e->n1;
-    for ( ne = n->edgeVec.begin() ; ne != n->edgeVec.end(); ++ne )
-    {
-        double limitlen = growratio * ( *ne )->target_len;
-        if( e->target_len > limitlen )
-        {
-            e->target_len = limitlen;
-        }
-    }
+    LoadHalfEdgeMesh( hem );
 }
 
-void Mesh::LimitTargetEdgeLength()
+int Mesh::RemoveRevFaces()
 {
-    Node *n;
-    list< Edge* >::iterator e;
-    vector< Edge* >::iterator ne;
-    double growratio = m_GridDensity->m_GrowRatio;
-    double limitlen;
+    HalfEdgeMesh hem;
+    BuildHalfEdgeMesh( hem );
 
-    edgeList.sort( ShortEdgeTargetLengthCompare );
+    int badcount = hem.RemoveRevFaces();
 
-    for ( e = edgeList.begin() ; e != edgeList.end(); ++e )
+    LoadHalfEdgeMesh( hem );
+
+    return badcount;
+}
+
+//==== Copy Triangle Mesh Into Index Based Half-Edge Mesh ====//
+void Mesh::BuildHalfEdgeMesh( HalfEdgeMesh & hem )
+{
+    hem.Clear();
+    hem.SetSurfPtr( m_Surf );
+    hem.SetGridDensityPtr( m_GridDensity );
+    hem.Reserve( 2 * ( int )nodeList.size(), 2 * ( int )edgeList.size(), 2 * ( int )faceList.size() );
+
+    unordered_map< Node*, int > nodeMap;
+    nodeMap.reserve( nodeList.size() );
+
+    list< Node* >::iterator n;
+    for ( n = nodeList.begin() ; n != nodeList.end(); ++n )
     {
-        limitlen = growratio * ( *e )->target_len;
+        nodeMap[ *n ] = hem.AddNode( ( *n )->pnt, ( *n )->uw, ( *n )->fixed );
+    }
 
-        n = ( *e )->n0;
-        for ( ne = n->edgeVec.begin() ; ne != n->edgeVec.end(); ++ne )
+    unordered_map< Edge*, int > edgeMap;
+    edgeMap.reserve( edgeList.size() );
+
+    list< Edge* >::iterator e;
+    for ( e = edgeList.begin() ; e != edgeList.end(); ++e )
+    {
+        int ind = hem.AddEdge();
+        hem.SetBorder( ind, ( *e )->border );
+        hem.SetRidge( ind, ( *e )->ridge );
+        hem.SetTargetLen( ind, ( *e )->target_len );
+        if ( ( *e )->ns )
         {
-            if ( !( *ne )->border )
-            {
-                if( ( *ne )->target_len > limitlen )
-                {
-                    ( *ne )->target_len = limitlen;
-                }
-            }
+            hem.SetSplitNode( ind, nodeMap[ ( *e )->ns ] );
         }
+        edgeMap[ *e ] = ind;
+    }
 
-        n = ( *e )->n1;
-        for ( ne = n->edgeVec.begin() ; ne != n->edgeVec.end(); ++ne )
+    list< Face* >::iterator f;
+    for ( f = faceList.begin() ; f != faceList.end(); ++f )
+    {
+        if ( ( *f )->IsQuad() )
         {
-            if ( !( *ne )->border )
-            {
-                if( ( *ne )->target_len > limitlen )
-                {
-                    ( *ne )->target_len = limitlen;
-                }
-            }
+            continue;
         }
-    }
-}
 
+        Node* n0 = ( *f )->n0;
+        Node* n1 = ( *f )->n1;
+        Node* n2 = ( *f )->n2;
 
-void Mesh::Remesh()
-{
-    int num_split = 1;
-    int num_collapse = 1;
+        // Face edges are not stored in any particular order.
+        hem.AddFace( nodeMap[ n0 ], nodeMap[ n1 ], nodeMap[ n2 ],
+                     edgeMap[ ( *f )->FindEdge( n0, n1 ) ],
+                     edgeMap[ ( *f )->FindEdge( n1, n2 ) ],
+                     edgeMap[ ( *f )->FindEdge( n2, n0 ) ] );
+    }
 
-    //==== Find Target Edge Lengths ====//
-    list< Edge* >::iterator e;
     for ( e = edgeList.begin() ; e != edgeList.end(); ++e )
     {
-        ( *e )->ComputeLength();
-        ComputeTargetEdgeLength( *e );
+        hem.ComputeLength( edgeMap[ *e ] );
     }
+}
 
-    LimitTargetEdgeLength();
+//==== Replace Mesh Contents With Half-Edge Mesh ====//
+void Mesh::LoadHalfEdgeMesh( const HalfEdgeMesh & hem )
+{
+    DumpGarbage();
+    Clear();
 
-    for ( int i = 0 ; i < 20 ; i++ )
+    vector< Node* > nodeVec( hem.GetNumNodeSlots(), nullptr );
+    for ( int i = 0 ; i < hem.GetNumNodeSlots() ; i++ )
     {
-        if ( num_split )
-        {
-            num_split = Split( 1 );
-        }
-        if ( num_collapse )
+        if ( hem.NodeAlive( i ) )
         {
-            num_collapse = Collapse( 1 );
+            nodeVec[i] = AddNode( hem.GetPnt( i ), hem.GetUW( i ) );
+            nodeVec[i]->fixed = hem.GetFixed( i );
         }
     }
 
-    for ( e = edgeList.begin() ; e != edgeList.end() ; ++e )
+    vector< Edge* > edgeVec( hem.GetNumEdgeSlots(), nullptr );
+    for ( int i = 0 ; i < hem.GetNumEdgeSlots() ; i++ )
     {
-        if ( !( *e )->border )
+        if ( hem.EdgeAlive( i ) )
         {
-            SwapEdge( *e );
+            int n0, n1;
+            hem.GetEdgeNodes( i, n0, n1 );
+
+            Edge* e = AddEdge( nodeVec[ n0 ], nodeVec[ n1 ] );
+            e->border = hem.GetBorder( i );
+            e->ridge = hem.GetRidge( i );
+            e->target_len = hem.GetTargetLen( i );
+            e->m_Length = hem.GetLength( i );
+
+            int ns = hem.GetSplitNode( i );
+            if ( ns >= 0 )
+            {
+                e->ns = nodeVec[ ns ];
+            }
+            edgeVec[i] = e;
         }
     }
-//printf("Smooth\n");
-    LaplacianSmooth( 2 );
 
-    //ColorTris();
+    for ( int i = 0 ; i < hem.GetNumFaceSlots() ; i++ )
+    {
+        if ( hem.FaceAlive( i ) )
+        {
+            int n0, n1, n2;
+            int e0, e1, e2;
+            hem.GetFaceNodes( i, n0, n1, n2 );
+            hem.GetFaceEdges( i, e0, e1, e2 );
 
+            AddFace( nodeVec[ n0 ], nodeVec[ n1 ], nodeVec[ n2 ], edgeVec[ e0 ], edgeVec[ e1 ], edgeVec[ e2 ] );
+        }
+    }
 }
 
 void Mesh::LoadSimpFaces()
@@ -363,1027 +382,206 @@ int Mesh::CheckDupOrAdd( int ind, unordered_map< int, vector< int > > & indMap,
             int testind = iter->second[i];
 
             if ( std::abs( pntVec[ind].x() - pntVec[testind].x() ) < tol  &&
-                    std::abs( pntVec[ind].y() - pntVec[testind].y() ) < tol  &&
-                    std::abs( pntVec[ind].z() - pntVec[testind].z() ) < tol  )
-            {
-                return testind;
-            }
-        }
-        indMap[combind].push_back( ind );
-    }
-    return ind;
-}
-
-
-int Mesh::Split( int num_iter )
-{
-    int num_long_edges = 0;
-    list< Edge* >::iterator e;
-    for ( int iter = 0 ; iter < num_iter ; iter++ )
-    {
-        //===== Split ====//
-        vector < pair < Edge*, double > > longEdges;
-        longEdges.reserve( edgeList.size() );
-        for ( e = edgeList.begin() ; e != edgeList.end(); ++e )
-        {
-            if ( !( *e )->border )
-            {
-                double rat = ( *e )->GetLength() / ( *e )->target_len;
-                if ( rat > 1.41 )
-                {
-                    longEdges.emplace_back( pair< Edge*, double >( ( *e ), rat ) );
-                }
-            }
-        }
-
-        //==== Sort Matches By Length ====//
-        sort( longEdges.begin(), longEdges.end(), LongEdgePairLengthCompare );
-
-        int num_split = longEdges.size() / 10;
-        num_split = min( num_split, ( int )longEdges.size() );
-
-        for ( int i = 0 ; i < num_split ; i++ )
-        {
-            longEdges[i].first->ComputeLength();
-            SplitEdge( longEdges[i].first );
-        }
-
-        //==== Swap All Changed Edges If Needed ====//
-        //for ( e = edgeList.begin() ; e != edgeList.end(); e++ )
-        //{
-        //  ComputeTargetEdgeLength(*e);
-        //}
-
-        num_long_edges = longEdges.size();
-    }
-    DumpGarbage();
-
-    return num_long_edges;
-
-}
-
-int Mesh::Collapse( int num_iter )
-{
-    int num_short_edges = 0;
-    for ( int iter = 0 ; iter < num_iter ; iter++ )
-    {
-        list< Edge* >::iterator e;
-
-        //==== Collapse =====//
-        vector < pair < Edge*, double > > shortEdges;
-        shortEdges.reserve( edgeList.size() );
-        for ( e = edgeList.begin() ; e != edgeList.end(); ++e )
-        {
-            if ( *e )
-            {
-                if ( ValidCollapse( *e ) )
-                {
-                    double rat = ( *e )->GetLength() / ( *e )->target_len;
-                    if ( rat < 0.707 )
-                    {
-                        shortEdges.emplace_back( pair< Edge*, double >( ( *e ), rat ) );
-                    }
-                }
-            }
-        }
-
-        //==== Sort Matches By Length ====//
-        sort( shortEdges.begin(), shortEdges.end(), ShortEdgePairLengthCompare );
-
-        int num_colapse = shortEdges.size() / 10;
-        num_colapse = min( num_colapse, ( int )shortEdges.size() );
-
-        num_short_edges = 0;
-        for ( int i = 0 ; i < num_colapse ; i++ )
-        {
-            shortEdges[i].first->ComputeLength();
-//          printf("  Collapse %f \n", dist );
-            if ( ValidCollapse( shortEdges[i].first ) && !shortEdges[i].first->m_DeleteMeFlag )
-            {
-                num_short_edges++;
-                CollapseEdge( shortEdges[i].first );
-            }
-        }
-
-        ////==== Swap All Changed Edges If Needed ====//
-        //for ( e = edgeList.begin() ; e != edgeList.end(); e++ )
-        //{
-        //      ComputeTargetEdgeLength(*e);
-        //}
-    }
-
-    DumpGarbage();
-
-    return num_short_edges;
-
-}
-
-int Mesh::RemoveRevFaces()
-{
-    int badcount = 0;
-
-    vector < Edge* > remEdges;
-
-    list< Face* >::iterator f;
-    for ( f = faceList.begin() ; f != faceList.end(); ++f )
-    {
-        vec3d nface = (*f)->Normal();
-        vec3d nsurf = (*f)->ComputeCenterNormal( m_Surf );
-
-        double dprod = dot ( nface, nsurf );
-
-        if ( m_Surf->GetFlipFlag() )
-        {
-            dprod = -dprod;
-        }
-
-        if ( dprod < 0.0 )
-        {
-            Edge* e = ( *f )->FindShortEdge();
-
-            if ( e )
-            {
-                remEdges.push_back( e );
-
-                badcount++;
-            }
-        }
-    }
-
-    for ( int i = 0; i < remEdges.size(); i++ )
-    {
-        Edge* e = remEdges[i];
-
-        if ( e )
-        {
-            if ( ValidCollapse( e ) )
-            {
-                CollapseEdge( e );
-            }
-        }
-
-    }
-
-    return badcount;
-}
-
-void Mesh::ColorTris()
-{
-    list< Face* >::iterator f;
-    for ( f = faceList.begin() ; f != faceList.end(); ++f )
-    {
-        double q = ( *f )->ComputeTriQual();
-
-        if ( q > M_PI / 6.0 )                                           // > 30 Deg
-        {
-            ( *f )->rgb[0] = ( *f )->rgb[1] = ( *f )->rgb[2] = 255;
-        }
-        else if ( q > M_PI / 7.0 )
-        {
-            ( *f )->rgb[2] = 255;    // 25 deg
-            ( *f )->rgb[0] = ( *f )->rgb[1] = 100;
-        }
-        else
-        {
-            ( *f )->rgb[0] = 255;
-            ( *f )->rgb[1] = ( *f )->rgb[2] = 100;
-        }
-    }
-
-//  printf( "Num Faces = %d \n", (int)faceList.size() );
-}
-
-Node* Mesh::AddNode( const vec3d &p, const vec2d &uw_in )
-{
-    Node* nptr = new Node( p, uw_in );
-    nodeList.push_back( nptr );
-    nptr->list_ptr = --nodeList.end();
-    return nptr;
-}
-
-void Mesh::RemoveNode( Node* nptr )
-{
-    garbageNodeVec.push_back( nptr );
-    nodeList.erase( nptr->list_ptr );
-
-    nptr->m_DeleteMeFlag = true;
-}
-
-Node* Mesh::FindNode( const vec3d& p )
-{
-    list< Node* >::iterator n;
-    for ( n = nodeList.begin() ; n != nodeList.end(); ++n )
-    {
-        if ( !( *n )->m_DeleteMeFlag && dist_squared( ( *n )->pnt, p ) < 1.0e-7 )
-        {
-            return ( *n );
-        }
-    }
-    return nullptr;
-}
-
-Edge* Mesh::AddEdge( Node* n0, Node* n1 )
-{
-    Edge* eptr = new Edge( n0, n1 );
-
-    edgeList.push_back( eptr );
-    eptr->list_ptr = --edgeList.end();
-
-    n0->AddConnectEdge( eptr );
-    n1->AddConnectEdge( eptr );
-
-    eptr->ComputeLength();
-
-    return eptr;
-}
-
-void Mesh::RemoveEdge( Edge* eptr )
-{
-    if ( eptr && !eptr->m_DeleteMeFlag )
-    {
-        if ( eptr->n0 )
-        {
-            eptr->n0->RemoveConnectEdge( eptr );
-        }
-        if ( eptr->n1 )
-        {
-            eptr->n1->RemoveConnectEdge( eptr );
-        }
-
-        garbageEdgeVec.push_back( eptr );
-
-        edgeList.erase( eptr->list_ptr );
-
-        eptr->m_DeleteMeFlag = true;
-    }
-}
-
-Edge* Mesh::FindEdge( Node* n0, Node* n1 )
-{
-    list< Edge* >::iterator e;
-    for ( e = edgeList.begin() ; e != edgeList.end(); ++e )
-    {
-        if ( !( *e )->m_DeleteMeFlag )
-        {
-            if ( ( *e )->n0 == n0 && ( *e )->n1 == n1 )
-            {
-                return ( *e );
-            }
-            if ( ( *e )->n0 == n1 && ( *e )->n1 == n0 )
-            {
-                return ( *e );
-            }
-        }
-    }
-    return nullptr;
-}
-
-Face* Mesh::AddFace( Node* nn0, Node* nn1, Node* nn2, Edge* ee0, Edge* ee1, Edge* ee2 )
-{
-    Face* fptr = new Face( nn0, nn1, nn2, ee0, ee1, ee2 );
-    faceList.push_back( fptr );
-    fptr->list_ptr = --faceList.end();
-
-    ee0->SetFace( fptr );
-    ee1->SetFace( fptr );
-    ee2->SetFace( fptr );
-
-    return fptr;
-}
-
-Face* Mesh::AddFace( Node* nn0, Node* nn1, Node* nn2, Node* nn3, Edge* ee0, Edge* ee1, Edge* ee2, Edge* ee3 )
-{
-    Face* fptr = new Face( nn0, nn1, nn2, nn3, ee0, ee1, ee2, ee3 );
-    faceList.push_back( fptr );
-    fptr->list_ptr = --faceList.end();
-
-    ee0->SetFace( fptr );
-    ee1->SetFace( fptr );
-    ee2->SetFace( fptr );
-    ee3->SetFace( fptr );
-
-    return fptr;
-}
-
-void Mesh::RemoveFace( Face* fptr )
-{
-    if ( fptr && ! fptr->m_DeleteMeFlag )
-    {
-        garbageFaceVec.push_back( fptr );
-        faceList.erase( fptr->list_ptr );
-        fptr->m_DeleteMeFlag = true;
-        fptr->EdgeForgetFace();
-    }
-}
-
-void Mesh::DumpGarbage()
-{
-    //==== Delete Flagged Nodes =====//
-    for ( int i = 0 ; i < ( int )garbageNodeVec.size() ; i++ )
-    {
-        delete garbageNodeVec[i];
-    }
-    garbageNodeVec.clear();
-
-    //==== Delete Flagged Edges =====//
-    for ( int i = 0 ; i < ( int )garbageEdgeVec.size() ; i++ )
-    {
-        delete garbageEdgeVec[i];
-    }
-    garbageEdgeVec.clear();
-
-    //==== Delete Flagged Faces =====//
-    for ( int i = 0 ; i < ( int )garbageFaceVec.size() ; i++ )
-    {
-        delete garbageFaceVec[i];
-    }
-    garbageFaceVec.clear();
-}
-
-void Mesh::SetNodeFlags()
-{
-    list< Node* >::iterator n;
-    for ( n = nodeList.begin() ; n != nodeList.end(); ++n )
-    {
-        ( *n )->fixed = false;
-    }
-
-    list< Edge* >::iterator e;
-    for ( e = edgeList.begin() ; e != edgeList.end(); ++e )
-    {
-        if ( ( *e )->border || ( *e )->ridge )
-        {
-            ( *e )->n0->fixed = true;
-            ( *e )->n1->fixed = true;
-        }
-    }
-}
-
-void Mesh::SplitEdge( Edge* edge )
-{
-    assert( m_Surf );
-
-    if ( edge->border )                     // Dont Split Borders
-    {
-        return;
-    }
-
-    assert( edge->f0 || edge->f1 );
-
-    Face* fa = edge->f0;
-    Face* fb = edge->f1;
-
-    Node* n0 = edge->n0;
-    Node* n1 = edge->n1;
-    if ( fa && !fa->CorrectOrder( n0, n1 ) )
-    {
-        n0 = edge->n1;
-        n1 = edge->n0;
-    }
-    else if ( !fa && fb && !fb->CorrectOrder( n0, n1 ) )
-    {
-        n0 = edge->n1;
-        n1 = edge->n0;
-
-    }
-    //else if ( tb && !tb->CorrectOrder( n0, n1 ) )
-    //{
-    //  n0 = edge->n1;
-    //  n1 = edge->n0;
-    //}
-
-    vec3d psplit  = ( n0->pnt + n1->pnt ) * 0.5; // Split
-    vec2d uwsplit = ( n0->uw  + n1->uw ) * 0.5;
-
-    vec2d uws = m_Surf->ClosestUW( psplit, uwsplit[0], uwsplit[1] );
-    vec3d ps  = m_Surf->CompPnt( uws.x(), uws.y() );
-
-    Node* ns  = AddNode( ps, uws );
-    Edge* es0 = AddEdge( n0, ns );
-    Edge* es1 = AddEdge( ns, n1 );
-    es0->ridge = edge->ridge;
-    es1->ridge = edge->ridge;
-    es0->border = edge->border; // Should be impossible.
-    es1->border = edge->border; // Should be impossible.
-
-    if ( fa )
-    {
-        Node* na = fa->OtherNodeTri( n0, n1 );
-        Edge* ea = AddEdge( na, ns );
-
-        Edge* ea0 = fa->FindEdge( n0, na );
-        Edge* ea1 = fa->FindEdge( na, n1 );
-
-        if ( !ea0 || !ea1 ) return;
-
-        ea0->RemoveFace( fa );
-        ea1->RemoveFace( fa );
-
-        Face* fa0 = AddFace( n0, ns, na, ea0, ea, es0 );
-        Face* fa1 = AddFace( n1, na, ns, ea1, es1, ea );
-
-        RemoveFace( fa );
-    }
-
-    if ( fb )
-    {
-        Node* nb = fb->OtherNodeTri( n0, n1 );
-        Edge* eb = AddEdge( ns, nb );
-
-        Edge* eb0 = fb->FindEdge( n0, nb );
-        Edge* eb1 = fb->FindEdge( nb, n1 );
-
-        if ( !eb0 || !eb1 ) return;
-
-        eb0->RemoveFace( fb );
-        eb1->RemoveFace( fb );
-
-        Face* fb0 = AddFace( n0, nb, ns, es0, eb, eb0 );
-        Face* fb1 = AddFace( n1, ns, nb, es1, eb1, eb );
-
-        RemoveFace( fb );
-    }
-
-    RemoveEdge( edge );
-
-    ComputeTargetEdgeLength( ns );
-    LimitTargetEdgeLength( ns );
-}
-
-void Mesh::SwapEdge( Edge* edge )
-{
-    if ( !edge )
-    {
-        return;
-    }
-
-    //if ( edge->n0->fixed && edge->n1->fixed )
-    //  return;
-    if ( edge->border )
-    {
-        return;
-    }
-
-    Face*  fa = edge->f0;
-    Face*  fb = edge->f1;
-
-    if ( !fa || !fb )
-    {
-        return;
-    }
-
-    if ( ThreeEdgesThreeFaces( edge ) )
-    {
-        return;
-    }
-
-    Node* n0 = edge->n0;
-    Node* n1 = edge->n1;
-
-    if ( !n0 || !n1 )
-    {
-        return;
-    }
-
-    if ( !fa->CorrectOrder( n0, n1 ) )
-    {
-        n0 = edge->n1;
-        n1 = edge->n0;
-    }
-
-    Node* na = fa->OtherNodeTri( n0, n1 );
-    Node* nb = fb->OtherNodeTri( n0, n1 );
-
-    assert( na != nb );
-
-    if ( !na || !nb )
-    {
-        return;
-    }
-
-    //==== Determine Face Quality of Existing Faces =====//
-    double qa = fa->ComputeTriQual();
-    double qb = fb->ComputeTriQual();
-    double qc = Face::ComputeTriQual( n0, nb, na );
-    double qd = Face::ComputeTriQual( n1, na, nb );
-
-    if ( min( qc, qd ) <= min( qa, qb ) )
-    {
-        return;
-    }
-
-    vec3d norma = fa->Normal();
-    vec3d normb = fb->Normal();
-    vec3d normc = Face::Normal( n0, nb, na );
-    vec3d normd = Face::Normal( n1, na, nb );
-
-    double angab = angle( norma, normb );
-
-    if ( angab > 0.25 * M_PI_4  )
-    {
-        return;
-    }
-
-    double angcd = angle( normc, normd );
-
-    if ( angcd > 0.25 * M_PI_4  )
-    {
-        return;
-    }
-
-    double angac = angle( norma, normc );
-
-    if ( angac > 0.25 * M_PI_4 )
-    {
-        return;
-    }
-
-    Edge* ea0 = fa->FindEdge( n0, na );
-    Edge* ea1 = fa->FindEdge( na, n1 );
-    Edge* eb0 = fb->FindEdge( n0, nb );
-    Edge* eb1 = fb->FindEdge( nb, n1 );
-
-    if ( !ea0 || !ea1 || !eb0 || !eb1 ) return;
-
-    edge->n0 = na;
-    edge->n1 = nb;
-    edge->ComputeLength();
-    ComputeTargetEdgeLength( edge );
-
-    na->AddConnectEdge( edge );
-    nb->AddConnectEdge( edge );
-    n0->RemoveConnectEdge( edge );
-    n1->RemoveConnectEdge( edge );
-
-    fa->SetNodesEdges( n0, nb, na, ea0, edge, eb0 );
-    fb->SetNodesEdges( n1, na, nb, eb1, edge, ea1 );
-
-    if ( ea1->f0 == fa )
-    {
-        ea1->f0 = fb;
-    }
-    else if ( ea1->f1 == fa )
-    {
-        ea1->f1 = fb;
-    }
-    else
-    {
-        assert( 0 );
-    }
-
-    if ( eb0->f0 == fb )
-    {
-        eb0->f0 = fa;
-    }
-    else if ( eb0->f1 == fb )
-    {
-        eb0->f1 = fa;
-    }
-    else
-    {
-        assert( 0 );
-    }
-
-    LimitTargetEdgeLength( edge );
-
-//CheckValidAllEdges();
-}
-
-bool Mesh::ThreeEdgesThreeFaces( Edge* edge )
-{
-    Node* n0 = edge->n0;
-    Node* n1 = edge->n1;
-
-    vector< Face* > f;
-    n0->GetConnectFaces( f );
-    if ( f.size() == 3 && n0->edgeVec.size() == 3 )
-    {
-        return true;
-    }
-
-    vector< Face* > fvec1;
-    n1->GetConnectFaces( fvec1 );
-
-    return fvec1.size() == 3 && n1->edgeVec.size() == 3;
-}
-
-
-bool Mesh::ValidCollapse( Edge* edge )
-{
-    if ( !edge )
-    {
-        return false;
-    }
-
-    if ( edge->m_DeleteMeFlag )
-    {
-        return false;
-    }
-
-    if ( edge->border || edge->ridge )
-    {
-        return false;
-    }
-
-    if ( !edge->n0 || !edge->n1 )
-    {
-        return false;
-    }
-
-    Node* n0 = edge->n0;
-    Node* n1 = edge->n1;
-
-    //////if ( edge->n0->fixed || edge->n1->fixed )
-    //////  return false;
-    if ( edge->n0->fixed && edge->n1->fixed )
-    {
-        return false;
-    }
-
-    Face* fa = edge->f0;
-    Face* fb = edge->f1;
-
-    if ( !fa || !fb )
-    {
-        return false;
-    }
-
-    if ( fa->m_DeleteMeFlag || fb->m_DeleteMeFlag )
-    {
-        return false;
-    }
-
-    Node* na = fa->OtherNodeTri( n0, n1 );
-    Node* nb = fb->OtherNodeTri( n0, n1 );
-
-    if ( !na || !nb )
-    {
-        return false;
-    }
-
-    //==== Check 3 Faces in a Face Case =====//
-    Edge* e0a = fa->FindEdge( n0, na );
-    Edge* e1a = fa->FindEdge( n1, na );
-
-    if ( !e0a || !e1a )
-    {
-        return false;
-    }
-
-    Face* fa0 = e0a->OtherFace( fa );
-    Face* fa1 = e1a->OtherFace( fa );
-
-    if ( fa0 && fa1 )
-    {
-        Node* na0 = fa0->OtherNodeTri( n0, na );
-        Node* na1 = fa1->OtherNodeTri( n1, na );
-
-        if ( na0 == na1 )
-        {
-            return false;
-        }
-    }
-
-    Edge* e0b = fb->FindEdge( n0, nb );
-    Edge* e1b = fb->FindEdge( n1, nb );
-
-    if ( !e0b || !e1b )
-    {
-        return false;
-    }
-
-    Face* fb0 = e0b->OtherFace( fb );
-    Face* fb1 = e1b->OtherFace( fb );
-
-    if ( fb0 && fb1 )
-    {
-        Node* nb0 = fb0->OtherNodeTri( n0, nb );
-        Node* nb1 = fb1->OtherNodeTri( n1, nb );
-
-        if ( nb0 == nb1 )
-        {
-            return false;
+                    std::abs( pntVec[ind].y() - pntVec[testind].y() ) < tol  &&
+                    std::abs( pntVec[ind].z() - pntVec[testind].z() ) < tol  )
+            {
+                return testind;
+            }
         }
+        indMap[combind].push_back( ind );
     }
-
-
-    //if ( na->edgeVec.size() <= 3 )            // 3-Division Config
-    //  return false;
-    //if ( nb->edgeVec.size() <= 3 )            // 3-Division Config
-    //  return false;
-
-    return true;
+    return ind;
 }
 
-bool Mesh::ValidNodeMove( Node* nptr, const vec3d & move_to, Face* ignoreFace )
-{
-    int i;
-    bool valid_flag = true;
-    vector < Face* > faceVec;
-    nptr->GetConnectFaces( faceVec );
 
-    vector < vec3d > normals;
-    for ( i = 0 ; i < ( int )faceVec.size() ; i++ )
+void Mesh::ColorTris()
+{
+    list< Face* >::iterator f;
+    for ( f = faceList.begin() ; f != faceList.end(); ++f )
     {
-        if ( faceVec[i] != ignoreFace )
+        double q = ( *f )->ComputeTriQual();
+
+        if ( q > M_PI / 6.0 )                                           // > 30 Deg
         {
-            normals.push_back( faceVec[i]->Normal() );
+            ( *f )->rgb[0] = ( *f )->rgb[1] = ( *f )->rgb[2] = 255;
         }
-    }
-
-    vec3d save_pos = nptr->pnt;
-    nptr->pnt = move_to;
-
-    vector < vec3d > move_normals;
-    for ( i = 0 ; i < ( int )faceVec.size() ; i++ )
-    {
-        if ( faceVec[i] != ignoreFace )
+        else if ( q > M_PI / 7.0 )
         {
-            move_normals.push_back( faceVec[i]->Normal() );
+            ( *f )->rgb[2] = 255;    // 25 deg
+            ( *f )->rgb[0] = ( *f )->rgb[1] = 100;
         }
-    }
-
-    for ( i = 0 ; i < ( int )normals.size() ; i++ )
-    {
-        if ( angle( normals[i], move_normals[i] ) >= 0.5 * M_PI_4 )
+        else
         {
-            valid_flag = false;
-            break;
+            ( *f )->rgb[0] = 255;
+            ( *f )->rgb[1] = ( *f )->rgb[2] = 100;
         }
     }
 
-    nptr->pnt = save_pos;
+//  printf( "Num Faces = %d \n", (int)faceList.size() );
+}
+
+Node* Mesh::AddNode( const vec3d &p, const vec2d &uw_in )
+{
+    Node* nptr = new Node( p, uw_in );
+    nodeList.push_back( nptr );
+    nptr->list_ptr = --nodeList.end();
+    return nptr;
+}
 
+void Mesh::RemoveNode( Node* nptr )
+{
+    garbageNodeVec.push_back( nptr );
+    nodeList.erase( nptr->list_ptr );
 
-    return valid_flag;
+    nptr->m_DeleteMeFlag = true;
 }
 
-void Mesh::CollapseHighlightEdge()
+Node* Mesh::FindNode( const vec3d& p )
 {
-    Edge* hedge = nullptr;
-    int cnt = 0;
-    list< Edge* >::iterator e;
-    for ( e = edgeList.begin() ; e != edgeList.end(); ++e )
+    list< Node* >::iterator n;
+    for ( n = nodeList.begin() ; n != nodeList.end(); ++n )
     {
-        if ( cnt == m_HighlightEdgeIndex )
+        if ( !( *n )->m_DeleteMeFlag && dist_squared( ( *n )->pnt, p ) < 1.0e-7 )
         {
-            hedge = ( *e );
+            return ( *n );
         }
-        cnt++;
     }
-
-    if ( hedge && ValidCollapse( hedge ) )
-    {
-        CollapseEdge( hedge );
-        DumpGarbage();
-    }
-
-
+    return nullptr;
 }
 
-void Mesh::CollapseEdge( Edge* edge )
+Edge* Mesh::AddEdge( Node* n0, Node* n1 )
 {
-    Node* n0 = edge->n0;
-    Node* n1 = edge->n1;
-
-    Face* fa = edge->f0;
-    Face* fb = edge->f1;
-    Node* na = fa->OtherNodeTri( n0, n1 );
-    Node* nb = fb->OtherNodeTri( n0, n1 );
-
-    assert( na != nb );
-
-    Edge* ea0 = fa->FindEdge( na, n0 );
-    Edge* ea1 = fa->FindEdge( na, n1 );
-    Edge* eb0 = fb->FindEdge( nb, n0 );
-    Edge* eb1 = fb->FindEdge( nb, n1 );
+    Edge* eptr = new Edge( n0, n1 );
 
-    if ( !ea0 || !ea1 || !eb0 || !eb1 ) return;
+    edgeList.push_back( eptr );
+    eptr->list_ptr = --edgeList.end();
 
-    Face* fa0 = ea0->OtherFace( fa );
-    Face* fa1 = ea1->OtherFace( fa );
-    Face* fb0 = eb0->OtherFace( fb );
-    Face* fb1 = eb1->OtherFace( fb );
+    n0->AddConnectEdge( eptr );
+    n1->AddConnectEdge( eptr );
 
-    if ( !fa0 || !fa1 || !fb0 || !fb1 ) return;
+    eptr->ComputeLength();
 
-    if ( fa0 && fa1 )
-    {
-        Node* other_ta0 = fa0->OtherNodeTri( na, n0 );
-        Node* other_ta1 = fa1->OtherNodeTri( na, n1 );
-        assert ( other_ta0 != other_ta1 );
-    }
+    return eptr;
+}
 
-    if ( fb0 && fb1 )
+void Mesh::RemoveEdge( Edge* eptr )
+{
+    if ( eptr && !eptr->m_DeleteMeFlag )
     {
-        Node* other_tb0 = fb0->OtherNodeTri( nb, n0 );
-        Node* other_tb1 = fb1->OtherNodeTri( nb, n1 );
-        assert ( other_tb0 != other_tb1 );
-    }
-
-
-
+        if ( eptr->n0 )
+        {
+            eptr->n0->RemoveConnectEdge( eptr );
+        }
+        if ( eptr->n1 )
+        {
+            eptr->n1->RemoveConnectEdge( eptr );
+        }
 
-    vec3d pc;
-    vec2d uwc;
-    if ( n0->fixed )
-    {
-        pc = n0->pnt;
-        uwc = n0->uw;
-    }
-    else if ( n1->fixed )
-    {
-        pc = n1->pnt;
-        uwc = n1->uw;
-    }
-    else
-    {
-        vec3d psplit = ( n0->pnt + n1->pnt ) * 0.5;
-        vec2d uwsplit = ( n0->uw + n1->uw ) * 0.5;
-        uwc = m_Surf->ClosestUW( psplit, uwsplit[0], uwsplit[1] );
-        pc  = m_Surf->CompPnt( uwc.x(), uwc.y() );
-    }
+        garbageEdgeVec.push_back( eptr );
 
-    if ( !ValidNodeMove( n0, pc, fa ) )
-    {
-        return;
-    }
-    if ( !ValidNodeMove( n1, pc, fb ) )
-    {
-        return;
-    }
+        edgeList.erase( eptr->list_ptr );
 
-    Node* nc  = AddNode( pc, uwc );
-    if ( n0->fixed || n1->fixed )
-    {
-        nc->fixed = true;
+        eptr->m_DeleteMeFlag = true;
     }
+}
 
-    Edge* eca = AddEdge( na, nc );
-    Edge* ecb = AddEdge( nb, nc );
-
-    if ( ea0->border || ea1->border )
+Edge* Mesh::FindEdge( Node* n0, Node* n1 )
+{
+    list< Edge* >::iterator e;
+    for ( e = edgeList.begin() ; e != edgeList.end(); ++e )
     {
-        eca->border = true;
-
-        if( ea0->ns )
-        {
-            eca->ns = ea0->ns;
-            ea0->ns = nullptr;
-        }
-
-        if( ea1->ns )
+        if ( !( *e )->m_DeleteMeFlag )
         {
-            eca->ns = ea1->ns;
-            ea1->ns = nullptr;
+            if ( ( *e )->n0 == n0 && ( *e )->n1 == n1 )
+            {
+                return ( *e );
+            }
+            if ( ( *e )->n0 == n1 && ( *e )->n1 == n0 )
+            {
+                return ( *e );
+            }
         }
     }
-    if ( eb0->border || eb1->border )
-    {
-        ecb->border = true;
-
-        if( eb0->ns )
-        {
-            ecb->ns = eb0->ns;
-            eb0->ns = nullptr;
-        }
+    return nullptr;
+}
 
-        if( eb1->ns )
-        {
-            ecb->ns = eb1->ns;
-            eb1->ns = nullptr;
-        }
-    }
-    if ( ea0->ridge  || ea1->ridge )
-    {
-        eca->ridge = true;
-    }
-    if ( eb0->ridge  || eb1->ridge )
-    {
-        ecb->ridge = true;
-    }
+Face* Mesh::AddFace( Node* nn0, Node* nn1, Node* nn2, Edge* ee0, Edge* ee1, Edge* ee2 )
+{
+    Face* fptr = new Face( nn0, nn1, nn2, ee0, ee1, ee2 );
+    faceList.push_back( fptr );
+    fptr->list_ptr = --faceList.end();
 
-//jrg Check for invalid faces and improved qual
+    ee0->SetFace( fptr );
+    ee1->SetFace( fptr );
+    ee2->SetFace( fptr );
 
-    eca->f0 = fa0;
-    eca->f1 = fa1;
-    ecb->f0 = fb0;
-    ecb->f1 = fb1;
+    return fptr;
+}
 
-    if ( fa0 )
-    {
-        fa0->ReplaceEdge( ea0, eca );
-    }
-    if ( fa1 )
-    {
-        fa1->ReplaceEdge( ea1, eca );
-    }
-    if ( fb0 )
-    {
-        fb0->ReplaceEdge( eb0, ecb );
-    }
-    if ( fb1 )
-    {
-        fb1->ReplaceEdge( eb1, ecb );
-    }
+Face* Mesh::AddFace( Node* nn0, Node* nn1, Node* nn2, Node* nn3, Edge* ee0, Edge* ee1, Edge* ee2, Edge* ee3 )
+{
+    Face* fptr = new Face( nn0, nn1, nn2, nn3, ee0, ee1, ee2, ee3 );
+    faceList.push_back( fptr );
+    fptr->list_ptr = --faceList.end();
 
+    ee0->SetFace( fptr );
+    ee1->SetFace( fptr );
+    ee2->SetFace( fptr );
+    ee3->SetFace( fptr );
 
-//CheckValidEdge(eca);
-//CheckValidEdge(ecb);
+    return fptr;
+}
 
-    //==== Change Any Faces That Point to n0 ====//
-    vector< Face* > fVec;
-    n0->GetConnectFaces( fVec );
-    for ( int i = 0 ; i < ( int )fVec.size() ; i++ )
+void Mesh::RemoveFace( Face* fptr )
+{
+    if ( fptr && ! fptr->m_DeleteMeFlag )
     {
-        fVec[i]->ReplaceNode( n0, nc );
+        garbageFaceVec.push_back( fptr );
+        faceList.erase( fptr->list_ptr );
+        fptr->m_DeleteMeFlag = true;
+        fptr->EdgeForgetFace();
     }
-    n1->GetConnectFaces( fVec );
-    for ( int i = 0 ; i < ( int )fVec.size() ; i++ )
+}
+
+void Mesh::DumpGarbage()
+{
+    //==== Delete Flagged Nodes =====//
+    for ( int i = 0 ; i < ( int )garbageNodeVec.size() ; i++ )
     {
-        fVec[i]->ReplaceNode( n1, nc );
+        delete garbageNodeVec[i];
     }
+    garbageNodeVec.clear();
 
-    //==== Change Edges That Point To n0 ====//
-    for ( int i = 0 ; i < ( int )n0->edgeVec.size() ; i++ )
+    //==== Delete Flagged Edges =====//
+    for ( int i = 0 ; i < ( int )garbageEdgeVec.size() ; i++ )
     {
-        Edge* e = n0->edgeVec[i];
-        if ( e != edge && e != ea0 && e != ea1 && e != eb0 && e != eb1 )
-        {
-            e->ReplaceNode( n0, nc );
-//CheckValidEdge(e);
-            nc->AddConnectEdge( e );
-            CheckValidEdge( e );
-        }
+        delete garbageEdgeVec[i];
     }
-    //==== Change Edges That Point To n1 ====//
-    for ( int i = 0 ; i < ( int )n1->edgeVec.size() ; i++ )
+    garbageEdgeVec.clear();
+
+    //==== Delete Flagged Faces =====//
+    for ( int i = 0 ; i < ( int )garbageFaceVec.size() ; i++ )
     {
-        Edge* e = n1->edgeVec[i];
-        if ( e != edge && e != ea0 && e != ea1 && e != eb0 && e != eb1 )
-        {
-            e->ReplaceNode( n1, nc );
-//CheckValidEdge(e);
-            nc->AddConnectEdge( e );
-            CheckValidEdge( e );
-        }
+        delete garbageFaceVec[i];
     }
-//if ( ecb->t0 )
-//{
-//assert( ecb->t0->Contains( ecb ) );
-//assert( ecb->t0->Contains( ecb->n0, ecb->n1 ) );
-//}
-
-    RemoveEdge( edge );
-    RemoveNode( n0 );
-    RemoveNode( n1 );
-    RemoveFace( fa );
-    RemoveFace( fb );
-    RemoveEdge( ea0 );
-    RemoveEdge( ea1 );
-    RemoveEdge( eb0 );
-    RemoveEdge( eb1 );
-
-    ComputeTargetEdgeLength( nc );
-    LimitTargetEdgeLength( nc );
-
-//CheckValidAllEdges( );
-
+    garbageFaceVec.clear();
 }
 
-void Mesh::LaplacianSmooth( int num_iter )
+void Mesh::SetNodeFlags()
 {
-    for ( int i = 0 ; i < num_iter ; i++ )
+    list< Node* >::iterator n;
+    for ( n = nodeList.begin() ; n != nodeList.end(); ++n )
     {
-        list< Node* >::iterator n;
-        for ( n = nodeList.begin() ; n != nodeList.end(); ++n )
-        {
-            if ( !( *n )->m_DeleteMeFlag && !( *n )->fixed )
-            {
-                ////(*n)->LaplacianSmoothUW();
-                ////(*n)->pnt = m_Surf->CompPnt((*n)->uw.x(), (*n)->uw.y());
-                //(*n)->LaplacianSmooth();
-                //vec2d uw = m_Surf->ClosestUW( (*n)->pnt, (*n)->uw.x(), (*n)->uw.y(), 0.001, 0.001 );
-                //(*n)->pnt = m_Surf->CompPnt( uw.x(), uw.y());
-                //(*n)->uw = uw;
-//              (*n)->LaplacianSmooth( m_Surf );
-                ( *n )->AreaWeightedLaplacianSmooth( m_Surf );
-            }
-        }
+        ( *n )->fixed = false;
     }
-}
 
-void Mesh::OptSmooth( int num_iter )
-{
-    for ( int i = 0 ; i < num_iter ; i++ )
+    list< Edge* >::iterator e;
+    for ( e = edgeList.begin() ; e != edgeList.end(); ++e )
     {
-        list< Node* >::iterator n;
-        for ( n = nodeList.begin() ; n != nodeList.end(); ++n )
+        if ( ( *e )->border || ( *e )->ridge )
         {
-            if ( !( *n )->m_DeleteMeFlag && !( *n )->fixed )
-            {
-                ( *n )->OptSmooth();
-            }
+            ( *e )->n0->fixed = true;
+            ( *e )->n1->fixed = true;
         }
     }
 }
@@ -1426,33 +624,6 @@ bool Mesh::SetFixPoint( const vec3d &fix_pnt, vec2d fix_uw )
     return false;
 }
 
-void Mesh::AdjustEdgeLengths()
-{
-    //==== Find Avg Edge Length ====//
-    double avg_length = 0.0;
-    list< Edge* >::iterator e;
-    for ( e = edgeList.begin() ; e != edgeList.end(); ++e )
-    {
-        avg_length += dist( ( *e )->n0->pnt, ( *e )->n1->pnt );
-    }
-
-    avg_length /= ( double )edgeList.size();
-
-    for ( e = edgeList.begin() ; e != edgeList.end(); ++e )
-    {
-        if ( !( *e )->n0->fixed && !( *e )->n1->fixed )
-        {
-            vec3d  dir = ( *e )->n0->pnt - ( *e )->n1->pnt;
-            double len = dir.mag();
-            double scale = 1.0 + 0.25 * ( ( avg_length / len ) - 1.0 );
-
-            ( *e )->n0->pnt = ( *e )->n1->pnt + dir * scale;
-            ( *e )->n1->pnt = ( *e )->n0->pnt - dir * scale;
-        }
-
-    }
-}
-
 void Mesh::ComputeTargetEdgeLength( Node* n )
 {
     for( int i = 0; i < ( int )n->edgeVec.size(); i++ )
@@ -1479,7 +650,6 @@ void Mesh::ComputeTargetEdgeLength( Edge* edge )
     }
 }
 
-
 void Mesh::CheckValidAllEdges()
 {
     list< Edge* >::iterator e;
@@ -2454,60 +1624,61 @@ void Mesh::WriteSimpleSTL( const char* file_name )
     FILE* file_id = fopen( file_name, "w" );
     if ( file_id )
     {
-        fprintf( file_id, "solid\n" );
+        ExportBuffer buf( file_id );
 
-        WriteSimpleSTL( file_id );
+        buf.Append( "solid\n" );
 
-        fprintf( file_id, "endsolid\n" );
+        WriteSimpleSTL( buf );
+
+        buf.Append( "endsolid\n" );
+        buf.Flush();
         fclose( file_id );
     }
 }
 
 
 
-void Mesh::WriteSimpleSTL( FILE* file_id )
+void Mesh::WriteSimpleSTL( ExportBuffer & buf, bool binary )
 {
-    for ( int i = 0 ; i < ( int )simpFaceVec.size() ; i++ )
+    ExportUtil::ParallelAppend( buf, ( int )simpFaceVec.size(), [&]( ExportBuffer & b, int i )
     {
-        SimpFace* f = &simpFaceVec[i];
+        const SimpFace* f = &simpFaceVec[i];
 
-        vec3d& p0 = simpPntVec[f->ind0];
-        vec3d& p1 = simpPntVec[f->ind1];
-        vec3d& p2 = simpPntVec[f->ind2];
+        const vec3d& p0 = simpPntVec[f->ind0];
+        const vec3d& p1 = simpPntVec[f->ind1];
+        const vec3d& p2 = simpPntVec[f->ind2];
         vec3d v01 = p1 - p0;
         vec3d v12 = p2 - p1;
         vec3d norm = cross( v01, v12 );
         norm.normalize();
 
-        fprintf( file_id, " facet normal  %2.10le %2.10le %2.10le\n", norm.x(), norm.y(), norm.z() );
-        fprintf( file_id, "   outer loop\n" );
-
-        fprintf( file_id, "     vertex %2.10le %2.10le %2.10le\n", p0.x(), p0.y(), p0.z() );
-        fprintf( file_id, "     vertex %2.10le %2.10le %2.10le\n", p1.x(), p1.y(), p1.z() );
-        fprintf( file_id, "     vertex %2.10le %2.10le %2.10le\n", p2.x(), p2.y(), p2.z() );
-
-        fprintf( file_id, "   endloop\n" );
-        fprintf( file_id, " endfacet\n" );
+        if ( binary )
+        {
+            ExportUtil::AppendBinarySTLFacet( b, norm, p0, p1, p2 );
+        }
+        else
+        {
+            ExportUtil::AppendSTLFacet( b, norm, p0, p1, p2 );
+        }
 
         if ( f->m_isQuad ) // Split quad and write additional tri.
         {
-            vec3d& p3 = simpPntVec[f->ind3];
+            const vec3d& p3 = simpPntVec[f->ind3];
             vec3d v23 = p3 - p2;
             vec3d v30 = p0 - p3;
             norm = cross( v23, v30 );
             norm.normalize();
 
-            fprintf( file_id, " facet normal  %2.10le %2.10le %2.10le\n", norm.x(), norm.y(), norm.z() );
-            fprintf( file_id, "   outer loop\n" );
-
-            fprintf( file_id, "     vertex %2.10le %2.10le %2.10le\n", p0.x(), p0.y(), p0.z() );
-            fprintf( file_id, "     vertex %2.10le %2.10le %2.10le\n", p2.x(), p2.y(), p2.z() );
-            fprintf( file_id, "     vertex %2.10le %2.10le %2.10le\n", p3.x(), p3.y(), p3.z() );
-
-            fprintf( file_id, "   endloop\n" );
-            fprintf( file_id, " endfacet\n" );
+            if ( binary )
+            {
+                ExportUtil::AppendBinarySTLFacet( b, norm, p0, p2, p3 );
+            }
+            else
+            {
+                ExportUtil::AppendSTLFacet( b, norm, p0, p2, p3 );
+            }
         }
-    }
+    } );
 }
 
 void Mesh::WriteSTL( const char* file_name )
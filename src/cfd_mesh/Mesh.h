@@ -17,6 +17,7 @@
 
 class Surf;
 class SimpleGridDensity;
+class HalfEdgeMesh;
 class SurfaceIntersectionSingleton;
 
 #ifndef WIN32
@@ -32,6 +33,7 @@ class SurfaceIntersectionSingleton;
 #include <unordered_map>
 using namespace std;
 
+class ExportBuffer;
 
 class MeshSeg
 {
@@ -60,20 +62,13 @@ public:
     static int CheckDupOrAdd( int ind, unordered_map< int, vector< int > > & indMap, const vector< vec3d > & pntVec );
 
 
-    int Split( int num_iter );
-    void SplitEdge( Edge* edge );
-
-    static bool ThreeEdgesThreeFaces( Edge* edge );
-    void SwapEdge( Edge* edge );
-
-    int Collapse( int num_iter );
-    static bool ValidCollapse( Edge* edge );
-    void CollapseEdge( Edge* edge );
-
     int RemoveRevFaces();
 
-    void LimitTargetEdgeLength();
-    void LimitTargetEdgeLength( Edge* e );
+    // Remeshing operators live in HalfEdgeMesh.  These copy the triangle mesh
+    // into and out of the index based representation.
+    void BuildHalfEdgeMesh( HalfEdgeMesh & hem );
+    void LoadHalfEdgeMesh( const HalfEdgeMesh & hem );
+
     void LimitTargetEdgeLength( Node* n );
     void LimitTargetEdgeLength( Edge* e, Node* notn );
 
@@ -82,15 +77,10 @@ public:
 
     void SetNodeFlags();
 
-    void LaplacianSmooth( int num_iter );
-    void OptSmooth( int num_iter );
-
     bool SetFixPoint( const vec3d &fix_pnt, vec2d fix_uw );
 
     void DumpGarbage();
 
-    void AdjustEdgeLengths();
-
     static void CheckValidEdge( Edge* e );
     void CheckValidAllEdges();
 
@@ -98,8 +88,6 @@ public:
     void  RemoveNode( Node* nptr );
     Node* FindNode( const vec3d& p );
 
-    static bool ValidNodeMove( Node* nptr, const vec3d & move_to, Face* ignoreFace = nullptr );
-
     Edge* AddEdge( Node* n0, Node* n1 );
     void  RemoveEdge( Edge* eptr );
     Edge* FindEdge( Node* n0, Node* n1 );
@@ -120,7 +108,7 @@ public:
 
     void ReadSTL( const char* file_name );
     void WriteSimpleSTL( const char* file_name );
-    void WriteSimpleSTL( FILE* file_id );
+    void WriteSimpleSTL( ExportBuffer & buf, bool binary = false );
 
     void WriteSTL( const char* file_name );
     void WriteSTL( FILE* file_id );
@@ -145,8 +133,6 @@ public:
         m_HighlightEdgeIndex = ( m_HighlightEdgeIndex + 1 ) % ( int )edgeList.size();
     }
 
-    void CollapseHighlightEdge();
-
     void ColorTris();
 
     int GetNumFaces()
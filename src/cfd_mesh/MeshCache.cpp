@@ -0,0 +1,59 @@
+//
+// This file is released under the terms of the NASA Open Source Agreement (NOSA)
+// version 1.3 as detailed in the LICENSE file which accompanies this software.
+//
+
+// MeshCache
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "MeshCache.h"
+
+void GeomHash::AddBytes( const void* data, size_t n )
+{
+    const unsigned char* p = ( const unsigned char* )data;
+    for ( size_t i = 0 ; i < n ; i++ )
+    {
+        m_Hash ^= p[i];
+        m_Hash *= 1099511628211ULL;
+    }
+}
+
+void GeomHash::Add( double d )
+{
+    // Treat -0.0 and 0.0 alike.
+    if ( d == 0.0 )
+    {
+        d = 0.0;
+    }
+    AddBytes( &d, sizeof( d ) );
+}
+
+void GeomHash::Add( int i )
+{
+    AddBytes( &i, sizeof( i ) );
+}
+
+void GeomHash::Add( bool b )
+{
+    unsigned char c = b ? 1 : 0;
+    AddBytes( &c, sizeof( c ) );
+}
+
+void GeomHash::Add( uint64_t h )
+{
+    AddBytes( &h, sizeof( h ) );
+}
+
+void GeomHash::Add( const vec2d & v )
+{
+    Add( v.x() );
+    Add( v.y() );
+}
+
+void GeomHash::Add( const vec3d & v )
+{
+    Add( v.x() );
+    Add( v.y() );
+    Add( v.z() );
+}
@@ -0,0 +1,105 @@
+//
+// This file is released under the terms of the NASA Open Source Agreement (NOSA)
+// version 1.3 as detailed in the LICENSE file which accompanies this software.
+//
+
+//////////////////////////////////////////////////////////////////////
+// MeshCache.h
+//
+// Support for incremental re-meshing.  GeomHash accumulates a 64 bit
+// FNV-1a hash over the data a meshing stage depends on.  The intersection
+// cache stores the segments found between two surfaces keyed by the pair of
+// surface geometry hashes, and the remesh cache stores the final mesh of a
+// surface keyed by its geometry, target map and initial mesh.  Entries hold
+// no pointers into the current surfaces, so they survive CleanUp().
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(MESHCACHE_MESHCACHE__INCLUDED_)
+#define MESHCACHE_MESHCACHE__INCLUDED_
+
+#include "Vec2d.h"
+#include "Vec3d.h"
+#include "HalfEdgeMesh.h"
+
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+using namespace std;
+
+//////////////////////////////////////////////////////////////////////
+class GeomHash
+{
+public:
+
+    GeomHash()
+    {
+        m_Hash = 14695981039346656037ULL;
+    }
+
+    void AddBytes( const void* data, size_t n );
+
+    void Add( double d );
+    void Add( int i );
+    void Add( bool b );
+    void Add( uint64_t h );
+    void Add( const vec2d & v );
+    void Add( const vec3d & v );
+
+    template < class T >
+    void AddVec( const vector< T > & v )
+    {
+        Add( ( int )v.size() );
+        if ( !v.empty() )
+        {
+            AddBytes( v.data(), v.size() * sizeof( T ) );
+        }
+    }
+
+    uint64_t Get() const
+    {
+        return m_Hash;
+    }
+
+protected:
+
+    uint64_t m_Hash;
+};
+
+//////////////////////////////////////////////////////////////////////
+// One segment created by SurfaceIntersectionSingleton::AddIntersectionSeg.
+class IntersectSegRecord
+{
+public:
+
+    vec3d m_Pnt[2];
+    vec2d m_UWA[2];
+    vec2d m_UWB[2];
+
+    vector < vec3d > m_PatchADrawLines;
+    vector < vec3d > m_PatchBDrawLines;
+};
+
+typedef map< pair< uint64_t, uint64_t >, vector< IntersectSegRecord > > IntersectCache;
+
+//////////////////////////////////////////////////////////////////////
+// Final mesh of one surface.  m_InitMesh is kept so a hash collision can
+// never substitute a different mesh.
+class RemeshCacheEntry
+{
+public:
+
+    RemeshCacheEntry()
+    {
+        m_NumRevRemoved = 0;
+    }
+
+    HalfEdgeMesh m_InitMesh;
+    HalfEdgeMesh m_Mesh;
+    int m_NumRevRemoved;
+};
+
+typedef unordered_map< uint64_t, RemeshCacheEntry > RemeshCache;
+
+#endif
@@ -201,6 +201,12 @@ SimpleCfdMeshSettings::SimpleCfdMeshSettings()
     m_DrawSymmFlag = false;
     m_DrawWakeFlag = false;
     m_DrawBadFlag = false;
+
+    m_BinarySTLFlag = false;
+    m_BinaryTRIFlag = false;
+    m_BinaryGmshFlag = false;
+
+    m_IncrementalFlag = false;
 }
 
 SimpleCfdMeshSettings::~SimpleCfdMeshSettings()
@@ -249,6 +255,12 @@ void SimpleCfdMeshSettings::CopyFrom( CfdMeshSettings* settings )
 
     m_XYZIntCurveFlag = settings->m_XYZIntCurveFlag.Get();
 
+    m_BinarySTLFlag = settings->m_BinarySTLFlag.Get();
+    m_BinaryTRIFlag = settings->m_BinaryTRIFlag.Get();
+    m_BinaryGmshFlag = settings->m_BinaryGmshFlag.Get();
+
+    m_IncrementalFlag = settings->m_IncrementalFlag.Get();
+
     m_ExportFileNames = settings->GetExportFileNames();
 
     SimpleMeshCommonSettings::CopyFrom( settings );
@@ -127,6 +127,12 @@ public:
     bool m_DrawWakeFlag;
     bool m_DrawBadFlag;
 
+    bool m_BinarySTLFlag;
+    bool m_BinaryTRIFlag;
+    bool m_BinaryGmshFlag;
+
+    bool m_IncrementalFlag;
+
 };
 
 class SimpleFeaMeshSettings : public SimpleMeshCommonSettings
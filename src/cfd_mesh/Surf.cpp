@@ -15,6 +15,7 @@
 #include "CfdMeshMgr.h"
 #include "SubSurfaceMgr.h"
 #include "IntersectPatch.h"
+#include "MeshCache.h"
 #include "VspUtil.h"
 #include <cfloat>  //For DBL_EPSILON
 #include "Vec3d.h"
@@ -68,6 +69,7 @@ Surf::Surf()
     m_FeaSymmIndex = -1;
     m_IgnoreSurfFlag = false;
     m_PlanarUWAspect = -1;
+    m_GeomHash = 0;
 }
 
 Surf::~Surf()
@@ -529,6 +531,28 @@ double Surf::InterpTargetMap( double u, double w, int &reason )
     return t;
 }
 
+void Surf::AddTargetMapHash( GeomHash & hash ) const
+{
+    hash.Add( m_NumMap );
+    hash.Add( ( int )m_SrcMap.size() );
+    for ( int i = 0 ; i < ( int )m_SrcMap.size() ; i++ )
+    {
+        hash.Add( ( int )m_SrcMap[i].size() );
+        for ( int j = 0 ; j < ( int )m_SrcMap[i].size() ; j++ )
+        {
+            hash.Add( m_SrcMap[i][j].m_str );
+            hash.Add( m_SrcMap[i][j].m_reason );
+        }
+    }
+}
+
+void Surf::UpdateGeomHash()
+{
+    GeomHash hash;
+    m_SurfCore.AddHash( hash );
+    m_GeomHash = hash.Get();
+}
+
 void Surf::UWtoTargetMapij( double u, double w, int &i, int &j, double &fraci, double &fracj )
 {
     int npatchu = m_SurfCore.GetNumUPatches();
@@ -773,31 +797,46 @@ void Surf::WriteSTL( const char* filename )
 
 void Surf::Intersect( Surf* surfPtr, SurfaceIntersectionSingleton *MeshMgr )
 {
-    int i;
-
-    if ( surfPtr->GetCompID() == m_CompID )
+    if ( !IntersectCandidate( surfPtr ) )
     {
         return;
     }
-
-    if ( m_FeaSymmIndex >= 0 && surfPtr->GetFeaSymmIndex() != m_FeaSymmIndex )
+    if ( BorderCurveOnSurface( surfPtr, MeshMgr ) )
     {
         return;
     }
-
-    if ( !Compare( m_BBox, surfPtr->GetBBox() ) )
+    if ( surfPtr->BorderCurveOnSurface( this, MeshMgr ) )
     {
         return;
     }
-    if ( BorderCurveOnSurface( surfPtr, MeshMgr ) )
+
+    MeshMgr->IntersectSurfPatches( this, surfPtr );
+}
+
+//==== Checks That Do Not Depend On Or Change Mesh State ====//
+bool Surf::IntersectCandidate( Surf* surfPtr )
+{
+    if ( surfPtr->GetCompID() == m_CompID )
     {
-        return;
+        return false;
     }
-    if ( surfPtr->BorderCurveOnSurface( this, MeshMgr ) )
+
+    if ( m_FeaSymmIndex >= 0 && surfPtr->GetFeaSymmIndex() != m_FeaSymmIndex )
     {
-        return;
+        return false;
     }
 
+    if ( !Compare( m_BBox, surfPtr->GetBBox() ) )
+    {
+        return false;
+    }
+    return true;
+}
+
+void Surf::IntersectPatches( Surf* surfPtr, SurfaceIntersectionSingleton *MeshMgr )
+{
+    int i;
+
     vector< SurfPatch* > otherPatchVec = surfPtr->GetPatchVec();
     for ( i = 0 ; i < ( int )m_PatchVec.size() ; i++ )
         if ( Compare( *m_PatchVec[i]->get_bbox(), surfPtr->GetBBox() ) )
@@ -22,6 +22,7 @@
 #include "TwoDNN.h"
 
 #include <cassert>
+#include <cstdint>
 
 #include <string>
 #include <vector>
@@ -33,6 +34,7 @@ using namespace std;
 class SurfaceIntersectionSingleton;
 class SCurve;
 class ISegChain;
+class GeomHash;
 
 // Tolerance used with nanoflann to merge coincident points.
 // 1e-6 Causes OpenABF to crash when it is sent an empty set
@@ -77,6 +79,7 @@ public:
     void LimitTargetMap();
     void LimitTargetMap( const MSCloud &es_cloud, const MSTree &es_tree, double minmap );
     double InterpTargetMap( double u, double w, int &reason );
+    void AddTargetMapHash( GeomHash & hash ) const;
     void UWtoTargetMapij( double u, double w, int &i, int &j, double &fraci, double &fracj );
     void UWtoTargetMapij( double u, double w, int &i, int &j );
 
@@ -183,6 +186,8 @@ public:
     }
 
     void Intersect( Surf* surfPtr, SurfaceIntersectionSingleton *MeshMgr );
+    bool IntersectCandidate( Surf* surfPtr );
+    void IntersectPatches( Surf* surfPtr, SurfaceIntersectionSingleton *MeshMgr );
     void IntersectLineSeg( vec3d & p0, vec3d & p1, vector< double > & t_vals );
 
     bool BorderCurveOnSurface( Surf* surfPtr, SurfaceIntersectionSingleton *MeshMgr );
@@ -194,6 +199,13 @@ public:
     }
     void SetBBox( const vec3d &pmin, const vec3d &pmax );
 
+    // Hash of the surface geometry for the incremental mesh caches.
+    void UpdateGeomHash();
+    uint64_t GetGeomHash() const
+    {
+        return m_GeomHash;
+    }
+
     vector< SurfPatch* >& GetPatchVec()
     {
         return m_PatchVec;
@@ -409,6 +421,7 @@ protected:
     double m_PlanarUWAspect;
 
     SurfCore m_SurfCore;
+    uint64_t m_GeomHash;
 
     BndBox m_BBox;
     vector< SurfPatch* > m_PatchVec;
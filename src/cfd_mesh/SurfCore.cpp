@@ -4,6 +4,7 @@
 //
 
 #include "SurfCore.h"
+#include "MeshCache.h"
 #include "BezierCurve.h"
 #include "eli/geom/intersect/distance_angle_surface.hpp"
 #include "StlHelper.h"
@@ -716,6 +717,42 @@ void SurfCore::BuildPatches( Surf* srf ) const
     srf->SetPatchVec( patchVec );
 }
 
+void SurfCore::AddHash( GeomHash & hash ) const
+{
+    hash.Add( ( int ) m_Surface.number_u_patches() );
+    hash.Add( ( int ) m_Surface.number_v_patches() );
+
+    for ( int ip = 0; ip < m_Surface.number_u_patches(); ip++ )
+    {
+        for ( int jp = 0; jp < m_Surface.number_v_patches(); jp++ )
+        {
+            double umin = 0;
+            double du = 0;
+            double vmin = 0;
+            double dv = 0;
+            const surface_patch_type *patch = m_Surface.get_patch( ip, jp, umin, du, vmin, dv );
+
+            hash.Add( umin );
+            hash.Add( du );
+            hash.Add( vmin );
+            hash.Add( dv );
+            hash.Add( ( int ) patch->degree_u() );
+            hash.Add( ( int ) patch->degree_v() );
+
+            for ( int icp = 0; icp <= patch->degree_u(); icp++ )
+            {
+                for ( int jcp = 0; jcp <= patch->degree_v(); jcp++ )
+                {
+                    surface_point_type cp = patch->get_control_point( icp, jcp );
+                    hash.Add( cp.x() );
+                    hash.Add( cp.y() );
+                    hash.Add( cp.z() );
+                }
+            }
+        }
+    }
+}
+
 double SurfCore::FindNearest( double &u, double &w, const vec3d &pt, double u0, double w0 ) const
 {
     double dist;
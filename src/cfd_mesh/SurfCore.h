@@ -29,6 +29,7 @@ using std::vector;
 
 class Bezier_curve;
 class Surf;
+class GeomHash;
 
 //////////////////////////////////////////////////////////////////////
 class SurfCore
@@ -121,6 +122,9 @@ public:
 
     void BuildPatches( Surf* srf ) const;
 
+    // Hash the patch parameterization and control points.
+    void AddHash( GeomHash & hash ) const;
+
     double FindNearest( double &u, double &w, const vec3d &pt, double u0, double w0 ) const;
     double FindNearest( double &u, double &w, const vec3d &pt, double u0, double w0, double umin, double umax, double vmin, double vmax ) const;
     double FindNearest( double &u, double &w, const vec3d &pt ) const;
@@ -13,6 +13,13 @@
 
 typedef piecewise_surface_type::bounding_box_type surface_bounding_box_type;
 
+// Sub-patches are cached down to this depth.  Deeper levels are specific to
+// one surface pair, so they are split on the stack as they always were.
+static int s_MaxCachedSubDepth = 6;
+
+static std::atomic < long long > s_NumPairTests( 0 );
+static std::atomic < long long > s_NumSubPatches( 0 );
+
 //////////////////////////////////////////////////////////////////////
 
 SurfPatch::SurfPatch()
@@ -22,8 +29,10 @@ SurfPatch::SurfPatch()
     m_SurfPtr = nullptr;
     sub_depth = 0;
 
-    m_wasplanar = false;
-    m_checkedplanar = false;
+    m_ObbHalf[0] = m_ObbHalf[1] = m_ObbHalf[2] = 0.0;
+
+    m_PlanarState = -1;
+    m_SubPatches = nullptr;
 }
 
 SurfPatch::SurfPatch( int n, int m, int d ) : m_Patch( n, m )
@@ -33,15 +42,18 @@ SurfPatch::SurfPatch( int n, int m, int d ) : m_Patch( n, m )
     m_SurfPtr = nullptr;
     sub_depth = d;
 
-    m_wasplanar = false;
-    m_checkedplanar = false;
+    m_ObbHalf[0] = m_ObbHalf[1] = m_ObbHalf[2] = 0.0;
+
+    m_PlanarState = -1;
+    m_SubPatches = nullptr;
 }
 
 SurfPatch::~SurfPatch()
 {
+    clear_sub_patches();
 }
 
-//==== Compute Bounding Box ====//
+//==== Compute Axis Aligned And Oriented Bounding Boxes ====//
 void SurfPatch::compute_bnd_box()
 {
     surface_bounding_box_type bbx;
@@ -54,6 +66,137 @@ void SurfPatch::compute_bnd_box()
     bnd_box.Reset();
     bnd_box.Update( v3min );
     bnd_box.Update( v3max );
+
+    // Orient the box with the patch.  Any orthonormal frame bounds the
+    // control points, so degenerate patches fall back to the global axes.
+    long n( degree_u() ), m( degree_v() );
+
+    vec3d c00 = m_Patch.get_control_point( 0, 0 );
+    vec3d cn0 = m_Patch.get_control_point( n, 0 );
+    vec3d c0m = m_Patch.get_control_point( 0, m );
+    vec3d cnm = m_Patch.get_control_point( n, m );
+
+    vec3d du = ( cn0 - c00 ) + ( cnm - c0m );
+    vec3d dw = ( c0m - c00 ) + ( cnm - cn0 );
+
+    double tiny = 1.0e-12 * ( 1.0 + bnd_box.DiagDist() );
+
+    m_ObbAxis[0] = vec3d( 1, 0, 0 );
+    m_ObbAxis[1] = vec3d( 0, 1, 0 );
+    m_ObbAxis[2] = vec3d( 0, 0, 1 );
+
+    if ( du.mag() > tiny )
+    {
+        du.normalize();
+        dw = dw - du * dot( dw, du );
+        if ( dw.mag() > tiny )
+        {
+            dw.normalize();
+            m_ObbAxis[0] = du;
+            m_ObbAxis[1] = dw;
+            m_ObbAxis[2] = cross( du, dw );
+        }
+    }
+
+    double pmin[3], pmax[3];
+    for ( int k = 0; k < 3; k++ )
+    {
+        pmin[k] = DBL_MAX;
+        pmax[k] = -DBL_MAX;
+    }
+
+    for ( int i = 0; i <= n; i++ )
+    {
+        for ( int j = 0; j <= m; j++ )
+        {
+            vec3d cp = m_Patch.get_control_point( i, j );
+            for ( int k = 0; k < 3; k++ )
+            {
+                double d = dot( cp, m_ObbAxis[k] );
+                pmin[k] = min( pmin[k], d );
+                pmax[k] = max( pmax[k], d );
+            }
+        }
+    }
+
+    m_ObbCenter = vec3d( 0, 0, 0 );
+    for ( int k = 0; k < 3; k++ )
+    {
+        m_ObbCenter = m_ObbCenter + m_ObbAxis[k] * ( 0.5 * ( pmin[k] + pmax[k] ) );
+        m_ObbHalf[k] = 0.5 * ( pmax[k] - pmin[k] );
+    }
+}
+
+//==== Oriented Box Overlap ====//
+// A patch lies inside the hull of its control points, so patches whose
+// boxes are separated can not intersect at any subdivision level.
+bool SurfPatch::obb_overlap( const SurfPatch& other ) const
+{
+    const vec3d* a = m_ObbAxis;
+    const vec3d* b = other.m_ObbAxis;
+    const double* ha = m_ObbHalf;
+    const double* hb = other.m_ObbHalf;
+
+    vec3d t = other.m_ObbCenter - m_ObbCenter;
+
+    // Relative slop so touching patches are never separated by round off.
+    double tol = 1.0e-12 + 1.0e-9 * ( ha[0] + ha[1] + ha[2] + hb[0] + hb[1] + hb[2] );
+
+    double r[3][3];
+    for ( int i = 0; i < 3; i++ )
+    {
+        for ( int j = 0; j < 3; j++ )
+        {
+            r[i][j] = dot( a[i], b[j] );
+        }
+    }
+
+    for ( int i = 0; i < 3; i++ )
+    {
+        double ra = ha[i];
+        double rb = hb[0] * std::abs( r[i][0] ) + hb[1] * std::abs( r[i][1] ) + hb[2] * std::abs( r[i][2] );
+        if ( std::abs( dot( t, a[i] ) ) > ra + rb + tol )
+        {
+            return false;
+        }
+    }
+
+    for ( int j = 0; j < 3; j++ )
+    {
+        double ra = ha[0] * std::abs( r[0][j] ) + ha[1] * std::abs( r[1][j] ) + ha[2] * std::abs( r[2][j] );
+        double rb = hb[j];
+        if ( std::abs( dot( t, b[j] ) ) > ra + rb + tol )
+        {
+            return false;
+        }
+    }
+
+    for ( int i = 0; i < 3; i++ )
+    {
+        for ( int j = 0; j < 3; j++ )
+        {
+            vec3d axis = cross( a[i], b[j] );
+            double len = axis.mag();
+            if ( len < 1.0e-6 ) // Near parallel axes, covered by the face axes.
+            {
+                continue;
+            }
+
+            double ra = 0.0;
+            double rb = 0.0;
+            for ( int k = 0; k < 3; k++ )
+            {
+                ra += ha[k] * std::abs( dot( a[k], axis ) );
+                rb += hb[k] * std::abs( dot( b[k], axis ) );
+            }
+            if ( std::abs( dot( t, axis ) ) > ra + rb + tol * len )
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
 }
 
 //===== Split Patch =====//
@@ -116,6 +259,95 @@ void SurfPatch::split_patch( SurfPatch& bp00, SurfPatch& bp10, SurfPatch& bp01,
 
 }
 
+void SurfPatch::validate_derivatives() const
+{
+    m_Patch.f_u( 0, 0 );
+    m_Patch.f_v( 0, 0 );
+    m_Patch.f_uu( 0, 0 );
+    m_Patch.f_uv( 0, 0 );
+    m_Patch.f_vv( 0, 0 );
+}
+
+//===== Cached Sub-Patches =====//
+const SurfPatch* SurfPatch::get_sub_patches() const
+{
+    SurfPatch* sub = m_SubPatches.load( std::memory_order_acquire );
+    if ( sub || sub_depth >= s_MaxCachedSubDepth )
+    {
+        return sub;
+    }
+
+    int n = degree_u();
+    int m = degree_v();
+
+    SurfPatch* newsub = new SurfPatch[4];
+    for ( int i = 0; i < 4; i++ )
+    {
+        newsub[i].m_Patch.resize( n, m );
+        newsub[i].sub_depth = sub_depth + 1;
+    }
+    split_patch( newsub[0], newsub[1], newsub[2], newsub[3] );
+    CountSubPatches( 4 );
+
+    // Sub-patches are shared once published, so nothing may be built lazily after.
+    for ( int i = 0; i < 4; i++ )
+    {
+        newsub[i].validate_derivatives();
+    }
+
+    // Another thread may have built the same split first.  Keep theirs.
+    if ( m_SubPatches.compare_exchange_strong( sub, newsub, std::memory_order_acq_rel ) )
+    {
+        return newsub;
+    }
+
+    delete[] newsub;
+    return sub;
+}
+
+void SurfPatch::clear_sub_patches()
+{
+    SurfPatch* sub = m_SubPatches.exchange( nullptr );
+    delete[] sub;
+}
+
+void SurfPatch::SetMaxCachedSubDepth( int d )
+{
+    s_MaxCachedSubDepth = d;
+}
+
+int SurfPatch::GetMaxCachedSubDepth()
+{
+    return s_MaxCachedSubDepth;
+}
+
+//===== Intersection Statistics =====//
+void SurfPatch::ResetStats()
+{
+    s_NumPairTests = 0;
+    s_NumSubPatches = 0;
+}
+
+long long SurfPatch::GetNumPairTests()
+{
+    return s_NumPairTests;
+}
+
+long long SurfPatch::GetNumSubPatches()
+{
+    return s_NumSubPatches;
+}
+
+void SurfPatch::CountPairTest()
+{
+    s_NumPairTests.fetch_add( 1, std::memory_order_relaxed );
+}
+
+void SurfPatch::CountSubPatches( int n )
+{
+    s_NumSubPatches.fetch_add( n, std::memory_order_relaxed );
+}
+
 //===== Test If Patch Is Planar (within tol)  =====//
 bool SurfPatch::test_planar( double tol ) const
 {
@@ -125,9 +357,10 @@ bool SurfPatch::test_planar( double tol ) const
 //===== Test If Patch Is Planar (within relative tol)  =====//
 bool SurfPatch::test_planar_rel( double reltol ) const
 {
-    if ( m_checkedplanar )
+    int state = m_PlanarState.load( std::memory_order_relaxed );
+    if ( state >= 0 )
     {
-        return m_wasplanar;
+        return state == 1;
     }
 
     surface_patch_type approx = m_Patch;
@@ -135,13 +368,12 @@ bool SurfPatch::test_planar_rel( double reltol ) const
 
     double dst = m_Patch.simple_eqp_distance_bound( approx );
 
-    // These variables are mutable -- to allow this to still be a const method.
-    // Set m_lastreltol after setting m_wasplanar as a defense against any future race
-    // condition.
-    m_wasplanar = dst < ( reltol * bnd_box.DiagDist() );
-    m_checkedplanar = true;
+    // Mutable -- to allow this to still be a const method.  Cached sub-patches
+    // are shared between threads, which all compute the same answer.
+    bool planar = dst < ( reltol * bnd_box.DiagDist() );
+    m_PlanarState.store( planar ? 1 : 0, std::memory_order_relaxed );
 
-    return m_wasplanar;
+    return planar;
 }
 
 //===== Find Closest UW On Patch to Given Point with Initial Guess  =====//
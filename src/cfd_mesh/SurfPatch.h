@@ -18,6 +18,7 @@
 #include "Vec3d.h"
 #include "BndBox.h"
 
+#include <atomic>
 #include <cassert>
 #include <cfloat>
 
@@ -104,6 +105,32 @@ public:
     void compute_bnd_box();
 
     void split_patch( SurfPatch& bp00, SurfPatch& bp10, SurfPatch& bp01, SurfPatch& bp11 ) const;
+
+    // Code-Eli builds derivative patches on first use, which is not thread
+    // safe.  Build those used by find_closest_uw before sharing the patch.
+    void validate_derivatives() const;
+
+    // The four patches made by split_patch, built on first use and kept so
+    // every partner surface shares them.  Safe to call from several threads.
+    // Returns nullptr below the cached depth, where callers split locally.
+    const SurfPatch* get_sub_patches() const;
+    void clear_sub_patches();
+
+    // Depth limit of the cached splits, zero disables the cache.  Not to be
+    // changed while an intersection is running.
+    static void SetMaxCachedSubDepth( int d );
+    static int GetMaxCachedSubDepth();
+
+    // Separating axis test of the oriented boxes around the control points.
+    bool obb_overlap( const SurfPatch& other ) const;
+
+    //==== Intersection Statistics ====//
+    static void ResetStats();
+    static long long GetNumPairTests();
+    static long long GetNumSubPatches();
+    static void CountPairTest();
+    static void CountSubPatches( int n );
+
     bool test_planar( double tol ) const;
     bool test_planar_rel( double reltol ) const;
 
@@ -146,8 +173,16 @@ protected:
 
     int sub_depth;
 
-    mutable bool m_wasplanar;
-    mutable bool m_checkedplanar; // Flag to indicate if test_planar or test_planar_rel has been called for the patch
+    // Oriented box around the control points.
+    vec3d m_ObbCenter;
+    vec3d m_ObbAxis[3];
+    double m_ObbHalf[3];
+
+    // -1 until test_planar or test_planar_rel has been called for the patch, then 0 or 1.
+    mutable std::atomic < int > m_PlanarState;
+
+    // Array of four cached sub-patches, see get_sub_patches().
+    mutable std::atomic < SurfPatch* > m_SubPatches;
 
 };
 
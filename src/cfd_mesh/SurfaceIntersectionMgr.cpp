@@ -11,6 +11,7 @@
 #include "VspUtil.h"
 #include "SubSurfaceMgr.h"
 #include "StringUtil.h"
+#include "ParallelUtil.h"
 #include <cfloat>  //For DBL_EPSILON
 #include "ModeMgr.h"
 
@@ -334,6 +335,10 @@ void WakeMgrSingleton::Show( bool flag )
 //=============================================================//
 
 
+// Segments found by AddIntersectionSeg are recorded here instead of being
+// added when set.  Thread local so patch intersections can run concurrently.
+static thread_local vector< IntersectSegRecord >* t_IntersectRecordVec = nullptr;
+
 SurfaceIntersectionSingleton::SurfaceIntersectionSingleton() : ParmContainer()
 {
     m_Vehicle = VehicleMgr.GetVehicle();
@@ -346,6 +351,9 @@ SurfaceIntersectionSingleton::SurfaceIntersectionSingleton() : ParmContainer()
 
     m_MeshInProgress = false;
 
+    m_IncrementalFlag = false;
+    m_NumCachedIntersect = 0;
+
     m_MessageName = "SurfIntersectMessage";
 
 #ifdef DEBUG_CFD_MESH
@@ -1799,6 +1807,24 @@ void SurfaceIntersectionSingleton::Intersect()
 
     if ( GetSettingsPtr()->m_IntersectSubSurfs ) BuildSubSurfIntChains();
 
+    if ( m_IncrementalFlag )
+    {
+        for ( int i = 0 ; i < n; i++ )
+        {
+            m_SurfVec[i]->UpdateGeomHash();
+        }
+        m_NextIntersectCache.clear();
+        m_NumCachedIntersect = 0;
+    }
+    else
+    {
+        ClearMeshCache();
+    }
+
+    SurfPatch::ResetStats();
+
+    PreIntersectSurfPatches();
+
     //==== Quad Tree Intersection - Intersection Segments Get Loaded at AddIntersectionSeg ===//
     for ( int i = 0 ; i < n; i++ )
     {
@@ -1814,6 +1840,33 @@ void SurfaceIntersectionSingleton::Intersect()
         addOutputText( str );
     }
 
+    m_PatchIsectMap.clear();
+
+    // Sub-patches are only shared within one pass.
+    for ( int i = 0 ; i < n; i++ )
+    {
+        vector< SurfPatch* > & patch_vec = m_SurfVec[i]->GetPatchVec();
+        for ( int j = 0 ; j < ( int )patch_vec.size() ; j++ )
+        {
+            patch_vec[j]->clear_sub_patches();
+        }
+    }
+
+#ifdef DEBUG_CFD_MESH
+    fprintf( m_DebugFile, "SurfaceIntersectionSingleton::Intersect \n" );
+    fprintf( m_DebugFile, "  Patch pair tests %lld, sub-patches built %lld\n", SurfPatch::GetNumPairTests(), SurfPatch::GetNumSubPatches() );
+#endif
+
+    if ( m_IncrementalFlag )
+    {
+        // Keep only the pairs seen in this pass.
+        m_IntersectCache.swap( m_NextIntersectCache );
+        m_NextIntersectCache.clear();
+
+        snprintf( str, sizeof( str ), "Reused %d of %d surface pair intersections\n", m_NumCachedIntersect, ( int )m_IntersectCache.size() );
+        addOutputText( str );
+    }
+
     // WriteISegs();
 
     addOutputText( "BuildChains\n" );
@@ -1933,64 +1986,219 @@ void SurfaceIntersectionSingleton::AddIntersectionSeg( const SurfPatch& pA, cons
     vec2d proj_uwB1;
     pB.find_closest_uw( ip1, plane_uwB1.v, proj_uwB1.v );
 
-    Puw* puwA0 = new Puw( pA.get_surf_ptr(), proj_uwA0 );
+    IntersectSegRecord rec;
+    rec.m_Pnt[0] = ip0;
+    rec.m_Pnt[1] = ip1;
+    rec.m_UWA[0] = proj_uwA0;
+    rec.m_UWA[1] = proj_uwA1;
+    rec.m_UWB[0] = proj_uwB0;
+    rec.m_UWB[1] = proj_uwB1;
+
+    // Identify rectangles to represent final patches
+    rec.m_PatchADrawLines = pA.GetPatchDrawLines();
+    rec.m_PatchBDrawLines = pB.GetPatchDrawLines();
+
+    if ( t_IntersectRecordVec )
+    {
+        t_IntersectRecordVec->push_back( rec );
+    }
+    else
+    {
+        AddIntersectionSeg( pA.get_surf_ptr(), pB.get_surf_ptr(), rec );
+    }
+
+#ifdef DEBUG_CFD_MESH
+
+    static bool onetime = true;
+    static int ipntcnt = 0;
+    static double max_dist = 0.0;
+    if ( onetime )
+    {
+        fprintf( m_DebugFile, "CfdMeshMgr::AddIntersectionSeg \n" );
+        onetime = false;
+    }
+
+    double dA0 = dist( ip0, pA.get_surf_ptr()->CompPnt( proj_uwA0.x(), proj_uwA0.y() ) );
+    double dB0 = dist( ip0, pB.get_surf_ptr()->CompPnt( proj_uwB0.x(), proj_uwB0.y() ) );
+
+    double dA1 = dist( ip1, pA.get_surf_ptr()->CompPnt( proj_uwA1.x(), proj_uwA1.y() ) );
+    double dB1 = dist( ip1, pB.get_surf_ptr()->CompPnt( proj_uwB1.x(), proj_uwB1.y() ) );
+
+    double total_d = dA0 + dB0 + dA1 + dB1;
+
+    if ( total_d > max_dist )
+    {
+        max_dist = total_d;
+        fprintf( m_DebugFile, "  Proj Pnt Dist = %f    %d \n", max_dist, ipntcnt );
+    }
+    ipntcnt++;
+
+#endif
+}
+
+
+void SurfaceIntersectionSingleton::AddIntersectionSeg( Surf* surfA, Surf* surfB, const IntersectSegRecord & rec )
+{
+    Puw* puwA0 = new Puw( surfA, rec.m_UWA[0] );
     m_DelPuwVec.push_back( puwA0 );
 
-    Puw* puwB0 = new Puw( pB.get_surf_ptr(), proj_uwB0 );
+    Puw* puwB0 = new Puw( surfB, rec.m_UWB[0] );
     m_DelPuwVec.push_back( puwB0 );
 
     IPnt* ipnt0 = new IPnt( puwA0, puwB0 );
-    ipnt0->m_Pnt = ip0;
+    ipnt0->m_Pnt = rec.m_Pnt[0];
     m_DelIPntVec.push_back( ipnt0 );
 
-    Puw* puwA1 = new Puw( pA.get_surf_ptr(), proj_uwA1 );
+    Puw* puwA1 = new Puw( surfA, rec.m_UWA[1] );
     m_DelPuwVec.push_back( puwA1 );
 
-    Puw* puwB1 = new Puw( pB.get_surf_ptr(), proj_uwB1 );
+    Puw* puwB1 = new Puw( surfB, rec.m_UWB[1] );
     m_DelPuwVec.push_back( puwB1 );
 
     IPnt* ipnt1 = new IPnt( puwA1, puwB1 );
-    ipnt1->m_Pnt = ip1;
+    ipnt1->m_Pnt = rec.m_Pnt[1];
     m_DelIPntVec.push_back( ipnt1 );
 
-    // Identify rectangles to represent final patches
-    m_IPatchADrawLines.push_back( pA.GetPatchDrawLines() );
-    m_IPatchBDrawLines.push_back( pB.GetPatchDrawLines() );
+    m_IPatchADrawLines.push_back( rec.m_PatchADrawLines );
+    m_IPatchBDrawLines.push_back( rec.m_PatchBDrawLines );
 
-    new ISeg( pA.get_surf_ptr(), pB.get_surf_ptr(), ipnt0, ipnt1 );
+    new ISeg( surfA, surfB, ipnt0, ipnt1 );
 
     m_AllIPnts.push_back( ipnt0 );
     m_AllIPnts.push_back( ipnt1 );
+}
 
-#ifdef DEBUG_CFD_MESH
+//==== Intersect The Patches Of Two Surfaces ====//
+// Segments come from the incremental cache, from PreIntersectSurfPatches or
+// are computed here.  Either way they are added in the order they were found.
+void SurfaceIntersectionSingleton::IntersectSurfPatches( Surf* surfA, Surf* surfB )
+{
+    vector< IntersectSegRecord > rec_vec;
+    vector< IntersectSegRecord >* recs = nullptr;
 
-    static bool onetime = true;
-    static int ipntcnt = 0;
-    static double max_dist = 0.0;
-    if ( onetime )
+    // The segments depend only on the patches of the two surfaces.
+    pair< uint64_t, uint64_t > key( surfA->GetGeomHash(), surfB->GetGeomHash() );
+
+    if ( m_IncrementalFlag )
     {
-        fprintf( m_DebugFile, "CfdMeshMgr::AddIntersectionSeg \n" );
-        onetime = false;
+        IntersectCache::iterator it = m_NextIntersectCache.find( key );
+        if ( it == m_NextIntersectCache.end() )
+        {
+            IntersectCache::iterator old = m_IntersectCache.find( key );
+            if ( old != m_IntersectCache.end() )
+            {
+                it = m_NextIntersectCache.insert( make_pair( key, std::move( old->second ) ) ).first;
+                m_IntersectCache.erase( old );
+                m_NumCachedIntersect++;
+            }
+        }
+        if ( it != m_NextIntersectCache.end() )
+        {
+            recs = &it->second;
+        }
+    }
+
+    if ( !recs )
+    {
+        map< pair< Surf*, Surf* >, vector< IntersectSegRecord > >::iterator pit = m_PatchIsectMap.find( make_pair( surfA, surfB ) );
+        if ( pit != m_PatchIsectMap.end() )
+        {
+            rec_vec.swap( pit->second );
+            m_PatchIsectMap.erase( pit );
+        }
+        else
+        {
+            ComputePatchIntersections( surfA, surfB, rec_vec );
+        }
+
+        recs = &rec_vec;
+        if ( m_IncrementalFlag )
+        {
+            recs = &m_NextIntersectCache[ key ];
+            recs->swap( rec_vec );
+        }
     }
 
-    double dA0 = dist( ip0, puwA0->m_Surf->CompPnt( puwA0->m_UW.x(), puwA0->m_UW.y() ) );
-    double dB0 = dist( ip0, puwB0->m_Surf->CompPnt( puwB0->m_UW.x(), puwB0->m_UW.y() ) );
+    for ( int i = 0 ; i < ( int )recs->size() ; i++ )
+    {
+        AddIntersectionSeg( surfA, surfB, ( *recs )[i] );
+    }
+}
 
-    double dA1 = dist( ip1, puwA0->m_Surf->CompPnt( puwA1->m_UW.x(), puwA1->m_UW.y() ) );
-    double dB1 = dist( ip1, puwB0->m_Surf->CompPnt( puwB1->m_UW.x(), puwB1->m_UW.y() ) );
+//==== Record The Segments Between The Patches Of Two Surfaces Without Changing Mesh State ====//
+void SurfaceIntersectionSingleton::ComputePatchIntersections( Surf* surfA, Surf* surfB, vector< IntersectSegRecord > & rec_vec )
+{
+    t_IntersectRecordVec = &rec_vec;
+    surfA->IntersectPatches( surfB, this );
+    t_IntersectRecordVec = nullptr;
+}
 
-    double total_d = dA0 + dB0 + dA1 + dB1;
+//==== Intersect Patches Of All Candidate Surface Pairs Concurrently ====//
+// Pairs rejected later by the border curve checks are computed needlessly,
+// but those are rare and the serial loop in Intersect() keeps every decision.
+void SurfaceIntersectionSingleton::PreIntersectSurfPatches()
+{
+    m_PatchIsectMap.clear();
 
-    if ( total_d > max_dist )
+    vector< pair< Surf*, Surf* > > pair_vec;
+
+    int n = m_SurfVec.size();
+    for ( int i = 0 ; i < n; i++ )
     {
-        max_dist = total_d;
-        fprintf( m_DebugFile, "  Proj Pnt Dist = %f    %d \n", max_dist, ipntcnt );
+        for ( int j = i + 1; j < n; j++ )
+        {
+            if ( !m_SurfVec[i]->IntersectCandidate( m_SurfVec[j] ) )
+            {
+                continue;
+            }
+
+            if ( m_IncrementalFlag )
+            {
+                pair< uint64_t, uint64_t > key( m_SurfVec[i]->GetGeomHash(), m_SurfVec[j]->GetGeomHash() );
+                if ( m_IntersectCache.find( key ) != m_IntersectCache.end() )
+                {
+                    continue;
+                }
+            }
+
+            pair_vec.push_back( make_pair( m_SurfVec[i], m_SurfVec[j] ) );
+        }
     }
-    ipntcnt++;
 
-#endif
+    if ( pair_vec.size() < 2 )
+    {
+        return;
+    }
+
+    // Patches are shared by all pairs of a surface.
+    for ( int i = 0 ; i < n; i++ )
+    {
+        vector< SurfPatch* > & patch_vec = m_SurfVec[i]->GetPatchVec();
+        for ( int j = 0 ; j < ( int )patch_vec.size(); j++ )
+        {
+            patch_vec[j]->validate_derivatives();
+        }
+    }
+
+    vector< vector< IntersectSegRecord > > rec_vecs( pair_vec.size() );
+
+    ParallelUtil::ParallelFor( ( int )pair_vec.size(), [&]( int k )
+    {
+        ComputePatchIntersections( pair_vec[k].first, pair_vec[k].second, rec_vecs[k] );
+    } );
+
+    for ( size_t k = 0; k < pair_vec.size(); k++ )
+    {
+        m_PatchIsectMap[ pair_vec[k] ].swap( rec_vecs[k] );
+    }
 }
 
+void SurfaceIntersectionSingleton::ClearMeshCache()
+{
+    m_IntersectCache.clear();
+    m_NextIntersectCache.clear();
+    m_NumCachedIntersect = 0;
+}
 
 ISeg* SurfaceIntersectionSingleton::CreateSurfaceSeg(  Surf* surfA, vec2d & uwA0, vec2d & uwA1, Surf* surfB, vec2d & uwB0, vec2d & uwB1   )
 {
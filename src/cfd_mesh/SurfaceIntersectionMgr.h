@@ -65,6 +65,7 @@
 #include "ISegChain.h"
 #include "GridDensity.h"
 #include "BezierCurve.h"
+#include "MeshCache.h"
 #include "Vehicle.h"
 #include "MeshCommonSettings.h"
 #include "SimpleSubSurface.h"
@@ -262,6 +263,10 @@ public:
 
 //  virtual void AddISeg( Surf* sA, Surf* sB, vec2d & sAuw0, vec2d & sAuw1,  vec2d & sBuw0, vec2d & sBuw1 );
     virtual void AddIntersectionSeg( const SurfPatch& pA, const SurfPatch& pB, const vec3d & ip0, const vec3d & ip1 );
+    virtual void AddIntersectionSeg( Surf* surfA, Surf* surfB, const IntersectSegRecord & rec );
+    virtual void IntersectSurfPatches( Surf* surfA, Surf* surfB );
+    virtual void ComputePatchIntersections( Surf* surfA, Surf* surfB, vector< IntersectSegRecord > & rec_vec );
+    virtual void PreIntersectSurfPatches();
 //  virtual ISeg* CreateSurfaceSeg( Surf* sPtr, vec3d & p0, vec3d & p1, vec2d & uw0, vec2d & uw1 );
     virtual ISeg* CreateSurfaceSeg( Surf* surfA, vec2d & uwA0, vec2d & uwA1, Surf* surfB, vec2d & uwB0, vec2d & uwB1  );
 
@@ -296,6 +301,9 @@ public:
 
     virtual void HighlightNextChain();
 
+    // Drop everything kept for incremental re-meshing.
+    virtual void ClearMeshCache();
+
     virtual void AddDelPuw( Puw* puw )
     {
         m_DelPuwVec.push_back( puw );
@@ -417,6 +425,15 @@ protected:
 
     SimpleIntersectSettings m_IntersectSettings;
 
+    //==== Incremental Re-Meshing ====//
+    bool m_IncrementalFlag;                             // Reuse results for unchanged surfaces
+    IntersectCache m_IntersectCache;                    // Segments from the previous Intersect()
+    IntersectCache m_NextIntersectCache;                // Segments from the current Intersect()
+    int m_NumCachedIntersect;
+
+    // Patch intersections computed concurrently ahead of the serial Intersect() loop.
+    map< pair< Surf*, Surf* >, vector< IntersectSegRecord > > m_PatchIsectMap;
+
     //==== Vector of Surfs that may have a border that lies on Surf A ====//
     unordered_map< Surf*, vector< Surf* > > m_PossCoPlanarSurfMap;
 
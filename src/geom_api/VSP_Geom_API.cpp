@@ -46,6 +46,7 @@
 #include "WingGeom.h"
 #include "StlHelper.h"
 #include "ModeMgr.h"
+#include "ParallelUtil.h"
 
 #include <cstdlib>
 #include <csignal>
@@ -10058,10 +10059,12 @@ vector < vec3d > CompVecPnt01( const std::string &geom_id, const int &surf_indx,
             {
                 pts.resize( us.size() );
 
-                for ( int i = 0; i < us.size(); i++ )
+                surf->ValidateDerivatives();
+
+                ParallelUtil::ParallelFor( ( int ) us.size(), [&]( int i )
                 {
                     pts[i] = surf->CompPnt01( clamp( us[i], 0.0, 1.0 ), clamp( ws[i], 0.0, 1.0 ) );
-                }
+                } );
             }
             else
             {
@@ -10148,10 +10151,12 @@ vector < vec3d > CompVecNorm01( const std::string &geom_id, const int &surf_indx
             {
                 norms.resize( us.size() );
 
-                for ( int i = 0; i < us.size(); i++ )
+                surf->ValidateDerivatives();
+
+                ParallelUtil::ParallelFor( ( int ) us.size(), [&]( int i )
                 {
                     norms[i] = surf->CompNorm01( clamp( us[i], 0.0, 1.0 ), clamp( ws[i], 0.0, 1.0 ) );
-                }
+                } );
             }
             else
             {
@@ -10198,10 +10203,12 @@ void CompVecCurvature01( const std::string &geom_id, const int &surf_indx, const
                 ka_out_vec.resize( us.size() );
                 kg_out_vec.resize( us.size() );
 
-                for ( int i = 0; i < us.size(); i++ )
+                surf->ValidateDerivatives();
+
+                ParallelUtil::ParallelFor( ( int ) us.size(), [&]( int i )
                 {
                     surf->CompCurvature01( clamp( us[i], 0.0, 1.0 ), clamp( ws[i], 0.0, 1.0 ), k1_out_vec[i], k2_out_vec[i], ka_out_vec[i], kg_out_vec[i] );
-                }
+                } );
             }
             else
             {
@@ -10243,10 +10250,14 @@ void ProjVecPnt01(const std::string &geom_id, const int &surf_indx, const vector
             w_out_vec.resize( pts.size() );
             d_out_vec.resize( pts.size() );
 
-            for ( int i = 0; i < pts.size(); i++ )
+            // Index is built once here, the threads below only read it.
+            surf->ValidateDerivatives();
+            surf->BuildSearchIndex();
+
+            ParallelUtil::ParallelFor( ( int ) pts.size(), [&]( int i )
             {
-                d_out_vec[i] = surf->FindNearest01( u_out_vec[i], w_out_vec[i], pts[i] );
-            }
+                d_out_vec[i] = surf->FindNearest01Indexed( u_out_vec[i], w_out_vec[i], pts[i] );
+            } );
         }
         else
         {
@@ -10284,10 +10295,12 @@ void ProjVecPnt01Guess( const std::string &geom_id, const int &surf_indx, const
                 w_out_vec.resize( pts.size() );
                 d_out_vec.resize( pts.size() );
 
-                for ( int i = 0; i < pts.size(); i++ )
+                surf->ValidateDerivatives();
+
+                ParallelUtil::ParallelFor( ( int ) pts.size(), [&]( int i )
                 {
                     d_out_vec[i] = surf->FindNearest01( u_out_vec[i], w_out_vec[i], pts[i], clamp( u0s[i], 0.0, 1.0 ), clamp( w0s[i], 0.0, 1.0 ) );
-                }
+                } );
             }
             else
             {
@@ -10329,10 +10342,12 @@ void AxisProjVecPnt01(const std::string &geom_id, const int &surf_indx, const in
             w_out_vec.resize( pts.size() );
             d_out_vec.resize( pts.size() );
 
-            for ( int i = 0; i < pts.size(); i++ )
+            surf->ValidateDerivatives();
+
+            ParallelUtil::ParallelFor( ( int ) pts.size(), [&]( int i )
             {
                 d_out_vec[i] = surf->ProjectPt01( pts[i], iaxis, u_out_vec[i], w_out_vec[i] );
-            }
+            } );
         }
         else
         {
@@ -10370,10 +10385,12 @@ void AxisProjVecPnt01Guess(const std::string &geom_id, const int &surf_indx, con
                 w_out_vec.resize( pts.size() );
                 d_out_vec.resize( pts.size() );
 
-                for ( int i = 0; i < pts.size(); i++ )
+                surf->ValidateDerivatives();
+
+                ParallelUtil::ParallelFor( ( int ) pts.size(), [&]( int i )
                 {
                     d_out_vec[i] = surf->ProjectPt01( pts[i], iaxis, clamp( u0s[i], 0.0, 1.0 ), clamp( w0s[i], 0.0, 1.0 ), u_out_vec[i], w_out_vec[i] );
-                }
+                } );
             }
             else
             {
@@ -10412,9 +10429,19 @@ std::vector < bool > VecInsideSurf( const std::string &geom_id, const int &surf_
         {
             ret.resize( pts.size(), false );
 
+            // vector < bool > packs bits, threads may not write neighbouring entries.
+            vector < char > inside( pts.size(), 0 );
+
+            surf->ValidateDerivatives();
+
+            ParallelUtil::ParallelFor( ( int ) pts.size(), [&]( int i )
+            {
+                inside[i] = surf->IsInside( pts[i] );
+            } );
+
             for ( int i = 0; i < pts.size(); i++ )
             {
-                ret[i] = surf->IsInside( pts[i] );
+                ret[i] = inside[i];
             }
         }
         else
@@ -10499,7 +10526,31 @@ void FindRSTVec( const std::string &geom_id, const int &surf_indx, const std::ve
             t_out_vec.resize( pts.size() );
             d_out_vec.resize( pts.size() );
 
-            surf->FindRST( pts, r_out_vec, s_out_vec, t_out_vec, d_out_vec );
+            surf->ValidateDerivatives();
+
+            // Blocks of points, so each thread sets up the batch search once per block.
+            int nblock = 4 * ParallelUtil::NumThreads();
+            int block_size = std::max( 64, ( int ) ( pts.size() + nblock - 1 ) / nblock );
+            nblock = ( int ) ( pts.size() + block_size - 1 ) / block_size;
+
+            ParallelUtil::ParallelFor( nblock, [&]( int iblock )
+            {
+                int begin = iblock * block_size;
+                int end = std::min( ( int ) pts.size(), begin + block_size );
+
+                vector < vec3d > block_pts( pts.begin() + begin, pts.begin() + end );
+                vector < double > r, s, t, d;
+
+                surf->FindRST( block_pts, r, s, t, d );
+
+                for ( int i = begin; i < end; i++ )
+                {
+                    r_out_vec[i] = r[ i - begin ];
+                    s_out_vec[i] = s[ i - begin ];
+                    t_out_vec[i] = t[ i - begin ];
+                    d_out_vec[i] = d[ i - begin ];
+                }
+            } );
         }
         else
         {
@@ -10539,10 +10590,12 @@ void FindRSTVecGuess( const std::string &geom_id, const int &surf_indx, const st
                 t_out_vec.resize( pts.size() );
                 d_out_vec.resize( pts.size() );
 
-                for ( int i = 0; i < pts.size(); i++ )
+                surf->ValidateDerivatives();
+
+                ParallelUtil::ParallelFor( ( int ) pts.size(), [&]( int i )
                 {
                     d_out_vec[i] = surf->FindRST( pts[i], clamp( r0s[i], 0.0, 1.0 ), clamp( s0s[i], 0.0, 1.0 ), clamp( t0s[i], 0.0, 1.0 ), r_out_vec[i], s_out_vec[i], t_out_vec[i] );
-                }
+                } );
             }
             else
             {
@@ -10588,10 +10641,12 @@ void ConvertRSTtoLMNVec( const std::string &geom_id, const int &surf_indx,
                 m_out_vec.resize( r_vec.size() );
                 n_out_vec.resize( r_vec.size() );
 
-                for ( int i = 0; i < r_vec.size(); i++ )
+                surf->ValidateDerivatives();
+
+                ParallelUtil::ParallelFor( ( int ) r_vec.size(), [&]( int i )
                 {
                     surf->ConvertRSTtoLMN( r_vec[i], s_vec[i], t_vec[i], l_out_vec[i], m_out_vec[i], n_out_vec[i] );
-                }
+                } );
             }
             else
             {
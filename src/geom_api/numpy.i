@@ -1,11 +1,147 @@
 /* File : numpy.i */
 %{
 #include <numpy/arrayobject.h>
+
+#include <cstring>
+#include <vector>
+#include "VSP_Geom_API.h"
+#include "Vec3d.h"
+
+// vec3d arrays are handed to NumPy as (N, 3) arrays of double.
+static_assert( sizeof( vec3d ) == 3 * sizeof( double ), "vec3d must be three packed doubles" );
+
+//==== Lifetime of NumPy arrays made here ====//
+//
+// as_numpy() on a vec3d, Vec3dVec, DoubleVector or IntVector returns a copy.
+//
+// as_numpy_view() on a Vec3dVec, DoubleVector or IntVector shares the vector's
+// memory.  The array holds a reference to the vector's proxy, so the vector lives
+// as long as the array, but resizing the vector from Python invalidates the array.
+//
+// Get*ResultsView() shares the memory of the results data held by the ResultsMgr.
+// The array is read only and valid until those results are deleted (DeleteResult,
+// DeleteAllResults) or replaced.  Call copy() on it to keep the values longer.
+//
+// The *Array() surface queries return arrays that own their data; the result
+// vectors are handed to NumPy without a copy.
+
+template < class T >
+static void VspNumpyFreeVector( PyObject* capsule )
+{
+    delete ( std::vector< T > * ) PyCapsule_GetPointer( capsule, "vsp.vector" );
+}
+
+template < class T > struct VspNumpyTraits;
+template <> struct VspNumpyTraits< double > { enum { TYPE = NPY_DOUBLE, NCOMP = 1 }; };
+template <> struct VspNumpyTraits< int > { enum { TYPE = NPY_INT, NCOMP = 1 }; };
+template <> struct VspNumpyTraits< vec3d > { enum { TYPE = NPY_DOUBLE, NCOMP = 3 }; };
+
+// Array over n entries of data, (n) or (n, 3) for vec3d.  base, if given, is
+// stored as the array's base and keeps the memory alive.
+template < class T >
+static PyObject* VspNumpyWrap( const T* data, size_t n, PyObject* base, bool writeable )
+{
+    int ncomp = VspNumpyTraits< T >::NCOMP;
+    npy_intp dims[2] = { ( npy_intp ) n, ncomp };
+    int nd = ( ncomp > 1 ) ? 2 : 1;
+
+    if ( n == 0 )
+    {
+        return PyArray_SimpleNew( nd, dims, VspNumpyTraits< T >::TYPE );
+    }
+
+    PyObject* arr = PyArray_New( &PyArray_Type, nd, dims, VspNumpyTraits< T >::TYPE, NULL, ( void* ) data, 0,
+                                 writeable ? NPY_ARRAY_CARRAY : NPY_ARRAY_CARRAY_RO, NULL );
+
+    if ( arr && base )
+    {
+        Py_INCREF( base );
+        PyArray_SetBaseObject( ( PyArrayObject* ) arr, base );
+    }
+    return arr;
+}
+
+// Array that takes over vec's memory, freed when the array is.
+template < class T >
+static PyObject* VspNumpyTake( std::vector< T > & vec )
+{
+    if ( vec.empty() )
+    {
+        return VspNumpyWrap< T >( NULL, 0, NULL, true );
+    }
+
+    std::vector< T >* owned = new std::vector< T >();
+    owned->swap( vec );
+
+    PyObject* capsule = PyCapsule_New( owned, "vsp.vector", VspNumpyFreeVector< T > );
+    PyObject* arr = VspNumpyWrap< T >( owned->data(), owned->size(), capsule, true );
+    Py_DECREF( capsule );
+    return arr;
+}
+
+// Copy of vec into a new array.
+template < class T >
+static PyObject* VspNumpyCopy( const std::vector< T > & vec )
+{
+    int ncomp = VspNumpyTraits< T >::NCOMP;
+    npy_intp dims[2] = { ( npy_intp ) vec.size(), ncomp };
+    PyObject* arr = PyArray_SimpleNew( ( ncomp > 1 ) ? 2 : 1, dims, VspNumpyTraits< T >::TYPE );
+
+    if ( arr && !vec.empty() )
+    {
+        memcpy( PyArray_DATA( ( PyArrayObject* ) arr ), vec.data(), vec.size() * sizeof( T ) );
+    }
+    return arr;
+}
+
+// Fill vec from any array like object, (n) or (n, 3) for vec3d.  Sets a Python
+// error and returns false if obj does not fit.
+template < class T >
+static bool VspNumpyRead( PyObject* obj, std::vector< T > & vec )
+{
+    int ncomp = VspNumpyTraits< T >::NCOMP;
+    int nd = ( ncomp > 1 ) ? 2 : 1;
+
+    PyArrayObject* arr = ( PyArrayObject* ) PyArray_FROMANY( obj, VspNumpyTraits< T >::TYPE, nd, nd, NPY_ARRAY_IN_ARRAY );
+    if ( !arr )
+    {
+        return false;
+    }
+
+    if ( ncomp > 1 && PyArray_DIM( arr, 1 ) != ncomp )
+    {
+        Py_DECREF( arr );
+        PyErr_SetString( PyExc_ValueError, "expected an (N, 3) array of points" );
+        return false;
+    }
+
+    vec.resize( PyArray_DIM( arr, 0 ) );
+    if ( !vec.empty() )
+    {
+        memcpy( ( void* ) vec.data(), PyArray_DATA( arr ), vec.size() * sizeof( T ) );
+    }
+
+    Py_DECREF( arr );
+    return true;
+}
+
+// Tuple of arrays taking over each vector.
+static PyObject* VspNumpyTakeTuple( std::vector< std::vector< double > * > vecs )
+{
+    PyObject* tup = PyTuple_New( vecs.size() );
+    for ( size_t i = 0; i < vecs.size(); i++ )
+    {
+        PyTuple_SET_ITEM( tup, i, VspNumpyTake( *vecs[i] ) );
+    }
+    return tup;
+}
 %}
+
 %init %{
 import_array();
 %}
 %nothread as_numpy;
+%nothread _as_numpy_view;
 
 %extend vec3d{
     PyObject* as_numpy() {
@@ -23,18 +159,215 @@ import_array();
 }
 %extend std::vector<vec3d>{
     PyObject* as_numpy() {
-        int size = self->size();
-        npy_intp dims[2] = {size, 3};
-        PyObject *numpy_array = PyArray_SimpleNew(2, dims, NPY_DOUBLE);
+        return VspNumpyCopy( *self );
+    }
 
-        // Fill the NumPy array with the data from the vector
-        double *data_ptr = (double*)PyArray_DATA((PyArrayObject*)numpy_array);
-        for (int i = 0; i < size; ++i) {
-            data_ptr[i * 3 + 0] = (*self)[i].v[0];
-            data_ptr[i * 3 + 1] = (*self)[i].v[1];
-            data_ptr[i * 3 + 2] = (*self)[i].v[2];
+    PyObject* _as_numpy_view( PyObject* owner ) {
+        return VspNumpyWrap( self->data(), self->size(), owner, true );
+    }
+
+    %pythoncode %{
+    def as_numpy_view(self):
+        """(N, 3) array sharing this vector's memory, valid while the vector is not resized."""
+        return self._as_numpy_view(self)
+    %}
+}
+%extend std::vector<double>{
+    PyObject* as_numpy() {
+        return VspNumpyCopy( *self );
+    }
+
+    PyObject* _as_numpy_view( PyObject* owner ) {
+        return VspNumpyWrap( self->data(), self->size(), owner, true );
+    }
+
+    %pythoncode %{
+    def as_numpy_view(self):
+        """Array sharing this vector's memory, valid while the vector is not resized."""
+        return self._as_numpy_view(self)
+    %}
+}
+%extend std::vector<int>{
+    PyObject* as_numpy() {
+        return VspNumpyCopy( *self );
+    }
+
+    PyObject* _as_numpy_view( PyObject* owner ) {
+        return VspNumpyWrap( self->data(), self->size(), owner, true );
+    }
+
+    %pythoncode %{
+    def as_numpy_view(self):
+        """Array sharing this vector's memory, valid while the vector is not resized."""
+        return self._as_numpy_view(self)
+    %}
+}
+
+/* Read only views of results data, see the lifetime notes above */
+%nothread GetDoubleResultsView;
+%nothread GetIntResultsView;
+%nothread GetVec3dResultsView;
+%nothread GetDoubleMatResultsView;
+
+/* Surface queries with array inputs and outputs, run with the GIL held like the rest of the API */
+%nothread CompVecPnt01Array;
+%nothread CompVecNorm01Array;
+%nothread CompVecCurvature01Array;
+%nothread ProjVecPnt01Array;
+%nothread AxisProjVecPnt01Array;
+%nothread VecInsideSurfArray;
+%nothread FindRSTVecArray;
+%nothread ConvertRSTtoLMNVecArray;
+
+%inline %{
+PyObject* GetDoubleResultsView( const std::string & id, const std::string & name, int index = 0 )
+{
+    const std::vector< double > & data = vsp::GetDoubleResults( id, name, index );
+    return VspNumpyWrap( data.data(), data.size(), NULL, false );
+}
+
+PyObject* GetIntResultsView( const std::string & id, const std::string & name, int index = 0 )
+{
+    const std::vector< int > & data = vsp::GetIntResults( id, name, index );
+    return VspNumpyWrap( data.data(), data.size(), NULL, false );
+}
+
+PyObject* GetVec3dResultsView( const std::string & id, const std::string & name, int index = 0 )
+{
+    const std::vector< vec3d > & data = vsp::GetVec3dResults( id, name, index );
+    return VspNumpyWrap( data.data(), data.size(), NULL, false );
+}
+
+// Rows of a double matrix are stored apart, so this is a list of row views.
+PyObject* GetDoubleMatResultsView( const std::string & id, const std::string & name, int index = 0 )
+{
+    const std::vector< std::vector< double > > & data = vsp::GetDoubleMatResults( id, name, index );
+
+    PyObject* rows = PyList_New( data.size() );
+    for ( size_t i = 0; i < data.size(); i++ )
+    {
+        PyList_SET_ITEM( rows, i, VspNumpyWrap( data[i].data(), data[i].size(), NULL, false ) );
+    }
+    return rows;
+}
+
+PyObject* CompVecPnt01Array( const std::string & geom_id, const int & surf_indx, PyObject* u_in_vec, PyObject* w_in_vec )
+{
+    std::vector< double > us, ws;
+    if ( !VspNumpyRead( u_in_vec, us ) || !VspNumpyRead( w_in_vec, ws ) )
+    {
+        return NULL;
+    }
+
+    std::vector< vec3d > pts = vsp::CompVecPnt01( geom_id, surf_indx, us, ws );
+
+    return VspNumpyTake( pts );
+}
+
+PyObject* CompVecNorm01Array( const std::string & geom_id, const int & surf_indx, PyObject* us_in_vec, PyObject* ws_in_vec )
+{
+    std::vector< double > us, ws;
+    if ( !VspNumpyRead( us_in_vec, us ) || !VspNumpyRead( ws_in_vec, ws ) )
+    {
+        return NULL;
+    }
+
+    std::vector< vec3d > norms = vsp::CompVecNorm01( geom_id, surf_indx, us, ws );
+
+    return VspNumpyTake( norms );
+}
+
+PyObject* CompVecCurvature01Array( const std::string & geom_id, const int & surf_indx, PyObject* us_in_vec, PyObject* ws_in_vec )
+{
+    std::vector< double > us, ws;
+    if ( !VspNumpyRead( us_in_vec, us ) || !VspNumpyRead( ws_in_vec, ws ) )
+    {
+        return NULL;
+    }
+
+    std::vector< double > k1, k2, ka, kg;
+    vsp::CompVecCurvature01( geom_id, surf_indx, us, ws, k1, k2, ka, kg );
+
+    return VspNumpyTakeTuple( { &k1, &k2, &ka, &kg } );
+}
+
+PyObject* ProjVecPnt01Array( const std::string & geom_id, const int & surf_indx, PyObject* pts_in )
+{
+    std::vector< vec3d > pts;
+    if ( !VspNumpyRead( pts_in, pts ) )
+    {
+        return NULL;
+    }
+
+    std::vector< double > u, w, d;
+    vsp::ProjVecPnt01( geom_id, surf_indx, pts, u, w, d );
+
+    return VspNumpyTakeTuple( { &u, &w, &d } );
+}
+
+PyObject* AxisProjVecPnt01Array( const std::string & geom_id, const int & surf_indx, const int & iaxis, PyObject* pts_in )
+{
+    std::vector< vec3d > pts;
+    if ( !VspNumpyRead( pts_in, pts ) )
+    {
+        return NULL;
+    }
+
+    std::vector< double > u, w, d;
+    vsp::AxisProjVecPnt01( geom_id, surf_indx, iaxis, pts, u, w, d );
+
+    return VspNumpyTakeTuple( { &u, &w, &d } );
+}
+
+// vector< bool > packs bits, so this one is copied into a bool array.
+PyObject* VecInsideSurfArray( const std::string & geom_id, const int & surf_indx, PyObject* pts_in )
+{
+    std::vector< vec3d > pts;
+    if ( !VspNumpyRead( pts_in, pts ) )
+    {
+        return NULL;
+    }
+
+    std::vector< bool > inside = vsp::VecInsideSurf( geom_id, surf_indx, pts );
+
+    npy_intp dims[1] = { ( npy_intp ) inside.size() };
+    PyObject* arr = PyArray_SimpleNew( 1, dims, NPY_BOOL );
+    if ( arr )
+    {
+        npy_bool* data = ( npy_bool* ) PyArray_DATA( ( PyArrayObject* ) arr );
+        for ( size_t i = 0; i < inside.size(); i++ )
+        {
+            data[i] = inside[i] ? NPY_TRUE : NPY_FALSE;
         }
+    }
+    return arr;
+}
+
+PyObject* FindRSTVecArray( const std::string & geom_id, const int & surf_indx, PyObject* pts_in )
+{
+    std::vector< vec3d > pts;
+    if ( !VspNumpyRead( pts_in, pts ) )
+    {
+        return NULL;
+    }
 
-        return numpy_array;
+    std::vector< double > r, s, t, d;
+    vsp::FindRSTVec( geom_id, surf_indx, pts, r, s, t, d );
+
+    return VspNumpyTakeTuple( { &r, &s, &t, &d } );
+}
+
+PyObject* ConvertRSTtoLMNVecArray( const std::string & geom_id, const int & surf_indx, PyObject* r_vec, PyObject* s_vec, PyObject* t_vec )
+{
+    std::vector< double > r, s, t;
+    if ( !VspNumpyRead( r_vec, r ) || !VspNumpyRead( s_vec, s ) || !VspNumpyRead( t_vec, t ) )
+    {
+        return NULL;
     }
+
+    std::vector< double > l, m, n;
+    vsp::ConvertRSTtoLMNVec( geom_id, surf_indx, r, s, t, l, m, n );
+
+    return VspNumpyTakeTuple( { &l, &m, &n } );
 }
+%}
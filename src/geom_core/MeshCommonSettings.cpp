@@ -267,8 +267,18 @@ CfdMeshSettings::CfdMeshSettings() : MeshCommonSettings()
 
     m_XYZIntCurveFlag.Init( "SRF_XYZIntCurve", "ExportCFD", this, false, 0, 1 );
 
+    m_BinarySTLFlag.Init( "STL_Binary", "ExportCFD", this, false, 0, 1 );
+    m_BinarySTLFlag.SetDescript( "Flag to write the STL file in binary format" );
+    m_BinaryTRIFlag.Init( "TRI_Binary", "ExportCFD", this, false, 0, 1 );
+    m_BinaryTRIFlag.SetDescript( "Flag to write the Cart3D TRI file as Fortran unformatted binary" );
+    m_BinaryGmshFlag.Init( "GMSH_Binary", "ExportCFD", this, false, 0, 1 );
+    m_BinaryGmshFlag.SetDescript( "Flag to write the Gmsh file in binary format" );
+
     m_ExportRawFlag.Init( "ExportRawFlag", "ExportCFD", this, false, 0, 1 );
 
+    m_IncrementalFlag.Init( "IncrementalRemesh", "Global", this, false, 0, 1 );
+    m_IncrementalFlag.SetDescript( "Flag to reuse intersections and surface meshes of unchanged surfaces from the previous mesh" );
+
     InitCommonParms( false );
 
     m_ExportFileNames.resize( vsp::CFD_NUM_FILE_NAMES );
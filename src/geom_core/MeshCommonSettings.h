@@ -167,6 +167,12 @@ public:
     BoolParm m_ExportFileFlags[vsp::CFD_NUM_FILE_NAMES];
     BoolParm m_XYZIntCurveFlag;
 
+    BoolParm m_BinarySTLFlag;
+    BoolParm m_BinaryTRIFlag;
+    BoolParm m_BinaryGmshFlag;
+
+    BoolParm m_IncrementalFlag;
+
 protected:
 
     // These file names do not get written to file.  They are reset each time
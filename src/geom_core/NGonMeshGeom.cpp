@@ -196,18 +196,18 @@ void NGonMeshGeom::RemovePotentialFiles( const string& file_name )
 }
 
 
-void NGonMeshGeom::WriteVSPGEOM( string fname, vector < string > &all_fnames )
+void NGonMeshGeom::WriteVSPGEOM( string fname, vector < string > &all_fnames, bool binary )
 {
     RemovePotentialFiles( fname );
 
     Matrix4d trans = GetTotalTransMat();
 
-    FILE *file_id = fopen( fname.c_str(), "w" );
+    FILE *file_id = fopen( fname.c_str(), binary ? "wb" : "w" );
 
     if ( file_id )
     {
         all_fnames.push_back( fname );
-        m_PGMulti.WriteVSPGeom( file_id, trans );
+        m_PGMulti.WriteVSPGeom( file_id, trans, binary );
 
         fclose ( file_id );
 
@@ -43,7 +43,7 @@ public:
     virtual void ClearTris();
 
     virtual void RemovePotentialFiles( const string& file_name );
-    virtual void WriteVSPGEOM( string fname, vector < string > &all_fnames );
+    virtual void WriteVSPGEOM( string fname, vector < string > &all_fnames, bool binary = false );
 
     virtual vector< TMesh* > CreateTMeshVec();
 
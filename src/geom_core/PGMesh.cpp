@@ -3860,35 +3860,96 @@ void PGMesh::CleanColinearVerts()
     ClearTris();
 }
 
-void PGMesh::WriteVSPGeom( const string & fname )
+// Binary .vspgeom files hold the same values as the text format, in the same order, as raw
+// 32 bit ints and 64 bit doubles with no separators or comments.  The header line is text,
+// followed by a byte order word.
+static void WriteVSPGeomBinaryInt( FILE* file_id, int i )
+{
+    fwrite( &i, sizeof( int ), 1, file_id );
+}
+
+static void WriteVSPGeomBinaryDouble( FILE* file_id, double d )
+{
+    fwrite( &d, sizeof( double ), 1, file_id );
+}
+
+static void WriteVSPGeomHeader( FILE* file_id, bool binary )
+{
+    if ( binary )
+    {
+        fprintf( file_id, "# vspgeom v3 binary\n" );
+        WriteVSPGeomBinaryInt( file_id, 1 ); // Byte order word.
+    }
+    else
+    {
+        fprintf( file_id, "# vspgeom v3\n" );
+    }
+}
+
+static void WriteVSPGeomMeshSize( FILE* file_id, int nnode, int nface, int nwake, bool binary )
+{
+    if ( binary )
+    {
+        WriteVSPGeomBinaryInt( file_id, nnode );
+        WriteVSPGeomBinaryInt( file_id, nface );
+        WriteVSPGeomBinaryInt( file_id, nwake );
+    }
+    else
+    {
+        fprintf( file_id, "%d %d %d\n", nnode, nface, nwake );
+    }
+}
+
+static void WriteVSPGeomPnt( FILE* file_id, const vec3d & v, bool binary )
+{
+    if ( binary )
+    {
+        WriteVSPGeomBinaryDouble( file_id, v.x() );
+        WriteVSPGeomBinaryDouble( file_id, v.y() );
+        WriteVSPGeomBinaryDouble( file_id, v.z() );
+    }
+    else
+    {
+        fprintf( file_id, "%16.10g %16.10g %16.10g\n", v.x(), v.y(), v.z() );
+    }
+}
+
+void PGMesh::WriteVSPGeom( const string & fname, bool binary )
 {
     Matrix4d mat;
     FILE *file_id = nullptr;
 
-    file_id = fopen( fname.c_str(), "w" );
-    WriteVSPGeom( file_id, mat );
+    file_id = fopen( fname.c_str(), binary ? "wb" : "w" );
+    WriteVSPGeom( file_id, mat, binary );
     fclose( file_id );
 }
 
-void PGMesh::WriteVSPGeom( FILE* file_id, const Matrix4d & XFormMat  )
+void PGMesh::WriteVSPGeom( FILE* file_id, const Matrix4d & XFormMat, bool binary )
 {
     ResetFaceNumbers(); // Not sure if this is required.
 
-    fprintf( file_id, "# vspgeom v3\n" );
-    fprintf( file_id, "1\n" );  // Number of meshes.
-    fprintf( file_id, "%d %d %d\n", m_NodeList.size(),
-                                    m_FaceList.size(),
-                                    m_WingWakeVec.size() + m_BodyWakeVec.size() + m_BodyNodeWakeVec.size() );
-    WriteVSPGeomPnts( file_id, XFormMat );
-    WriteVSPGeomFaces( file_id );
-    WriteVSPGeomParts( file_id );
-    WriteVSPGeomParents( file_id );
-    WriteVSPGeomWakes( file_id );
-    WriteVSPGeomAlternateTris( file_id );
-    WriteVSPGeomAlternateParts( file_id );
+    WriteVSPGeomHeader( file_id, binary );
+    if ( binary )
+    {
+        WriteVSPGeomBinaryInt( file_id, 1 );  // Number of meshes.
+    }
+    else
+    {
+        fprintf( file_id, "1\n" );  // Number of meshes.
+    }
+    WriteVSPGeomMeshSize( file_id, m_NodeList.size(),
+                                   m_FaceList.size(),
+                                   m_WingWakeVec.size() + m_BodyWakeVec.size() + m_BodyNodeWakeVec.size(), binary );
+    WriteVSPGeomPnts( file_id, XFormMat, binary );
+    WriteVSPGeomFaces( file_id, binary );
+    WriteVSPGeomParts( file_id, binary );
+    WriteVSPGeomParents( file_id, binary );
+    WriteVSPGeomWakes( file_id, binary );
+    WriteVSPGeomAlternateTris( file_id, binary );
+    WriteVSPGeomAlternateParts( file_id, binary );
 }
 
-void PGMesh::WriteVSPGeomPnts( FILE* file_id, const Matrix4d & XFormMat )
+void PGMesh::WriteVSPGeomPnts( FILE* file_id, const Matrix4d & XFormMat, bool binary )
 {
     m_PGMulti->ResetPointNumbers();
 
@@ -3900,13 +3961,20 @@ void PGMesh::WriteVSPGeomPnts( FILE* file_id, const Matrix4d & XFormMat )
     {
         // Apply Transformations
         v = XFormMat.xform( ( *n )->m_Pt->m_Pnt );
-        fprintf( file_id, "%16.10g %16.10g %16.10g\n", v.x(), v.y(), v.z() ); // , tnode->m_UWPnt.x(), tnode->m_UWPnt.y() );
+        WriteVSPGeomPnt( file_id, v, binary ); // , tnode->m_UWPnt.x(), tnode->m_UWPnt.y() );
     }
 }
 
-void PGMesh::WriteVSPGeomFaces( FILE* file_id )
+void PGMesh::WriteVSPGeomFaces( FILE* file_id, bool binary )
 {
-    fprintf( file_id, "%d\n", m_FaceList.size() );
+    if ( binary )
+    {
+        WriteVSPGeomBinaryInt( file_id, m_FaceList.size() );
+    }
+    else
+    {
+        fprintf( file_id, "%d\n", m_FaceList.size() );
+    }
 
     //==== Write Out Tris ====//
     int nFaceError = 0;
@@ -3922,6 +3990,21 @@ void PGMesh::WriteVSPGeomFaces( FILE* file_id )
             // index to size-1 because first/last point is repeated.
             int npt = nodVec.size() - 1;
 
+            if ( binary )
+            {
+                WriteVSPGeomBinaryInt( file_id, npt );
+                for ( int i = 0; i < npt; i++ )
+                {
+                    WriteVSPGeomBinaryInt( file_id, nodVec[i] ? nodVec[i]->m_Pt->m_ID + 1 : 1 );
+                    faceError = faceError || !nodVec[i];
+                }
+                if ( faceError )
+                {
+                    nFaceError++;
+                }
+                continue;
+            }
+
             fprintf( file_id, "%d", npt );
             for ( int i = 0; i < npt; i++ )
             {
@@ -3942,6 +4025,11 @@ void PGMesh::WriteVSPGeomFaces( FILE* file_id )
             }
             fprintf( file_id, "\n" );
         }
+        else if ( binary )
+        {
+            WriteVSPGeomBinaryInt( file_id, 0 );
+            nFaceError++;
+        }
         else
         {
             fprintf( file_id, "0                                          # FACE ERROR\n" );
@@ -3955,7 +4043,7 @@ void PGMesh::WriteVSPGeomFaces( FILE* file_id )
     }
 }
 
-void PGMesh::WriteVSPGeomParts( FILE* file_id )
+void PGMesh::WriteVSPGeomParts( FILE* file_id, bool binary )
 {
     //==== Write Component IDs for each Tri =====//
     int tag;
@@ -3975,6 +4063,25 @@ void PGMesh::WriteVSPGeomParts( FILE* file_id )
         double uscale = m_PGMulti->GetUscale( part );
         double wscale = m_PGMulti->GetWscale( part );
 
+        if ( binary )
+        {
+            WriteVSPGeomBinaryInt( file_id, part );
+            WriteVSPGeomBinaryInt( file_id, tag );
+
+            for ( int i = 0; i < npt; i++ )
+            {
+                vec2d uw;
+                if ( nodVec[i] )
+                {
+                    nodVec[i]->GetUW( tag, uw );
+                    uw.set_xy( uw.x() / uscale, uw.y() / wscale );
+                }
+                WriteVSPGeomBinaryDouble( file_id, uw.x() );
+                WriteVSPGeomBinaryDouble( file_id, uw.y() );
+            }
+            continue;
+        }
+
         fprintf( file_id, "%d %d", part, tag );
 
         for ( int i = 0; i < npt; i++ )
@@ -3995,7 +4102,7 @@ void PGMesh::WriteVSPGeomParts( FILE* file_id )
     }
 }
 
-void PGMesh::WriteVSPGeomEdgeWakes( FILE* file_id, const vector < vector < PGEdge* > > &ewake, const vector < int > &partvec, int wingbodyflag ) const
+void PGMesh::WriteVSPGeomEdgeWakes( FILE* file_id, const vector < vector < PGEdge* > > &ewake, const vector < int > &partvec, int wingbodyflag, bool binary ) const
 {
     int nWakeError = 0;
     int nwake = ewake.size();
@@ -4006,6 +4113,18 @@ void PGMesh::WriteVSPGeomEdgeWakes( FILE* file_id, const vector < vector < PGEdg
         GetNodes( ewake[iwake], nodVec );
 
         int nwn = nodVec.size();
+
+        if ( binary )
+        {
+            WriteVSPGeomBinaryInt( file_id, nwn * wingbodyflag );
+            WriteVSPGeomBinaryInt( file_id, partvec[iwake] );
+            for ( int i = 0; i < nwn; i++ )
+            {
+                WriteVSPGeomBinaryInt( file_id, nodVec[i] ? nodVec[i]->m_Pt->m_ID + 1 : 1 );
+            }
+            continue;
+        }
+
         fprintf( file_id, "%d %d ", nwn * wingbodyflag, partvec[iwake] );
 
         int iprt = 0;
@@ -4051,7 +4170,7 @@ void PGMesh::WriteVSPGeomEdgeWakes( FILE* file_id, const vector < vector < PGEdg
     }
 }
 
-void PGMesh::WriteVSPGeomWakes( FILE* file_id ) const
+void PGMesh::WriteVSPGeomWakes( FILE* file_id, bool binary ) const
 {
     int nwwake = m_WingWakeVec.size();
     int nbwake = m_BodyWakeVec.size();
@@ -4059,18 +4178,34 @@ void PGMesh::WriteVSPGeomWakes( FILE* file_id ) const
 
     int nwake = nwwake + nbwake + nbpwake;
 
-    fprintf( file_id, "%d\n", nwake );
+    if ( binary )
+    {
+        WriteVSPGeomBinaryInt( file_id, nwake );
+    }
+    else
+    {
+        fprintf( file_id, "%d\n", nwake );
+    }
 
-    WriteVSPGeomEdgeWakes( file_id, m_WingWakeVec, m_WingWakePartVec, 1 );
-    WriteVSPGeomEdgeWakes( file_id, m_BodyWakeVec, m_BodyWakePartVec, -1 );
+    WriteVSPGeomEdgeWakes( file_id, m_WingWakeVec, m_WingWakePartVec, 1, binary );
+    WriteVSPGeomEdgeWakes( file_id, m_BodyWakeVec, m_BodyWakePartVec, -1, binary );
 
     for ( int iwake = 0; iwake < nbpwake; iwake++ )
     {
-        fprintf( file_id, "-1 %d %d\n", m_BodyNodeWakePartVec[iwake], m_BodyNodeWakeVec[iwake]->m_Pt->m_ID + 1 );
+        if ( binary )
+        {
+            WriteVSPGeomBinaryInt( file_id, -1 );
+            WriteVSPGeomBinaryInt( file_id, m_BodyNodeWakePartVec[iwake] );
+            WriteVSPGeomBinaryInt( file_id, m_BodyNodeWakeVec[iwake]->m_Pt->m_ID + 1 );
+        }
+        else
+        {
+            fprintf( file_id, "-1 %d %d\n", m_BodyNodeWakePartVec[iwake], m_BodyNodeWakeVec[iwake]->m_Pt->m_ID + 1 );
+        }
     }
 }
 
-void PGMesh::WriteVSPGeomAlternateTris( FILE* file_id )
+void PGMesh::WriteVSPGeomAlternateTris( FILE* file_id, bool binary )
 {
     //==== Write Out Tris ====//
     list< PGFace* >::iterator f;
@@ -4081,6 +4216,17 @@ void PGMesh::WriteVSPGeomAlternateTris( FILE* file_id )
 
         int npt = nodVec.size();
 
+        if ( binary )
+        {
+            WriteVSPGeomBinaryInt( file_id, (*f)->m_ID );
+            WriteVSPGeomBinaryInt( file_id, npt / 3 );
+            for ( int i = 0; i < npt; i++ )
+            {
+                WriteVSPGeomBinaryInt( file_id, ( nodVec[i] && nodVec[i]->m_Pt ) ? nodVec[i]->m_Pt->m_ID + 1 : 1 );
+            }
+            continue;
+        }
+
         fprintf( file_id, "%d %d", (*f)->m_ID, npt / 3 );
         for ( int i = 0; i < npt; i++ )
         {
@@ -4097,7 +4243,7 @@ void PGMesh::WriteVSPGeomAlternateTris( FILE* file_id )
     }
 }
 
-void PGMesh::WriteVSPGeomAlternateParts( FILE* file_id )
+void PGMesh::WriteVSPGeomAlternateParts( FILE* file_id, bool binary )
 {
     //==== Write Component IDs for each Tri =====//
     int tag;
@@ -4116,6 +4262,26 @@ void PGMesh::WriteVSPGeomAlternateParts( FILE* file_id )
         double uscale = m_PGMulti->GetUscale( part );
         double wscale = m_PGMulti->GetWscale( part );
 
+        if ( binary )
+        {
+            WriteVSPGeomBinaryInt( file_id, (*f)->m_ID );
+            WriteVSPGeomBinaryInt( file_id, part );
+            WriteVSPGeomBinaryInt( file_id, tag );
+
+            for ( int i = 0; i < npt; i++ )
+            {
+                vec2d uw;
+                if ( nodVec[i] )
+                {
+                    nodVec[i]->GetUW( tag, uw );
+                    uw.set_xy( uw.x() / uscale, uw.y() / wscale );
+                }
+                WriteVSPGeomBinaryDouble( file_id, uw.x() );
+                WriteVSPGeomBinaryDouble( file_id, uw.y() );
+            }
+            continue;
+        }
+
         fprintf( file_id, "%d %d %d", (*f)->m_ID, part, tag );
 
         for ( int i = 0; i < npt; i++ )
@@ -4136,12 +4302,20 @@ void PGMesh::WriteVSPGeomAlternateParts( FILE* file_id )
     }
 }
 
-void PGMesh::WriteVSPGeomParents( FILE* file_id )
+void PGMesh::WriteVSPGeomParents( FILE* file_id, bool binary )
 {
     list< PGFace* >::iterator f;
     for ( f = m_FaceList.begin() ; f != m_FaceList.end(); ++f )
     {
-        fprintf( file_id, "%d %d\n", (*f)->m_ID, (*f)->m_Parent->m_ID );
+        if ( binary )
+        {
+            WriteVSPGeomBinaryInt( file_id, (*f)->m_ID );
+            WriteVSPGeomBinaryInt( file_id, (*f)->m_Parent->m_ID );
+        }
+        else
+        {
+            fprintf( file_id, "%d %d\n", (*f)->m_ID, (*f)->m_Parent->m_ID );
+        }
     }
 }
 
@@ -4742,39 +4916,50 @@ f2 p2 t2 u21 v21 u22 v22...u2n v2n
 ...
 fnalt pnalt tnalt un1 vn2...unn vnn              // Last face then part then tag and UV coordinate
                                               // Loop to next mesh
+
+Binary files start with the header line "# vspgeom v3 binary" followed by the int 1 as a byte order
+word.  The rest of the file is the same values in the same order as above, written as raw 32 bit ints
+and 64 bit doubles.  Nothing else, no line breaks or comments, is written.
 */
 
-void PGMulti::WriteVSPGeom( FILE* file_id, const Matrix4d & XFormMat  )
+void PGMulti::WriteVSPGeom( FILE* file_id, const Matrix4d & XFormMat, bool binary )
 {
-    fprintf( file_id, "# vspgeom v3\n" );
+    WriteVSPGeomHeader( file_id, binary );
 
-    fprintf( file_id, "%d\n", m_MeshVec.size() );
+    if ( binary )
+    {
+        WriteVSPGeomBinaryInt( file_id, m_MeshVec.size() );
+    }
+    else
+    {
+        fprintf( file_id, "%d\n", m_MeshVec.size() );
+    }
     for ( int imesh = m_MeshVec.size() - 1; imesh >= 0; imesh-- )
     {
         PGMesh *pgm = m_MeshVec[imesh];
-        fprintf( file_id, "%d %d %d\n", pgm->m_NodeList.size(),
-                                        pgm->m_FaceList.size(),
-                                        pgm->m_WingWakeVec.size() + pgm->m_BodyWakeVec.size() + pgm->m_BodyNodeWakeVec.size() );
+        WriteVSPGeomMeshSize( file_id, pgm->m_NodeList.size(),
+                                       pgm->m_FaceList.size(),
+                                       pgm->m_WingWakeVec.size() + pgm->m_BodyWakeVec.size() + pgm->m_BodyNodeWakeVec.size(), binary );
     }
 
-    WriteVSPGeomPnts( file_id, XFormMat );
+    WriteVSPGeomPnts( file_id, XFormMat, binary );
 
     // Iterate through meshes coarse to fine.
     for ( int imesh = m_MeshVec.size() - 1; imesh >= 0; imesh-- )
     {
         PGMesh *pgm = m_MeshVec[imesh];
 
-        pgm->WriteVSPGeomFaces( file_id );
-        pgm->WriteVSPGeomParts( file_id );
-        pgm->WriteVSPGeomParents( file_id );
-        pgm->WriteVSPGeomWakes( file_id );
-        pgm->WriteVSPGeomAlternateTris( file_id );
-        pgm->WriteVSPGeomAlternateParts( file_id );
+        pgm->WriteVSPGeomFaces( file_id, binary );
+        pgm->WriteVSPGeomParts( file_id, binary );
+        pgm->WriteVSPGeomParents( file_id, binary );
+        pgm->WriteVSPGeomWakes( file_id, binary );
+        pgm->WriteVSPGeomAlternateTris( file_id, binary );
+        pgm->WriteVSPGeomAlternateParts( file_id, binary );
 
     }
 }
 
-void PGMulti::WriteVSPGeomPnts( FILE* file_id, const Matrix4d & XFormMat )
+void PGMulti::WriteVSPGeomPnts( FILE* file_id, const Matrix4d & XFormMat, bool binary )
 {
     // Set point ID to -1 to mark as un-written.
     for ( list< PGPoint* >::iterator p = m_PointList.begin() ; p != m_PointList.end(); ++p )
@@ -4802,7 +4987,7 @@ void PGMulti::WriteVSPGeomPnts( FILE* file_id, const Matrix4d & XFormMat )
                 (*n)->m_Pt->m_ID = ipoint;
                 // Apply Transformations
                 vec3d v = XFormMat.xform( ( *n )->m_Pt->m_Pnt );
-                fprintf( file_id, "%16.10g %16.10g %16.10g\n", v.x(), v.y(), v.z() );
+                WriteVSPGeomPnt( file_id, v, binary );
                 ipoint++;
             }
         }
@@ -413,17 +413,17 @@ public:
     void PolygonizeMesh();
     void CleanColinearVerts();
 
-    void WriteVSPGeom( const string & fname );
-    void WriteVSPGeom( FILE* file_id, const Matrix4d & XFormMat );
-    void WriteVSPGeomPnts( FILE* file_id, const Matrix4d & XFormMat );
-    void WriteVSPGeomFaces( FILE* file_id );
-    void WriteVSPGeomParts( FILE* file_id );
-    void WriteVSPGeomEdgeWakes( FILE* file_id, const vector < vector < PGEdge* > > &ewake, const vector < int > &partvec, int wingbodyflag ) const;
-    void WriteVSPGeomWakes( FILE* file_id ) const;
-    void WriteVSPGeomAlternateTris( FILE* file_id );
-    void WriteVSPGeomAlternateParts( FILE* file_id );
-
-    void WriteVSPGeomParents( FILE* file_id );
+    void WriteVSPGeom( const string & fname, bool binary = false );
+    void WriteVSPGeom( FILE* file_id, const Matrix4d & XFormMat, bool binary = false );
+    void WriteVSPGeomPnts( FILE* file_id, const Matrix4d & XFormMat, bool binary = false );
+    void WriteVSPGeomFaces( FILE* file_id, bool binary = false );
+    void WriteVSPGeomParts( FILE* file_id, bool binary = false );
+    void WriteVSPGeomEdgeWakes( FILE* file_id, const vector < vector < PGEdge* > > &ewake, const vector < int > &partvec, int wingbodyflag, bool binary = false ) const;
+    void WriteVSPGeomWakes( FILE* file_id, bool binary = false ) const;
+    void WriteVSPGeomAlternateTris( FILE* file_id, bool binary = false );
+    void WriteVSPGeomAlternateParts( FILE* file_id, bool binary = false );
+
+    void WriteVSPGeomParents( FILE* file_id, bool binary = false );
 
     void WriteTagFile( FILE* file_id, int part, int tag );
 
@@ -472,8 +472,9 @@ public:
     bool Check();
     void ResetPointNumbers();
 
-    void WriteVSPGeom( FILE* file_id, const Matrix4d & XFormMat  );
-    void WriteVSPGeomPnts( FILE* file_id, const Matrix4d & XFormMat );
+    // Binary files carry the same data as raw ints and doubles, see PGMulti::WriteVSPGeom.
+    void WriteVSPGeom( FILE* file_id, const Matrix4d & XFormMat, bool binary = false );
+    void WriteVSPGeomPnts( FILE* file_id, const Matrix4d & XFormMat, bool binary = false );
     void WriteTagFiles( const string& file_name, vector < string > &all_fnames );
     void WriteVSPGEOMKeyFile(const string & file_name, vector < string > &all_fnames );
 
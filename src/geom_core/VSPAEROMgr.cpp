@@ -2408,6 +2408,10 @@ void VSPAEROMgrSingleton::ReadHistoryFile( const string &filename, vector <strin
 
             std::vector<double> WallTime;
 
+            // Linear solver statistics, only in .history files from newer solvers
+            std::vector<int> GMRESIter;
+            std::vector<double> GMRESTime;
+
 
             while ( data_string_array.size() >= wake_iter_table_columns )
             {
@@ -2483,6 +2487,12 @@ void VSPAEROMgrSingleton::ReadHistoryFile( const string &filename, vector <strin
                 l10MaxResid.push_back( std::stod( data_string_array[icol] ) ); icol++;
                 WallTime.push_back(     std::stod( data_string_array[icol] ) ); icol++;
 
+                if ( (int)data_string_array.size() >= icol + 2 )
+                {
+                    GMRESIter.push_back( std::stoi( data_string_array[icol] ) ); icol++;
+                    GMRESTime.push_back( std::stod( data_string_array[icol] ) ); icol++;
+                }
+
                 data_string_array = ReadDelimLine( fp, seps );
             }
 
@@ -2554,6 +2564,12 @@ void VSPAEROMgrSingleton::ReadHistoryFile( const string &filename, vector <strin
                 res->Add( new NameValData( "log10( L2Residual )", l10L2Resid, "log10( L2Residual )" ) );
                 res->Add( new NameValData( "log10( MaxResidual )", l10MaxResid, "log10( MaxResidual )" ) );
                 res->Add( new NameValData( "WallTime", WallTime, "Current Wall Time" ) );
+
+                if ( GMRESIter.size() > 0 )
+                {
+                    res->Add( new NameValData( "GMRESIter", GMRESIter, "GMRES iterations since the previous row." ) );
+                    res->Add( new NameValData( "GMRESTime", GMRESTime, "GMRES solve time since the previous row." ) );
+                }
             }
 
         } // end of wake iteration
@@ -103,6 +103,20 @@ for i in range(len(utess)):
 for j in range(len(wtess)):
     print( "wtess: " + str(wtess[j]) )
 
+
+# Same queries with NumPy arrays in and out, no per point Python objects.
+import numpy as np
+
+uarr = np.linspace( 0.1, 0.9, 1000 )
+warr = np.linspace( 0.9, 0.1, 1000 )
+
+ptarr = vsp.CompVecPnt01Array( gid, surf_indx, uarr, warr )
+normarr = vsp.CompVecNorm01Array( gid, surf_indx, uarr, warr )
+
+uoutarr, woutarr, doutarr = vsp.ProjVecPnt01Array( gid, surf_indx, ptarr + normarr )
+
+print( "Array surface projection: points " + str(ptarr.shape) + " max dist " + str(doutarr.max()) )
+
 # Check for errors
 
 num_err = errorMgr.GetNumTotalErrors()
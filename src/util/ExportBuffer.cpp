@@ -0,0 +1,371 @@
+//
+// This file is released under the terms of the NASA Open Source Agreement (NOSA)
+// version 1.3 as detailed in the LICENSE file which accompanies this software.
+//
+
+//******************************************************************************
+//
+//   Buffered Text/Binary Export
+//
+//******************************************************************************
+
+#include "ExportBuffer.h"
+#include "ParallelUtil.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdarg>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+ExportBuffer::ExportBuffer()
+{
+    m_FilePtr = nullptr;
+    m_FlushSize = 0;
+}
+
+ExportBuffer::ExportBuffer( FILE* fp, size_t flush_size )
+{
+    m_FilePtr = fp;
+    m_FlushSize = flush_size;
+    m_Buf.reserve( flush_size + 1024 );
+}
+
+ExportBuffer::~ExportBuffer()
+{
+    Flush();
+}
+
+void ExportBuffer::Flush()
+{
+    if ( m_FilePtr && !m_Buf.empty() )
+    {
+        fwrite( m_Buf.data(), 1, m_Buf.size(), m_FilePtr );
+        m_Buf.clear();
+    }
+}
+
+void ExportBuffer::Append( const char* str )
+{
+    m_Buf.append( str );
+    CheckFlush();
+}
+
+void ExportBuffer::Append( const string & str )
+{
+    m_Buf.append( str );
+    CheckFlush();
+}
+
+void ExportBuffer::Append( char c )
+{
+    m_Buf.push_back( c );
+    CheckFlush();
+}
+
+void ExportBuffer::Append( const ExportBuffer & chunk )
+{
+    m_Buf.append( chunk.m_Buf );
+    CheckFlush();
+}
+
+void ExportBuffer::AppendBinary( const void* data, size_t nbytes )
+{
+    m_Buf.append( ( const char* ) data, nbytes );
+    CheckFlush();
+}
+
+static bool IsBigEndian()
+{
+    int i = 1;
+    return *( ( unsigned char* ) &i ) == 0;
+}
+
+void ExportBuffer::AppendBinaryLE( const void* data, size_t n, size_t wordsize )
+{
+    size_t start = m_Buf.size();
+    m_Buf.append( ( const char* ) data, n * wordsize );
+
+    if ( IsBigEndian() && wordsize > 1 )
+    {
+        for ( size_t i = 0; i < n; i++ )
+        {
+            char* w = &m_Buf[ start + i * wordsize ];
+            std::reverse( w, w + wordsize );
+        }
+    }
+    CheckFlush();
+}
+
+void ExportBuffer::AppendInt( long long int i, int width )
+{
+    char tmp[ 32 ];
+    std::to_chars_result r = std::to_chars( tmp, tmp + sizeof( tmp ), i );
+    int len = ( int )( r.ptr - tmp );
+
+    if ( len < width )
+    {
+        m_Buf.append( width - len, ' ' );
+    }
+    m_Buf.append( tmp, len );
+    CheckFlush();
+}
+
+void ExportBuffer::AppendDouble( double v, char conv, int prec, int width, bool zero_pad )
+{
+    // Large enough for %f of DBL_MAX at any precision used by the writers.
+    char tmp[ 512 ];
+    int len = -1;
+
+#if defined( __cpp_lib_to_chars )
+    std::chars_format fmt = std::chars_format::general;
+    if ( conv == 'e' )
+    {
+        fmt = std::chars_format::scientific;
+    }
+    else if ( conv == 'f' )
+    {
+        fmt = std::chars_format::fixed;
+    }
+
+    std::to_chars_result r = std::to_chars( tmp, tmp + sizeof( tmp ), v, fmt, prec );
+    if ( r.ec == std::errc() )
+    {
+        len = ( int )( r.ptr - tmp );
+    }
+#endif
+
+    if ( len < 0 )
+    {
+        char spec[ 8 ] = { '%', '.', '*', conv, '\0' };
+        len = snprintf( tmp, sizeof( tmp ), spec, prec, v );
+        if ( len < 0 || len >= ( int ) sizeof( tmp ) )
+        {
+            len = ( int ) strlen( tmp );
+        }
+    }
+
+    if ( len < width )
+    {
+        if ( zero_pad && std::isfinite( v ) )
+        {
+            // Zero padding goes between the sign and the digits.
+            int nsign = ( tmp[ 0 ] == '-' ) ? 1 : 0;
+            m_Buf.append( tmp, nsign );
+            m_Buf.append( width - len, '0' );
+            m_Buf.append( tmp + nsign, len - nsign );
+            CheckFlush();
+            return;
+        }
+        m_Buf.append( width - len, ' ' );
+    }
+    m_Buf.append( tmp, len );
+    CheckFlush();
+}
+
+void ExportBuffer::AppendDouble( double v, const string & spec )
+{
+    size_t pct = spec.find( '%' );
+    if ( pct == string::npos )
+    {
+        Append( spec );
+        return;
+    }
+
+    m_Buf.append( spec, 0, pct );
+
+    size_t i = pct + 1;
+    size_t n = spec.size();
+
+    bool zero_pad = false;
+    bool supported = true;
+    while ( i < n && strchr( "0-+ #", spec[ i ] ) )
+    {
+        if ( spec[ i ] == '0' )
+        {
+            zero_pad = true;
+        }
+        else
+        {
+            supported = false;
+        }
+        i++;
+    }
+
+    int width = 0;
+    while ( i < n && isdigit( ( unsigned char ) spec[ i ] ) )
+    {
+        width = 10 * width + ( spec[ i ] - '0' );
+        i++;
+    }
+
+    int prec = 6;
+    if ( i < n && spec[ i ] == '.' )
+    {
+        i++;
+        prec = 0;
+        while ( i < n && isdigit( ( unsigned char ) spec[ i ] ) )
+        {
+            prec = 10 * prec + ( spec[ i ] - '0' );
+            i++;
+        }
+    }
+
+    if ( i < n && ( spec[ i ] == 'l' || spec[ i ] == 'L' ) )
+    {
+        i++;
+    }
+
+    char conv = ( i < n ) ? spec[ i ] : '\0';
+    if ( conv != 'e' && conv != 'f' && conv != 'g' )
+    {
+        supported = false;
+    }
+
+    if ( supported )
+    {
+        AppendDouble( v, conv, prec, width, zero_pad );
+        m_Buf.append( spec, i + 1, string::npos );
+    }
+    else
+    {
+        string sub = spec.substr( pct );
+        int len = snprintf( nullptr, 0, sub.c_str(), v );
+        if ( len > 0 )
+        {
+            size_t start = m_Buf.size();
+            m_Buf.resize( start + len + 1 );
+            snprintf( &m_Buf[ start ], len + 1, sub.c_str(), v );
+            m_Buf.resize( start + len );
+        }
+    }
+    CheckFlush();
+}
+
+void ExportBuffer::Printf( const char* fmt, ... )
+{
+    va_list args;
+    va_start( args, fmt );
+    va_list args_copy;
+    va_copy( args_copy, args );
+
+    int len = vsnprintf( nullptr, 0, fmt, args );
+    if ( len > 0 )
+    {
+        size_t start = m_Buf.size();
+        m_Buf.resize( start + len + 1 );
+        vsnprintf( &m_Buf[ start ], len + 1, fmt, args_copy );
+        m_Buf.resize( start + len );
+    }
+
+    va_end( args_copy );
+    va_end( args );
+    CheckFlush();
+}
+
+void ExportUtil::ParallelAppend( ExportBuffer & out, int n, const std::function< void( ExportBuffer &, int ) > & fun )
+{
+    // Records per block.  Each round formats one block per thread, so memory
+    // use is bounded no matter how large the mesh is.
+    const int block_size = 32768;
+
+    int nthread = std::min( ParallelUtil::NumThreads(), ( n + block_size - 1 ) / block_size );
+
+    if ( nthread <= 1 )
+    {
+        for ( int i = 0; i < n; i++ )
+        {
+            fun( out, i );
+        }
+        return;
+    }
+
+    vector< ExportBuffer > chunks( nthread );
+    vector< std::thread > threads;
+    threads.reserve( nthread );
+
+    for ( int start = 0; start < n; start += nthread * block_size )
+    {
+        threads.clear();
+        for ( int t = 0; t < nthread; t++ )
+        {
+            int ibegin = std::min( n, start + t * block_size );
+            int iend = std::min( n, ibegin + block_size );
+
+            threads.emplace_back( [ &fun, &chunks, t, ibegin, iend ]()
+            {
+                for ( int i = ibegin; i < iend; i++ )
+                {
+                    fun( chunks[ t ], i );
+                }
+            } );
+        }
+
+        for ( int t = 0; t < nthread; t++ )
+        {
+            threads[ t ].join();
+            out.Append( chunks[ t ] );
+            chunks[ t ].Clear();
+        }
+    }
+}
+
+void ExportUtil::AppendXYZ( ExportBuffer & buf, const vec3d & p, char conv, int prec, int width )
+{
+    buf.AppendDouble( p.x(), conv, prec, width );
+    buf.Append( ' ' );
+    buf.AppendDouble( p.y(), conv, prec, width );
+    buf.Append( ' ' );
+    buf.AppendDouble( p.z(), conv, prec, width );
+}
+
+void ExportUtil::AppendSTLFacet( ExportBuffer & buf, const vec3d & norm, const vec3d & p0, const vec3d & p1, const vec3d & p2 )
+{
+    // Same text as " facet normal  %2.10le %2.10le %2.10le\n" etc.
+    buf.Append( " facet normal  " );
+    AppendXYZ( buf, norm, 'e', 10, 2 );
+    buf.Append( "\n   outer loop\n" );
+
+    buf.Append( "     vertex " );
+    AppendXYZ( buf, p0, 'e', 10, 2 );
+    buf.Append( "\n     vertex " );
+    AppendXYZ( buf, p1, 'e', 10, 2 );
+    buf.Append( "\n     vertex " );
+    AppendXYZ( buf, p2, 'e', 10, 2 );
+
+    buf.Append( "\n   endloop\n" );
+    buf.Append( " endfacet\n" );
+}
+
+void ExportUtil::AppendBinarySTLFacet( ExportBuffer & buf, const vec3d & norm, const vec3d & p0, const vec3d & p1, const vec3d & p2 )
+{
+    float data[ 12 ] = { ( float ) norm.x(), ( float ) norm.y(), ( float ) norm.z(),
+                         ( float ) p0.x(), ( float ) p0.y(), ( float ) p0.z(),
+                         ( float ) p1.x(), ( float ) p1.y(), ( float ) p1.z(),
+                         ( float ) p2.x(), ( float ) p2.y(), ( float ) p2.z() };
+    unsigned short attribute = 0;
+
+    buf.AppendBinaryLE( data, 12, sizeof( float ) );
+    buf.AppendBinaryLE( attribute );
+}
+
+void ExportUtil::AppendBinarySTLHeader( ExportBuffer & buf, const string & title, unsigned int nfacet )
+{
+    // Header must not start with "solid" or readers take the file for ASCII.
+    char header[ 80 ];
+    memset( header, ' ', sizeof( header ) );
+    memcpy( header, title.c_str(), std::min( title.size(), sizeof( header ) ) );
+
+    buf.AppendBinary( header, sizeof( header ) );
+    buf.AppendBinaryLE( nfacet );
+}
+
+void ExportUtil::AppendFortranRecord( ExportBuffer & buf, const void* data, size_t n, size_t wordsize )
+{
+    int reclen = ( int ) ( n * wordsize );
+    buf.AppendBinaryLE( reclen );
+    buf.AppendBinaryLE( data, n, wordsize );
+    buf.AppendBinaryLE( reclen );
+}
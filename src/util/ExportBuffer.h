@@ -0,0 +1,127 @@
+//
+// This file is released under the terms of the NASA Open Source Agreement (NOSA)
+// version 1.3 as detailed in the LICENSE file which accompanies this software.
+//
+
+//******************************************************************************
+//
+//   Buffered Text/Binary Export
+//
+//   Mesh writers append formatted numbers into a large buffer which is handed
+//   to fwrite in big blocks.  Numbers are formatted without going through the
+//   printf machinery, but the text matches printf for the same conversion.
+//   Independent records may be formatted into chunks on several threads and
+//   are always written back in order, so output does not depend on the number
+//   of threads.
+//
+//******************************************************************************
+
+#ifndef EXPORTBUFFER_H
+#define EXPORTBUFFER_H
+
+#include "Vec3d.h"
+
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+class ExportBuffer
+{
+public:
+
+    // In-memory buffer, used for chunks formatted in parallel.
+    ExportBuffer();
+    // Buffer that writes through to fp.  fp is not closed.
+    ExportBuffer( FILE* fp, size_t flush_size = 4 * 1024 * 1024 );
+    virtual ~ExportBuffer();
+
+    void Append( const char* str );
+    void Append( const string & str );
+    void Append( char c );
+    void Append( const ExportBuffer & chunk );
+
+    // Same text as printf( "%*lld", width, i ).
+    void AppendInt( long long int i, int width = 0 );
+
+    // Same text as printf( "%*.*e" ) / "%*.*f" / "%*.*g" with conv 'e', 'f' or 'g'.
+    void AppendDouble( double v, char conv, int prec, int width = 0, bool zero_pad = false );
+
+    // Single printf style conversion such as those returned by StringUtil::NasFmt().
+    // Flags '0', width, precision and conversions e, f and g are supported.  Any
+    // text following the conversion is appended after the number.
+    void AppendDouble( double v, const string & spec );
+
+    // General printf formatting for headers and other infrequent records.
+    void Printf( const char* fmt, ... );
+
+    void AppendBinary( const void* data, size_t nbytes );
+    template < class T >
+    void AppendBinary( const T & val )
+    {
+        AppendBinary( &val, sizeof( T ) );
+    }
+
+    // n words of wordsize bytes in little endian order, swapped on big endian hosts.
+    void AppendBinaryLE( const void* data, size_t n, size_t wordsize );
+    template < class T >
+    void AppendBinaryLE( const T & val )
+    {
+        AppendBinaryLE( &val, 1, sizeof( T ) );
+    }
+
+    void Flush();
+    void Clear()
+    {
+        m_Buf.clear();
+    }
+
+    size_t Size() const
+    {
+        return m_Buf.size();
+    }
+    const char* Data() const
+    {
+        return m_Buf.data();
+    }
+
+protected:
+
+    void CheckFlush()
+    {
+        if ( m_FilePtr && m_Buf.size() >= m_FlushSize )
+        {
+            Flush();
+        }
+    }
+
+    FILE* m_FilePtr;
+    size_t m_FlushSize;
+    string m_Buf;
+};
+
+namespace ExportUtil
+{
+    // Calls fun( chunk, i ) for i = 0 .. n-1 and appends the result to out in
+    // order of i.  Large ranges are split into blocks that are formatted
+    // concurrently.  fun must only read shared data.
+    void ParallelAppend( ExportBuffer & out, int n, const std::function< void( ExportBuffer &, int ) > & fun );
+
+    // "x y z" with the same conversion for each coordinate.
+    void AppendXYZ( ExportBuffer & buf, const vec3d & p, char conv, int prec, int width = 0 );
+
+    // ASCII and binary (little endian) STL facet records.
+    void AppendSTLFacet( ExportBuffer & buf, const vec3d & norm, const vec3d & p0, const vec3d & p1, const vec3d & p2 );
+    void AppendBinarySTLFacet( ExportBuffer & buf, const vec3d & norm, const vec3d & p0, const vec3d & p1, const vec3d & p2 );
+    // 80 byte header and facet count of a binary STL file.
+    void AppendBinarySTLHeader( ExportBuffer & buf, const string & title, unsigned int nfacet );
+
+    // Little endian Fortran unformatted sequential record of n words, as read
+    // by Cart3D and others.
+    void AppendFortranRecord( ExportBuffer & buf, const void* data, size_t n, size_t wordsize );
+}
+
+#endif
@@ -0,0 +1,65 @@
+//
+// This file is released under the terms of the NASA Open Source Agreement (NOSA)
+// version 1.3 as detailed in the LICENSE file which accompanies this software.
+//
+
+//******************************************************************************
+//
+//   Simple Thread Parallel Loops
+//
+//******************************************************************************
+
+#include "ParallelUtil.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+int ParallelUtil::NumThreads()
+{
+    int nthread = ( int ) std::thread::hardware_concurrency();
+    return std::max( nthread, 1 );
+}
+
+void ParallelUtil::ParallelFor( int n, const std::function< void( int ) > & fun, int nthread )
+{
+    if ( nthread <= 0 )
+    {
+        nthread = NumThreads();
+    }
+    nthread = std::min( nthread, n );
+
+    if ( nthread <= 1 )
+    {
+        for ( int i = 0; i < n; i++ )
+        {
+            fun( i );
+        }
+        return;
+    }
+
+    std::atomic < int > next( 0 );
+
+    auto work = [ &fun, &next, n ]()
+    {
+        for ( int i = next++; i < n; i = next++ )
+        {
+            fun( i );
+        }
+    };
+
+    std::vector < std::thread > threads;
+    threads.reserve( nthread - 1 );
+    for ( int t = 1; t < nthread; t++ )
+    {
+        threads.emplace_back( work );
+    }
+
+    work();
+
+    for ( size_t t = 0; t < threads.size(); t++ )
+    {
+        threads[t].join();
+    }
+}
@@ -0,0 +1,29 @@
+//
+// This file is released under the terms of the NASA Open Source Agreement (NOSA)
+// version 1.3 as detailed in the LICENSE file which accompanies this software.
+//
+
+//******************************************************************************
+//
+//   Simple Thread Parallel Loops
+//
+//******************************************************************************
+
+#ifndef PARALLELUTIL_H
+#define PARALLELUTIL_H
+
+#include <functional>
+
+namespace ParallelUtil
+{
+    // Number of worker threads to use, at least one.
+    int NumThreads();
+
+    // Calls fun( i ) for i = 0 .. n-1 on up to nthread threads.  Indices are
+    // handed out one at a time, so uneven work balances.  Order of the calls
+    // is unspecified; fun must only write data owned by index i.  nthread <= 0
+    // uses NumThreads().
+    void ParallelFor( int n, const std::function< void( int ) > & fun, int nthread = 0 );
+}
+
+#endif
@@ -0,0 +1,395 @@
+//
+// This file is released under the terms of the NASA Open Source Agreement (NOSA)
+// version 1.3 as detailed in the LICENSE file which accompanies this software.
+//
+
+#include "SurfSearchIndex.h"
+
+#include "eli/geom/intersect/minimum_distance_surface.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <queue>
+#include <utility>
+
+typedef eli::geom::surface::bezier<double, 3> search_patch_type;
+typedef piecewise_surface_type::point_type search_point_type;
+typedef piecewise_surface_type::bounding_box_type search_bounding_box_type;
+
+//==== FNV-1a over the bytes of a value ====//
+template < class T >
+static void HashAdd( uint64_t &hash, const T &val )
+{
+    unsigned char bytes[ sizeof( T ) ];
+    memcpy( bytes, &val, sizeof( T ) );
+
+    for ( size_t i = 0; i < sizeof( T ); i++ )
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+}
+
+//==== Cut a patch into n strips of equal parameter width in u ====//
+static void SplitPatchU( const search_patch_type &patch, int n, vector < search_patch_type > &strips )
+{
+    strips.resize( n );
+
+    search_patch_type rest = patch;
+    for ( int k = 0; k < n - 1; k++ )
+    {
+        search_patch_type hi;
+        rest.split_u( strips[k], hi, 1.0 / ( n - k ) );
+        rest = hi;
+    }
+    strips[n - 1] = rest;
+}
+
+static void SplitPatchV( const search_patch_type &patch, int n, vector < search_patch_type > &strips )
+{
+    strips.resize( n );
+
+    search_patch_type rest = patch;
+    for ( int k = 0; k < n - 1; k++ )
+    {
+        search_patch_type hi;
+        rest.split_v( strips[k], hi, 1.0 / ( n - k ) );
+        rest = hi;
+    }
+    strips[n - 1] = rest;
+}
+
+SurfSearchIndex::SurfSearchIndex()
+{
+    m_Hash = 0;
+}
+
+uint64_t SurfSearchIndex::Hash( const piecewise_surface_type & surf )
+{
+    uint64_t hash = 14695981039346656037ULL;
+
+    int nu = surf.number_u_patches();
+    int nw = surf.number_v_patches();
+
+    HashAdd( hash, nu );
+    HashAdd( hash, nw );
+
+    for ( int ip = 0; ip < nu; ip++ )
+    {
+        for ( int jp = 0; jp < nw; jp++ )
+        {
+            double umin = 0;
+            double du = 0;
+            double wmin = 0;
+            double dw = 0;
+            const search_patch_type *patch = surf.get_patch( ip, jp, umin, du, wmin, dw );
+
+            HashAdd( hash, umin );
+            HashAdd( hash, du );
+            HashAdd( hash, wmin );
+            HashAdd( hash, dw );
+
+            int degu = patch->degree_u();
+            int degw = patch->degree_v();
+            HashAdd( hash, degu );
+            HashAdd( hash, degw );
+
+            for ( int icp = 0; icp <= degu; icp++ )
+            {
+                for ( int jcp = 0; jcp <= degw; jcp++ )
+                {
+                    search_point_type cp = patch->get_control_point( icp, jcp );
+                    double x = cp.x();
+                    double y = cp.y();
+                    double z = cp.z();
+                    HashAdd( hash, x );
+                    HashAdd( hash, y );
+                    HashAdd( hash, z );
+                }
+            }
+        }
+    }
+    return hash;
+}
+
+void SurfSearchIndex::Build( const piecewise_surface_type & surf )
+{
+    m_Hash = Hash( surf );
+
+    m_Cells.clear();
+    m_Nodes.clear();
+
+    int nu = surf.number_u_patches();
+    int nw = surf.number_v_patches();
+
+    if ( nu <= 0 || nw <= 0 )
+    {
+        return;
+    }
+
+    m_Cells.reserve( nu * nw * NUM_CELL_SPLIT * NUM_CELL_SPLIT );
+
+    vector < search_patch_type > ustrips;
+    vector < search_patch_type > cells;
+
+    for ( int ip = 0; ip < nu; ip++ )
+    {
+        for ( int jp = 0; jp < nw; jp++ )
+        {
+            const search_patch_type *patch = surf.get_patch( ip, jp );
+
+            SplitPatchU( *patch, NUM_CELL_SPLIT, ustrips );
+
+            for ( int i = 0; i < NUM_CELL_SPLIT; i++ )
+            {
+                SplitPatchV( ustrips[i], NUM_CELL_SPLIT, cells );
+
+                for ( int j = 0; j < NUM_CELL_SPLIT; j++ )
+                {
+                    SearchCell c;
+                    c.m_UPatch = ip;
+                    c.m_WPatch = jp;
+                    c.m_U0 = ( double ) i / NUM_CELL_SPLIT;
+                    c.m_U1 = ( double ) ( i + 1 ) / NUM_CELL_SPLIT;
+                    c.m_W0 = ( double ) j / NUM_CELL_SPLIT;
+                    c.m_W1 = ( double ) ( j + 1 ) / NUM_CELL_SPLIT;
+
+                    // Control hull bounds the cell, so box distance never overestimates.
+                    search_bounding_box_type bb;
+                    cells[j].get_bounding_box( bb );
+                    search_point_type pmin = bb.get_min();
+                    search_point_type pmax = bb.get_max();
+                    c.m_Box.Update( vec3d( pmin.x(), pmin.y(), pmin.z() ) );
+                    c.m_Box.Update( vec3d( pmax.x(), pmax.y(), pmax.z() ) );
+
+                    for ( int is = 0; is < NUM_CELL_SAMPLE; is++ )
+                    {
+                        double us = ( double ) is / ( NUM_CELL_SAMPLE - 1 );
+                        for ( int js = 0; js < NUM_CELL_SAMPLE; js++ )
+                        {
+                            double ws = ( double ) js / ( NUM_CELL_SAMPLE - 1 );
+                            search_point_type p = cells[j].f( us, ws );
+                            c.m_Sample[ is * NUM_CELL_SAMPLE + js ] = vec3d( p.x(), p.y(), p.z() );
+                        }
+                    }
+
+                    m_Cells.push_back( c );
+                }
+            }
+        }
+    }
+
+    m_Nodes.reserve( 2 * m_Cells.size() / MAX_NODE_CELLS + 1 );
+    BuildNode( 0, ( int ) m_Cells.size() );
+}
+
+//==== Median split on the longest axis of the cell centers ====//
+int SurfSearchIndex::BuildNode( int begin, int end )
+{
+    int inode = ( int ) m_Nodes.size();
+    m_Nodes.push_back( SearchNode() );
+
+    BndBox box;
+    BndBox cbox;
+    for ( int i = begin; i < end; i++ )
+    {
+        box.Update( m_Cells[i].m_Box );
+        cbox.Update( m_Cells[i].m_Box.GetCenter() );
+    }
+
+    m_Nodes[inode].m_Box = box;
+    m_Nodes[inode].m_Left = -1;
+    m_Nodes[inode].m_Right = -1;
+    m_Nodes[inode].m_Begin = begin;
+    m_Nodes[inode].m_End = end;
+
+    if ( end - begin <= MAX_NODE_CELLS )
+    {
+        return inode;
+    }
+
+    int axis = 0;
+    for ( int k = 1; k < 3; k++ )
+    {
+        if ( cbox.GetMax( k ) - cbox.GetMin( k ) > cbox.GetMax( axis ) - cbox.GetMin( axis ) )
+        {
+            axis = k;
+        }
+    }
+
+    int mid = ( begin + end ) / 2;
+    std::nth_element( m_Cells.begin() + begin, m_Cells.begin() + mid, m_Cells.begin() + end,
+                      [axis]( const SearchCell & a, const SearchCell & b )
+                      {
+                          return a.m_Box.GetCenter()[axis] < b.m_Box.GetCenter()[axis];
+                      } );
+
+    int left = BuildNode( begin, mid );
+    int right = BuildNode( mid, end );
+
+    m_Nodes[inode].m_Left = left;
+    m_Nodes[inode].m_Right = right;
+
+    return inode;
+}
+
+double SurfSearchIndex::BoxDist( const BndBox & box, const vec3d &pt )
+{
+    double d2 = 0;
+    for ( int k = 0; k < 3; k++ )
+    {
+        double d = 0;
+        if ( pt[k] < box.GetMin( k ) )
+        {
+            d = box.GetMin( k ) - pt[k];
+        }
+        else if ( pt[k] > box.GetMax( k ) )
+        {
+            d = pt[k] - box.GetMax( k );
+        }
+        d2 += d * d;
+    }
+    return sqrt( d2 );
+}
+
+void SurfSearchIndex::SearchCellNearest( const SearchCell & cell, const piecewise_surface_type & surf, const vec3d &pt, double &best, double &u, double &w ) const
+{
+    double ustart, du, wstart, dw;
+    const search_patch_type *patch = surf.get_patch( cell.m_UPatch, cell.m_WPatch, ustart, du, wstart, dw );
+
+    // Nearest tessellation point is the initial guess, and the answer if the solve does worse.
+    int kbest = 0;
+    double dsample = DBL_MAX;
+    for ( int k = 0; k < NUM_CELL_SAMPLE * NUM_CELL_SAMPLE; k++ )
+    {
+        double d = dist( cell.m_Sample[k], pt );
+        if ( d < dsample )
+        {
+            dsample = d;
+            kbest = k;
+        }
+    }
+
+    double uu0 = cell.m_U0 + ( cell.m_U1 - cell.m_U0 ) * ( kbest / NUM_CELL_SAMPLE ) / ( NUM_CELL_SAMPLE - 1 );
+    double ww0 = cell.m_W0 + ( cell.m_W1 - cell.m_W0 ) * ( kbest % NUM_CELL_SAMPLE ) / ( NUM_CELL_SAMPLE - 1 );
+
+    if ( dsample < best )
+    {
+        best = dsample;
+        u = ustart + uu0 * du;
+        w = wstart + ww0 * dw;
+    }
+
+    search_point_type p;
+    p << pt.x(), pt.y(), pt.z();
+
+    double uu = uu0;
+    double ww = ww0;
+    double d = eli::geom::intersect::minimum_distance( uu, ww, *patch, p, uu0, ww0, cell.m_U0, cell.m_U1, cell.m_W0, cell.m_W1 );
+
+    if ( d < best )
+    {
+        best = d;
+        u = ustart + uu * du;
+        w = wstart + ww * dw;
+    }
+
+    // Solve stopped on a patch edge, the nearest point may lie further along it.
+    search_patch_type::curve_type bc;
+    double t;
+
+    if ( uu <= 0.0 || uu >= 1.0 )
+    {
+        double ue = ( uu <= 0.0 ) ? 0.0 : 1.0;
+        if ( ue == 0.0 )
+        {
+            patch->get_umin_bndy_curve( bc );
+        }
+        else
+        {
+            patch->get_umax_bndy_curve( bc );
+        }
+
+        d = eli::geom::intersect::minimum_distance( t, bc, p, ww );
+
+        if ( d < best )
+        {
+            best = d;
+            u = ustart + ue * du;
+            w = wstart + t * dw;
+        }
+    }
+
+    if ( ww <= 0.0 || ww >= 1.0 )
+    {
+        double we = ( ww <= 0.0 ) ? 0.0 : 1.0;
+        if ( we == 0.0 )
+        {
+            patch->get_vmin_bndy_curve( bc );
+        }
+        else
+        {
+            patch->get_vmax_bndy_curve( bc );
+        }
+
+        d = eli::geom::intersect::minimum_distance( t, bc, p, uu );
+
+        if ( d < best )
+        {
+            best = d;
+            u = ustart + t * du;
+            w = wstart + we * dw;
+        }
+    }
+}
+
+double SurfSearchIndex::FindNearest( double &u, double &w, const piecewise_surface_type & surf, const vec3d &pt ) const
+{
+    double best = DBL_MAX;
+    u = 0;
+    w = 0;
+
+    if ( m_Nodes.empty() )
+    {
+        return best;
+    }
+
+    typedef std::pair < double, int > dist_node;
+    std::priority_queue < dist_node, vector < dist_node >, std::greater < dist_node > > queue;
+
+    queue.push( dist_node( BoxDist( m_Nodes[0].m_Box, pt ), 0 ) );
+
+    while ( !queue.empty() )
+    {
+        dist_node top = queue.top();
+        queue.pop();
+
+        // Nearest remaining box is no closer than the best point, done.
+        if ( top.first >= best )
+        {
+            break;
+        }
+
+        const SearchNode & node = m_Nodes[ top.second ];
+
+        if ( node.m_Left < 0 )
+        {
+            for ( int i = node.m_Begin; i < node.m_End; i++ )
+            {
+                if ( BoxDist( m_Cells[i].m_Box, pt ) < best )
+                {
+                    SearchCellNearest( m_Cells[i], surf, pt, best, u, w );
+                }
+            }
+        }
+        else
+        {
+            queue.push( dist_node( BoxDist( m_Nodes[ node.m_Left ].m_Box, pt ), node.m_Left ) );
+            queue.push( dist_node( BoxDist( m_Nodes[ node.m_Right ].m_Box, pt ), node.m_Right ) );
+        }
+    }
+
+    return best;
+}
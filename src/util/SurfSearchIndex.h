@@ -0,0 +1,102 @@
+//
+// This file is released under the terms of the NASA Open Source Agreement (NOSA)
+// version 1.3 as detailed in the LICENSE file which accompanies this software.
+//
+
+//******************************************************************************
+//
+//   Surface Search Index
+//
+//   Bounding volume hierarchy over the patches of a piecewise surface.  Each
+//   patch is cut into a grid of cells, each cell keeps the bounding box of its
+//   control hull and a few points of a coarse tessellation.  Nearest point
+//   searches visit the cells in order of box distance, start a local solve from
+//   the nearest tessellation point and stop once no box can hold a closer point.
+//
+//******************************************************************************
+
+#ifndef SURFSEARCHINDEX_H
+#define SURFSEARCHINDEX_H
+
+#include "Vec3d.h"
+#include "BndBox.h"
+
+#include "eli/code_eli.hpp"
+
+#include "eli/geom/surface/bezier.hpp"
+#include "eli/geom/surface/piecewise.hpp"
+
+#include <cstdint>
+#include <vector>
+using std::vector;
+
+typedef eli::geom::surface::piecewise<eli::geom::surface::bezier, double, 3> piecewise_surface_type;
+
+class SurfSearchIndex
+{
+public:
+    SurfSearchIndex();
+
+    // Hash of the patch layout and control points of surf.
+    static uint64_t Hash( const piecewise_surface_type & surf );
+
+    void Build( const piecewise_surface_type & surf );
+
+    uint64_t GetHash() const
+    {
+        return m_Hash;
+    }
+
+    bool IsEmpty() const
+    {
+        return m_Nodes.empty();
+    }
+
+    // Nearest point on surf to pt, surf must be the surface the index was built
+    // from.  Safe to call from several threads at once.
+    double FindNearest( double &u, double &w, const piecewise_surface_type & surf, const vec3d &pt ) const;
+
+    // Cells per patch in each direction and tessellation points per cell side.
+    enum { NUM_CELL_SPLIT = 4, NUM_CELL_SAMPLE = 3, MAX_NODE_CELLS = 4 };
+
+protected:
+
+    struct SearchCell
+    {
+        BndBox m_Box;
+        int m_UPatch;
+        int m_WPatch;
+
+        // Patch local parameter range of the cell.
+        double m_U0;
+        double m_U1;
+        double m_W0;
+        double m_W1;
+
+        vec3d m_Sample[ NUM_CELL_SAMPLE * NUM_CELL_SAMPLE ];
+    };
+
+    struct SearchNode
+    {
+        BndBox m_Box;
+
+        // Child nodes, -1 for a node that holds cells m_Begin .. m_End-1.
+        int m_Left;
+        int m_Right;
+        int m_Begin;
+        int m_End;
+    };
+
+    int BuildNode( int begin, int end );
+
+    void SearchCellNearest( const SearchCell & cell, const piecewise_surface_type & surf, const vec3d &pt, double &best, double &u, double &w ) const;
+
+    static double BoxDist( const BndBox & box, const vec3d &pt );
+
+    uint64_t m_Hash;
+
+    vector < SearchCell > m_Cells;
+    vector < SearchNode > m_Nodes;
+};
+
+#endif
@@ -14,6 +14,11 @@
 #include "StringUtil.h"
 #include "StlHelper.h"
 #include "VspUtil.h"
+#include "ExportBuffer.h"
+#include "ParallelUtil.h"
+#include "SurfSearchIndex.h"
+
+#include "eli/geom/intersect/minimum_distance_surface.hpp"
 
 //==== Test vec2d ====//
 void UtilTestSuite::Vec2dUtilTest()
@@ -751,3 +756,167 @@ void UtilTestSuite::NumbersTest()
 //        printf( "%d\t%f\t%f\t%f\t%f\t%f\n", i, di, magx, magrd, magru, magp1ru );
     }
 }
+
+void UtilTestSuite::ExportBufferTest()
+{
+    // Buffered number formatting must match printf byte for byte.
+    const char* specs[] = { "%2.10le", "%.16g", "%16.10f", "%16.10g", "%f", "%08.2e", "%7.0f." };
+    const int nspec = sizeof( specs ) / sizeof( specs[0] );
+
+    double v = 1234567890.1234567890;
+    char buf[256];
+    for ( int i = 0; i < 30; i++ )
+    {
+        for ( int sign = 0; sign < 2; sign++ )
+        {
+            double sv = sign ? -v : v;
+
+            for ( int j = 0; j < nspec; j++ )
+            {
+                snprintf( buf, sizeof( buf ), specs[j], sv );
+                ExportBuffer eb;
+                eb.AppendDouble( sv, string( specs[j] ) );
+                TEST_ASSERT( string( eb.Data(), eb.Size() ) == string( buf ) );
+            }
+
+            string fmt = StringUtil::NasFmt( sv );
+            snprintf( buf, sizeof( buf ), fmt.c_str(), sv );
+            ExportBuffer eb;
+            eb.AppendDouble( sv, fmt );
+            TEST_ASSERT( string( eb.Data(), eb.Size() ) == string( buf ) );
+        }
+        v = v / 7.0;
+    }
+
+    ExportBuffer eb;
+    eb.AppendInt( -42, 8 );
+    snprintf( buf, sizeof( buf ), "%8lld", -42LL );
+    TEST_ASSERT( string( eb.Data(), eb.Size() ) == string( buf ) );
+
+    // Fortran records are little endian whatever the host.
+    int rec[2] = { 0x01020304, 5 };
+    ExportBuffer fb;
+    ExportUtil::AppendFortranRecord( fb, rec, 2, sizeof( int ) );
+    const unsigned char expect[] = { 8, 0, 0, 0, 4, 3, 2, 1, 5, 0, 0, 0, 8, 0, 0, 0 };
+    TEST_ASSERT( fb.Size() == sizeof( expect ) );
+    TEST_ASSERT( memcmp( fb.Data(), expect, sizeof( expect ) ) == 0 );
+
+    // Parallel chunks are appended in order.
+    int n = 100000;
+    ExportBuffer par;
+    ExportUtil::ParallelAppend( par, n, []( ExportBuffer & chunk, int i )
+    {
+        chunk.AppendInt( i );
+        chunk.Append( '\n' );
+    } );
+
+    ExportBuffer ser;
+    for ( int i = 0; i < n; i++ )
+    {
+        ser.AppendInt( i );
+        ser.Append( '\n' );
+    }
+    TEST_ASSERT( par.Size() == ser.Size() );
+    TEST_ASSERT( memcmp( par.Data(), ser.Data(), ser.Size() ) == 0 );
+}
+
+void UtilTestSuite::ParallelForTest()
+{
+    // Every index is visited exactly once.
+    int n = 10000;
+    vector< int > count( n, 0 );
+    ParallelUtil::ParallelFor( n, [&]( int i )
+    {
+        count[i]++;
+    } );
+
+    bool once = true;
+    for ( int i = 0; i < n; i++ )
+    {
+        once = once && ( count[i] == 1 );
+    }
+    TEST_ASSERT( once );
+
+    // Serial fallback and empty range.
+    vector< int > order;
+    ParallelUtil::ParallelFor( 5, [&]( int i )
+    {
+        order.push_back( i );
+    }, 1 );
+    TEST_ASSERT( order.size() == 5 && order[0] == 0 && order[4] == 4 );
+
+    ParallelUtil::ParallelFor( 0, [&]( int i )
+    {
+        order.push_back( i );
+    } );
+    TEST_ASSERT( order.size() == 5 );
+
+    TEST_ASSERT( ParallelUtil::NumThreads() >= 1 );
+}
+
+void UtilTestSuite::SurfSearchIndexTest()
+{
+    // Wavy tube of 6 x 4 bicubic patches.
+    int nu = 6;
+    int nw = 4;
+
+    piecewise_surface_type ps;
+    ps.init_uv( nu, nw );
+
+    for ( int ip = 0; ip < nu; ip++ )
+    {
+        for ( int jp = 0; jp < nw; jp++ )
+        {
+            surface_patch_type patch( 3, 3 );
+            for ( int i = 0; i <= 3; i++ )
+            {
+                for ( int j = 0; j <= 3; j++ )
+                {
+                    double a = 3 * ip + i;
+                    double b = 3 * jp + j;
+                    double theta = 2.0 * M_PI * a / ( 3 * nu );
+                    double r = 0.5 + 0.3 * sin( M_PI * b / ( 3 * nw ) );
+
+                    piecewise_surface_type::point_type cp;
+                    cp << 4.0 * b / ( 3 * nw ), r * cos( theta ), r * sin( theta );
+                    patch.set_control_point( cp, i, j );
+                }
+            }
+            ps.set( patch, ip, jp );
+        }
+    }
+
+    SurfSearchIndex index;
+    index.Build( ps );
+    TEST_ASSERT( !index.IsEmpty() );
+    TEST_ASSERT( index.GetHash() == SurfSearchIndex::Hash( ps ) );
+
+    // Points inside, outside and beyond the ends of the tube.
+    bool match = true;
+    bool consistent = true;
+    for ( int k = 0; k < 200; k++ )
+    {
+        vec3d pt( -1.0 + 6.0 * ( k % 10 ) / 9.0, 1.2 * sin( 0.7 * k ), 1.2 * cos( 1.3 * k ) );
+
+        piecewise_surface_type::point_type p;
+        p << pt.x(), pt.y(), pt.z();
+
+        double ug, wg;
+        double dglobal = eli::geom::intersect::minimum_distance( ug, wg, ps, p );
+
+        double u, w;
+        double d = index.FindNearest( u, w, ps, pt );
+
+        match = match && ( d <= dglobal + 1e-8 );
+        consistent = consistent && ( std::abs( ( ps.f( u, w ) - p ).norm() - d ) < 1e-10 );
+    }
+    TEST_ASSERT( match );
+    TEST_ASSERT( consistent );
+
+    // Moving a control point changes the hash.
+    surface_patch_type *patch = ps.get_patch( 0, 0 );
+    piecewise_surface_type::point_type cp = patch->get_control_point( 1, 1 );
+    cp.x() += 0.1;
+    patch->set_control_point( cp, 1, 1 );
+    TEST_ASSERT( index.GetHash() != SurfSearchIndex::Hash( ps ) );
+}
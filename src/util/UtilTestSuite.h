@@ -37,6 +37,9 @@ public:
         TEST_ADD( UtilTestSuite::BilinearInterpTest )
         TEST_ADD( UtilTestSuite::FormatWidthTest )
         TEST_ADD( UtilTestSuite::NumbersTest )
+        TEST_ADD( UtilTestSuite::ExportBufferTest )
+        TEST_ADD( UtilTestSuite::ParallelForTest )
+        TEST_ADD( UtilTestSuite::SurfSearchIndexTest )
     }
 
 private:
@@ -51,6 +54,9 @@ private:
     void BilinearInterpTest();
     void FormatWidthTest();
     void NumbersTest();
+    void ExportBufferTest();
+    void ParallelForTest();
+    void SurfSearchIndexTest();
 
     static void WritePntVecs( const vector< vector< vec3d > > & pnt_vecs, const string &file_name );
     void WriteCurve( VspCurve& crv, const string &file_name );
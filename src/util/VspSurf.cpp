@@ -330,6 +330,65 @@ double VspSurf::FindNearest01( double &u, double &w, const vec3d &pt, const doub
     return dist;
 }
 
+void VspSurf::ValidateDerivatives() const
+{
+    m_Surface.closed_u();
+    m_Surface.closed_v();
+
+    for ( int ip = 0; ip < m_Surface.number_u_patches(); ip++ )
+    {
+        for ( int jp = 0; jp < m_Surface.number_v_patches(); jp++ )
+        {
+            const surface_patch_type *patch = m_Surface.get_patch( ip, jp );
+
+            // Each call only builds the levels its degree check lets it reach.
+            patch->f_u( 0, 0 );
+            patch->f_v( 0, 0 );
+            patch->f_uu( 0, 0 );
+            patch->f_uv( 0, 0 );
+            patch->f_vv( 0, 0 );
+            patch->f_uuu( 0, 0 );
+            patch->f_uuv( 0, 0 );
+            patch->f_uvv( 0, 0 );
+            patch->f_vvv( 0, 0 );
+        }
+    }
+}
+
+void VspSurf::BuildSearchIndex() const
+{
+    uint64_t hash = SurfSearchIndex::Hash( m_Surface );
+
+    if ( !m_SearchIndex || m_SearchIndex->GetHash() != hash )
+    {
+        std::shared_ptr < SurfSearchIndex > index = std::make_shared < SurfSearchIndex > ();
+        index->Build( m_Surface );
+        m_SearchIndex = index;
+    }
+}
+
+double VspSurf::FindNearestIndexed( double &u, double &w, const vec3d &pt ) const
+{
+    if ( !m_SearchIndex || m_SearchIndex->IsEmpty() )
+    {
+        return FindNearest( u, w, pt );
+    }
+
+    return m_SearchIndex->FindNearest( u, w, m_Surface, pt );
+}
+
+double VspSurf::FindNearest01Indexed( double &u, double &w, const vec3d &pt ) const
+{
+    double dist;
+
+    dist = FindNearestIndexed( u, w, pt );
+
+    u = u / GetUMax();
+    w = w / GetWMax();
+
+    return dist;
+}
+
 void VspSurf::FindDistanceAngle( double &u, double &w, const vec3d &pt, const vec3d &dir, const double &d, const double &theta, const double &u0, const double &w0 ) const
 {
     surface_point_type p, dr;
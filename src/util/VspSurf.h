@@ -17,6 +17,7 @@
 #include "Vsp1DCurve.h"
 #include "BndBox.h"
 #include "XferSurf.h"
+#include "SurfSearchIndex.h"
 
 #include "CADutil.h"
 
@@ -39,6 +40,7 @@ typedef piecewise_surface_type::tolerance_type surface_tolerance_type;
 typedef eli::geom::curve::piecewise_cubic_spline_creator<double, 3, surface_tolerance_type> piecewise_cubic_spline_creator_type;
 typedef eli::geom::surface::connection_data<double, 3, surface_tolerance_type> rib_data_type;
 
+#include <memory>
 #include <vector>
 #include <string>
 using std::vector;
@@ -132,6 +134,16 @@ public:
     double FindNearest01( double &u, double &w, const vec3d &pt ) const;
     double FindNearest01( double &u, double &w, const vec3d &pt, const double &u0, const double &w0 ) const;
 
+    // Code-Eli builds derivative patches on first use, even from const calls.  Build
+    // them all now, so const evaluation may then run on several threads at once.
+    void ValidateDerivatives() const;
+
+    // Build the search index, or rebuild it if the surface has changed.  Call before
+    // FindNearestIndexed, which only reads the index and so may run on many threads.
+    void BuildSearchIndex() const;
+    double FindNearestIndexed( double &u, double &w, const vec3d &pt ) const;
+    double FindNearest01Indexed( double &u, double &w, const vec3d &pt ) const;
+
     void FindDistanceAngle( double &u, double &w, const vec3d &pt, const vec3d &dir, const double &d, const double &theta, const double &u0, const double &w0 ) const;
     void GuessDistanceAngle( double &du, double &dw, const vec3d &udir, const vec3d & wdir, const double &d, const double &theta ) const;
 
@@ -421,5 +433,8 @@ private:
     mutable vector < double > m_RootCluster;
     mutable vector < double > m_TipCluster;
 
+    // Never changed once built, replaced when the surface changes, so copies may share it.
+    mutable std::shared_ptr < SurfSearchIndex > m_SearchIndex;
+
 };
 #endif